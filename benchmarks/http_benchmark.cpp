@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+#include "titaninfer/engine/http_server.hpp"
+#include "titaninfer/io/model_serializer.hpp"
+#include "titaninfer/io/tensor_wire.hpp"
+#include "titaninfer/layers/dense_layer.hpp"
+#include "titaninfer/layers/activation_layer.hpp"
+#include "titaninfer/layers/sequential.hpp"
+#include "titaninfer/logger.hpp"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace titaninfer;
+using namespace titaninfer::layers;
+using namespace titaninfer::engine;
+
+namespace {
+
+const std::string MODEL_PATH = "http_benchmark_model.titan";
+
+void save_model() {
+    Sequential model;
+    model.add(std::make_unique<DenseLayer>(16, 32));
+    model.add(std::make_unique<ReluLayer>());
+    model.add(std::make_unique<DenseLayer>(32, 4));
+    io::ModelSerializer::save(model, MODEL_PATH);
+}
+
+int connect_loopback(uint16_t port) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+// Read until `count` complete responses arrived; false on EOF/error
+bool read_responses(int fd, size_t count, std::string& buffer) {
+    size_t done = 0;
+    char chunk[16384];
+    while (done < count) {
+        size_t head_end = buffer.find("\r\n\r\n");
+        if (head_end != std::string::npos) {
+            size_t pos = buffer.find("Content-Length: ");
+            size_t total = head_end + 4 + std::stoul(buffer.substr(pos + 16));
+            if (buffer.size() >= total) {
+                buffer.erase(0, total);
+                ++done;
+                continue;
+            }
+        }
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+// Keep-alive loopback predictions over `connections` client threads, each
+// keeping `depth` requests pipelined. Arg 0: depth, Arg 1: connections,
+// Arg 2: 1 for TensorWire bodies instead of JSON
+static void BM_Http_LoopbackPredict(benchmark::State& state) {
+    Logger::instance().set_level(LogLevel::SILENT);
+    const size_t depth = static_cast<size_t>(state.range(0));
+    const size_t connections = static_cast<size_t>(state.range(1));
+    const bool binary = state.range(2) != 0;
+    save_model();
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(2).build();
+    server.register_model("mlp", 1, MODEL_PATH);
+
+    HttpServerConfig config;
+    config.io_threads = 2;
+    HttpServer http(server, config);
+    http.start();
+
+    Tensor input({16});
+    std::string body = "[";
+    for (int i = 0; i < 16; ++i) {
+        input.data()[i] = 0.1f * static_cast<float>(i);
+        body += (i ? "," : "") + std::to_string(0.1 * i);
+    }
+    body += "]";
+    std::string content_type;
+    if (binary) {
+        body = io::TensorWire::encode(input);
+        content_type = std::string("Content-Type: ") +
+                       io::TENSOR_WIRE_CONTENT_TYPE + "\r\n";
+    }
+    const std::string request =
+        "POST /v1/models/mlp/predict HTTP/1.1\r\nHost: bench\r\n" +
+        content_type +
+        "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    std::string burst;
+    for (size_t i = 0; i < depth; ++i) burst += request;
+
+    std::vector<int> fds;
+    for (size_t c = 0; c < connections; ++c) {
+        fds.push_back(connect_loopback(http.port()));
+    }
+
+    for (auto _ : state) {
+        std::vector<std::thread> clients;
+        for (int fd : fds) {
+            clients.emplace_back([fd, &burst, depth] {
+                std::string buffer;
+                for (int round = 0; round < 50; ++round) {
+                    if (::send(fd, burst.data(), burst.size(), 0) < 0) return;
+                    if (!read_responses(fd, depth, buffer)) return;
+                }
+            });
+        }
+        for (auto& t : clients) t.join();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(
+        state.iterations() * 50 * depth * connections));
+    for (int fd : fds) ::close(fd);
+    http.stop();
+    std::remove(MODEL_PATH.c_str());
+    Logger::instance().set_level(LogLevel::INFO);
+}
+BENCHMARK(BM_Http_LoopbackPredict)
+    ->Args({1, 1, 0})->Args({16, 1, 0})->Args({1, 8, 0})->Args({16, 8, 0})
+    ->Args({1, 1, 1})->Args({16, 1, 1})->Args({16, 8, 1})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include "titaninfer/engine/model_server.hpp"
+#include "titaninfer/io/model_serializer.hpp"
+#include "titaninfer/layers/dense_layer.hpp"
+#include "titaninfer/layers/activation_layer.hpp"
+#include "titaninfer/layers/sequential.hpp"
+#include "titaninfer/logger.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace titaninfer;
+using namespace titaninfer::layers;
+using namespace titaninfer::engine;
+
+namespace {
+
+// Replayed trace: a season of SEASON buckets, repeated SEASONS times.
+//   - 2 steady models get traffic in every bucket
+//   - 2 diurnal models split the season in halves
+//   - SEASON hourly-job models each run in exactly one phase
+// Four models are active per bucket and the cache holds four, so every
+// job (and every diurnal switch) is a cold load unless it was prefetched.
+constexpr size_t SEASON = 8;
+constexpr size_t SEASONS = 24;
+constexpr size_t REQUESTS_PER_MODEL = 5;
+constexpr size_t NUM_MODELS = 4 + SEASON;
+
+const std::string MODEL_PATH = "prefetch_benchmark_model.titan";
+
+void save_model() {
+    Sequential model;
+    model.add(std::make_unique<DenseLayer>(4, 16));
+    model.add(std::make_unique<ReluLayer>());
+    model.add(std::make_unique<DenseLayer>(16, 3));
+    io::ModelSerializer::save(model, MODEL_PATH);
+}
+
+std::vector<size_t> active_models(size_t bucket) {
+    const size_t phase = bucket % SEASON;
+    return {0, 1, phase < SEASON / 2 ? 2u : 3u, 4 + phase};
+}
+
+} // anonymous namespace
+
+// Arg 0: no prefetching; Arg 1: prefetch at every bucket boundary
+static void BM_ModelCache_ReplayHitRate(benchmark::State& state) {
+    Logger::instance().set_level(LogLevel::SILENT);
+    const bool prefetch = state.range(0) != 0;
+    save_model();
+
+    CacheStats stats;
+    for (auto _ : state) {
+        PrefetchConfig config;
+        config.bucket_interval = std::chrono::milliseconds(0);  // manual replay
+        config.season_buckets = SEASON;
+        auto builder = ModelServer::Builder();
+        builder.setMaxLoadedModels(4).setWorkerThreads(1).setEnginesPerModel(1);
+        if (prefetch) {
+            builder.enablePrefetch(config);
+        }
+        auto server = builder.build();
+        for (size_t m = 0; m < NUM_MODELS; ++m) {
+            server.register_model("model_" + std::to_string(m), 1,
+                                  MODEL_PATH);
+        }
+
+        Tensor input({4});
+        input.fill(0.5f);
+        for (size_t bucket = 0; bucket < SEASON * SEASONS; ++bucket) {
+            for (size_t m : active_models(bucket)) {
+                for (size_t r = 0; r < REQUESTS_PER_MODEL; ++r) {
+                    benchmark::DoNotOptimize(
+                        server.predict("model_" + std::to_string(m), input));
+                }
+            }
+            server.prefetch_now();  // bucket boundary (no-op when disabled)
+        }
+        stats = server.cache_stats();
+    }
+
+    state.counters["hit_rate"] = stats.hit_rate();
+    state.counters["misses"] = static_cast<double>(stats.misses);
+    state.counters["prefetches"] = static_cast<double>(stats.prefetches);
+    std::remove(MODEL_PATH.c_str());
+    Logger::instance().set_level(LogLevel::INFO);
+}
+BENCHMARK(BM_ModelCache_ReplayHitRate)->Arg(0)->Arg(1)
+    ->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
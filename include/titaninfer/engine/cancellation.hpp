@@ -0,0 +1,103 @@
+#pragma once
+
+#include "titaninfer/exceptions.hpp"
+#include "titaninfer/engine/thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace titaninfer {
+namespace engine {
+
+/**
+ * @brief Cooperative cancellation flag of one request
+ *
+ * Copies share the flag: the owner keeps one copy to cancel() and hands
+ * another down with the request, whose code polls cancelled() at safe
+ * points (queue dequeue, engine lease wait, between layers) and stops
+ * there. A default-constructed token is inert: it can never be cancelled
+ * and costs no allocation. Thread-safe.
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    /// A token that can be cancelled
+    static CancellationToken create() {
+        CancellationToken token;
+        token.flag_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    /// Request cancellation; no-op on an inert token
+    void cancel() noexcept {
+        if (flag_) flag_->store(true, std::memory_order_relaxed);
+    }
+
+    bool cancelled() const noexcept {
+        return flag_ && flag_->load(std::memory_order_relaxed);
+    }
+
+    /// False for an inert token
+    bool cancellable() const noexcept { return flag_ != nullptr; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/**
+ * @brief When a request should stop: a deadline and/or a cancellation token
+ *
+ * The defaults impose no limit. Checks are cheap when inactive(), so hot
+ * loops can call check() unconditionally. The limits also carry the
+ * request's scheduling priority, which picks its executor and batcher lane.
+ */
+struct ExecutionLimits {
+    using Clock = std::chrono::steady_clock;
+
+    /// time_point::max() disables the deadline
+    Clock::time_point deadline = Clock::time_point::max();
+    CancellationToken cancellation = {};
+    TaskPriority priority = TaskPriority::NORMAL;
+
+    /// Limits with a deadline `timeout` from now
+    static ExecutionLimits within(std::chrono::nanoseconds timeout) {
+        ExecutionLimits limits;
+        limits.deadline = Clock::now() + timeout;
+        return limits;
+    }
+
+    bool active() const noexcept {
+        return deadline != Clock::time_point::max() ||
+               cancellation.cancellable();
+    }
+
+    /// True once cancelled or past the deadline
+    bool stop_requested() const noexcept {
+        return cancellation.cancelled() ||
+               (deadline != Clock::time_point::max() &&
+                Clock::now() >= deadline);
+    }
+
+    /**
+     * @brief Throw if the request should stop
+     * @throws InferenceException(CANCELLED) if the token was cancelled
+     * @throws InferenceException(DEADLINE_EXCEEDED) if the deadline passed
+     */
+    void check(const char* where) const {
+        if (cancellation.cancelled()) {
+            throw InferenceException(std::string(where) + ": cancelled",
+                                     ErrorCode::CANCELLED);
+        }
+        if (deadline != Clock::time_point::max() && Clock::now() >= deadline) {
+            throw InferenceException(std::string(where) +
+                                     ": deadline exceeded",
+                                     ErrorCode::DEADLINE_EXCEEDED);
+        }
+    }
+};
+
+} // namespace engine
+} // namespace titaninfer
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace titaninfer {
+namespace engine {
+
+/// (model name, version)
+using ModelKey = std::pair<std::string, uint32_t>;
+
+struct ModelKeyHash {
+    size_t operator()(const ModelKey& k) const {
+        size_t h1 = std::hash<std::string>{}(k.first);
+        size_t h2 = std::hash<uint32_t>{}(k.second);
+        return h1 ^ (h2 * 2654435761u);
+    }
+};
+
+/**
+ * @brief Configuration of the ModelServer's predictive prefetcher
+ */
+struct PrefetchConfig {
+    bool enabled = false;
+
+    /// Width of one access-count time bucket; the prefetcher runs at every
+    /// bucket boundary. 0 = no background thread, call
+    /// ModelServer::prefetch_now() to close buckets manually.
+    std::chrono::milliseconds bucket_interval{1000};
+
+    /// Buckets per season (e.g. 24 one-hour buckets for a daily pattern);
+    /// 0 = level (EWMA) forecast only
+    size_t season_buckets = 0;
+
+    double alpha = 0.3;           ///< EWMA weight of the latest bucket
+    double seasonal_alpha = 0.5;  ///< EWMA weight of the latest season
+
+    /// Forecast requests per bucket at which a model is worth preloading.
+    /// Loaded models forecast lower than the model being preloaded may be
+    /// evicted to make room for it.
+    double min_rate = 1.0;
+};
+
+/**
+ * @brief Per-model demand forecaster over fixed time buckets
+ *
+ * Callers record(...) accesses into the open bucket and advance() at each
+ * bucket boundary. Each model keeps an EWMA level over recent buckets and,
+ * with season_buckets > 0, one EWMA per phase of the season fed only by
+ * buckets at that phase, so a job that runs every hour is forecast at the
+ * same phase of the next hour even though it is idle in between. The
+ * forecast for the open bucket is the larger of the two.
+ *
+ * Not thread-safe; the ModelServer drives it from its prefetcher thread.
+ */
+class DemandPredictor {
+public:
+    explicit DemandPredictor(const PrefetchConfig& config);
+
+    /// Count `count` requests for `key` in the open bucket
+    void record(const ModelKey& key, uint64_t count = 1);
+
+    /// Close the open bucket and fold its counts into every forecast
+    void advance();
+
+    /// Forecast requests for `key` in the open bucket (0 if never seen)
+    double forecast(const ModelKey& key) const;
+
+    /// Every known model with its forecast, highest first
+    std::vector<std::pair<ModelKey, double>> ranked() const;
+
+    /// Index of the open bucket (number of advance() calls)
+    uint64_t bucket() const noexcept { return bucket_; }
+
+private:
+    struct Series {
+        double count = 0.0;          // open bucket
+        double level = 0.0;
+        std::vector<double> seasonal;
+        std::vector<bool> seasonal_seen;
+    };
+
+    double forecast(const Series& series) const;
+
+    PrefetchConfig config_;
+    uint64_t bucket_ = 0;
+    std::unordered_map<ModelKey, Series, ModelKeyHash> series_;
+};
+
+} // namespace engine
+} // namespace titaninfer
@@ -2,37 +2,222 @@
 
 #include "titaninfer/tensor.hpp"
 #include "titaninfer/layers/sequential.hpp"
+#include "titaninfer/engine/model_compiler.hpp"
+#include "titaninfer/engine/mpmc_queue.hpp"
+#include "titaninfer/engine/thread_pool.hpp"
 
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
+#include <cstdint>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace titaninfer {
 namespace engine {
 
+/**
+ * @brief What to return for a request that was padded up to its bucket
+ *
+ * CROP and MASK assume the model output has the same rank as its input
+ * sample and that each output dimension scales with the matching input
+ * dimension (per-position outputs, "same"-padded convolutions); the valid
+ * extent is ceil(out_dim * sample_dim / bucket_dim). Outputs of another
+ * rank are always returned as KEEP.
+ */
+enum class PadOutput {
+    KEEP,  ///< Full bucket-shaped output (e.g. pooled classifier heads)
+    CROP,  ///< Copy out only the region produced by the real input
+    MASK,  ///< Bucket-shaped output with the padded region zeroed
+};
+
 struct BatcherConfig {
     size_t max_batch_size = 32;
     size_t max_wait_ms = 10;
+    size_t queue_capacity = 1024;  ///< Pending requests before reserve() rejects (whole arenas)
+    size_t num_workers = 1;        ///< Executor threads, each with its own compiled plan
+
+    /// Let AdaptiveBatchPolicy choose batch size and wait time online.
+    /// max_batch_size and max_wait_ms then act as upper bounds.
+    bool adaptive = false;
+    double target_p99_ms = 50.0;   ///< End-to-end latency SLO (adaptive mode)
+
+    /// Padded sample shapes for variable-size inputs. A request goes to the
+    /// smallest bucket (by element count) that fits it in every dimension
+    /// and is zero-padded. Empty = one bucket of exactly input_shape.
+    /// Each bucket gets its own arenas, timers, policy and compiled plans;
+    /// queue_capacity applies per bucket.
+    std::vector<std::vector<size_t>> shape_buckets = {};
+    PadOutput pad_output = PadOutput::KEEP;
+};
+
+/**
+ * @brief Observable state of the adaptive batching controller
+ */
+struct BatchPolicyState {
+    double arrival_rate_per_ms = 0.0;  ///< EWMA of request arrivals
+    size_t batch_size = 1;             ///< Current target batch size
+    double wait_ms = 0.0;              ///< Current max wait for the batch to fill
+    double observed_p99_ms = 0.0;      ///< Over the last LATENCY_WINDOW requests
+    double target_p99_ms = 0.0;
+    double latency_budget_ms = 0.0;    ///< target scaled by feedback slack
+    uint64_t batches_observed = 0;
+    std::vector<double> exec_ms_by_size; ///< [b-1] = EWMA exec time, 0 = unseen
+};
+
+/**
+ * @brief SLO-driven controller for batch size and batch-formation wait
+ *
+ * Tracks the request arrival rate and an EWMA of execution latency per
+ * batch size (linearly extrapolated for sizes not yet seen). For every
+ * candidate size b it predicts latency as the time needed for b requests
+ * to arrive plus exec(b). Among sizes whose prediction fits the latency
+ * budget it picks the smallest one whose throughput W * b / exec(b) (W =
+ * executor workers) keeps up
+ * with the arrival rate, or the highest-throughput one if none does; the
+ * wait time is the expected time for that batch to fill. The budget is the
+ * p99 target scaled by a slack factor that shrinks while the observed p99
+ * overshoots the target and recovers slowly when it is comfortably met.
+ *
+ * record_arrival() is lock-free and may be called from any thread; the
+ * remaining mutators are called by the batcher thread only.
+ */
+class AdaptiveBatchPolicy {
+public:
+    static constexpr size_t LATENCY_WINDOW = 512;
+
+    struct Decision {
+        size_t batch_size;
+        std::chrono::microseconds max_wait;
+    };
+
+    explicit AdaptiveBatchPolicy(const BatcherConfig& config);
+
+    void record_arrival() noexcept {
+        arrivals_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record_batch(size_t batch_size, double exec_ms);
+    void record_latency(double latency_ms);
+
+    /// Re-estimate the arrival rate at `now` and choose the next batch shape
+    Decision decide(std::chrono::steady_clock::time_point now);
+
+    BatchPolicyState state() const;
+
+private:
+    double predicted_exec_ms(size_t batch_size) const;
+
+    BatcherConfig config_;
+    std::atomic<uint64_t> arrivals_{0};
+
+    mutable std::mutex mutex_;  // guards everything below (for state())
+    uint64_t last_arrivals_ = 0;
+    std::chrono::steady_clock::time_point last_decide_;
+    bool rate_initialized_ = false;
+    std::vector<double> exec_ewma_;
+    std::vector<double> latencies_;  // ring buffer
+    size_t latency_next_ = 0;
+    double slack_ = 1.0;
+    BatchPolicyState state_;
+};
+
+/**
+ * @brief Request counters of a DynamicBatcher
+ */
+struct BatcherMetrics {
+    uint64_t submitted = 0;     ///< Requests accepted by submit()
+    uint64_t completed = 0;     ///< Requests that ran (result or model error)
+    uint64_t shed_expired = 0;  ///< Dropped because their deadline passed in the queue
+    uint64_t rejected_full = 0; ///< Refused by reserve() with QUEUE_FULL
+    uint64_t batches = 0;       ///< Batches executed
 };
 
 /**
  * @brief Dynamic batcher for grouping concurrent inference requests
  *
- * Queues individual predict() requests and groups them into optimal
- * batch sizes. Uses a dedicated background thread to form batches.
+ * Requests are staged directly in pre-allocated batch buffers ("arenas"),
+ * each holding max_batch_size input rows laid out exactly as the batched
+ * model input. reserve() claims the next row of the open arena with one
+ * atomic increment and hands the caller a view of it; the caller fills it
+ * and submits it. A dedicated former thread seals each open arena once
+ * it reaches the target size or its own timer (started by its first
+ * request) expires, or when it fills, and hands it to one of `num_workers`
+ * executor threads, each owning a CompiledModel with a batched plan, so
+ * the next batch accumulates while earlier ones compute. When every worker
+ * is busy, the former holds open arenas until a worker frees up or they
+ * fill. A sealed arena whose reserved rows are still being filled is set
+ * aside until its last row commits, so a slow filler delays only its own
+ * batch.
+ *
+ * Variable-size inputs are grouped into shape buckets (see
+ * BatcherConfig::shape_buckets): each bucket has its own arenas, timers,
+ * adaptive policy and per-worker compiled plans, and padded outputs are
+ * returned according to BatcherConfig::pad_output.
+ *
+ * Results are views into a per-batch output buffer drawn from a recycling
+ * pool; the buffer returns to the pool when the last result of its batch
+ * is destroyed. No per-request allocation or copy happens on the
+ * reserve()/submit(InputSlot) path.
+ *
+ * Every request carries TaskOptions: a priority picks one of the
+ * ThreadPool::NUM_LANES lanes, each with its own open arena, and the former
+ * seals the most urgent non-empty lane first (a lower lane bypassed
+ * ThreadPool::STARVATION_LIMIT times in a row goes next). A request whose
+ * deadline has passed when its batch is formed is dropped before it reaches
+ * the model; its future throws InferenceException(DEADLINE_EXCEEDED) and
+ * it is counted in BatcherMetrics::shed_expired.
+ *
+ * When no arena is free, reserve() fails fast with
+ * TitanInferException(QUEUE_FULL).
  */
 class DynamicBatcher {
+    struct Arena;
+    struct Bucket;
+    struct OutputPool;
+
 public:
     /**
-     * @param model Borrowed reference to Sequential model (caller keeps alive)
-     * @param input_shape Shape of a single input sample
+     * @brief Reserved input row in a staging arena
+     *
+     * tensor() is a view of the row the model will read, shaped like the
+     * bucket. For a sample smaller than its bucket the row is zeroed and the
+     * sample goes in its leading corner. Fill it and pass the slot to
+     * submit(). Hold a slot only while
+     * filling it: its batch cannot be dispatched until the slot is
+     * submitted or destroyed (a destroyed slot is skipped). Move-only.
+     */
+    class InputSlot {
+    public:
+        InputSlot(InputSlot&& other) noexcept;
+        InputSlot& operator=(InputSlot&&) = delete;
+        ~InputSlot();
+
+        Tensor& tensor() noexcept { return view_; }
+
+    private:
+        friend class DynamicBatcher;
+        InputSlot(DynamicBatcher* owner, Arena* arena, uint32_t row, Tensor view);
+
+        DynamicBatcher* owner_;
+        Arena* arena_;  // nullptr once submitted or moved from
+        uint32_t row_;
+        Tensor view_;
+    };
+
+    /**
+     * @param model Sequential model; only read during construction, each
+     *              worker compiles its own batched plan from it
+     * @param input_shape Shape of a single input sample (the default for
+     *                    reserve() without a shape)
      * @param config Batching configuration
+     * @throws std::invalid_argument if a bucket's rank differs from input_shape
      */
-    DynamicBatcher(layers::Sequential& model,
+    DynamicBatcher(const layers::Sequential& model,
                    const std::vector<size_t>& input_shape,
                    const BatcherConfig& config = {});
     ~DynamicBatcher();
@@ -40,25 +225,84 @@ public:
     DynamicBatcher(const DynamicBatcher&) = delete;
     DynamicBatcher& operator=(const DynamicBatcher&) = delete;
 
-    /// Submit a single input for inference, returns future for result
-    std::future<Tensor> submit(Tensor input);
+    /**
+     * @brief Claim a staging row to write an input into
+     * @param options Priority lane and queue deadline of the request
+     * @throws TitanInferException(QUEUE_FULL) if every arena is in use
+     */
+    InputSlot reserve(const TaskOptions& options = {});
+
+    /**
+     * @brief Claim a staging row for a sample of the given shape
+     * @throws ValidationException(SHAPE_MISMATCH) if no bucket fits it
+     * @throws TitanInferException(QUEUE_FULL) if the bucket has no free arena
+     */
+    InputSlot reserve(const std::vector<size_t>& shape,
+                      const TaskOptions& options = {});
+
+    /// Submit a filled slot; the result is a view into a pooled output buffer
+    std::future<Tensor> submit(InputSlot slot);
+
+    /// Copy a single input (padded to its bucket) into a staging row and submit it
+    std::future<Tensor> submit(const Tensor& input,
+                               const TaskOptions& options = {});
+
+    /// Snapshot of a bucket's adaptive controller (static config when not adaptive)
+    BatchPolicyState policy_state(size_t bucket = 0) const;
+
+    size_t bucket_count() const noexcept { return buckets_.size(); }
+
+    BatcherMetrics metrics() const;
+
+    size_t worker_count() const noexcept { return workers_.size(); }
 
 private:
     void batcher_loop();
+    void worker_loop(size_t index);
+    void execute(CompiledModel& plan, Arena& arena);
 
-    struct Request {
-        Tensor input;
-        std::promise<Tensor> promise;
-    };
+    Bucket& bucket_for(const std::vector<size_t>& shape);
+    InputSlot reserve(Bucket& bucket, const std::vector<size_t>& shape,
+                      const TaskOptions& options);
+
+    // Arena rotation; callers hold rotate_mutex_
+    void install_arena_locked(Bucket& bucket, size_t lane);
+    void seal_arena_locked(Arena* arena);
+    void seal_open_arena(Bucket& bucket, size_t lane);
+    size_t shed_expired(Arena& arena);
+    std::optional<Arena*> next_closed();
+    void dispatch(Arena* arena);
+    bool dispatch_filled();
+    void recycle(Arena* arena);
+
+    void commit(Arena* arena, uint32_t row, bool live);
 
-    layers::Sequential& model_;
     std::vector<size_t> input_shape_;
     BatcherConfig config_;
+    std::vector<std::unique_ptr<Bucket>> buckets_;  // ascending element count
+
+    std::mutex rotate_mutex_;            // slow path: sealing / installing
+    std::array<std::unique_ptr<MpmcQueue<Arena*>>, ThreadPool::NUM_LANES>
+        closed_;                         // sealed, awaiting dispatch
+    std::array<size_t, ThreadPool::NUM_LANES> bypassed_{};  // former only
+    std::vector<Arena*> filling_;        // sealed, rows still being filled (former only)
+    std::atomic<bool> stop_{false};
+    IdleWaiter idle_;                    // former waiting for requests or a worker
+
+    // Former -> workers hand-off
+    std::unique_ptr<MpmcQueue<Arena*>> batches_;
+    std::atomic<int64_t> pending_batches_{0};
+    std::atomic<size_t> in_flight_{0};   // dispatched, not yet executed
+    std::atomic<bool> former_done_{false};
+    IdleWaiter workers_idle_;  // workers waiting for a batch
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> shed_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> batch_count_{0};
 
-    std::queue<Request> queue_;
-    std::mutex mutex_;
-    std::condition_variable cv_;
-    bool stop_;
+    std::vector<std::thread> workers_;
     std::thread thread_;
 };
 
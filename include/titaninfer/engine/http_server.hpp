@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "titaninfer/engine/model_server.hpp"
+
+namespace titaninfer::engine {
+
+// ---------------------------------------------------------------------------
+// HTTP/1.1 front-end for ModelServer (Linux, epoll)
+// ---------------------------------------------------------------------------
+
+struct HttpServerConfig {
+    std::string bind_address = "127.0.0.1";
+    uint16_t port = 0;                ///< 0 = pick a free port, see port()
+    size_t io_threads = 2;            ///< Event loops; each owns its connections
+    size_t max_pipelined = 64;        ///< In-flight requests per connection
+    size_t max_header_bytes = 16 * 1024;
+    size_t max_body_bytes = 64 * 1024 * 1024;
+    int listen_backlog = 1024;
+};
+
+/**
+ * @brief Counters of an HttpServer (monotonic except open_connections)
+ */
+struct HttpServerStats {
+    uint64_t accepted_connections = 0;
+    uint64_t open_connections = 0;
+    uint64_t requests = 0;
+    uint64_t bad_requests = 0;  ///< Rejected before reaching the ModelServer
+};
+
+/**
+ * @brief Non-blocking HTTP/1.1 server that feeds ModelServer::handle_request
+ *
+ * A fixed set of I/O threads each run an epoll loop; the listening socket
+ * is shared with EPOLLEXCLUSIVE so an incoming connection wakes one loop,
+ * which then owns it for its lifetime. Loops only parse and write bytes:
+ * every request is handed to the ModelServer executor, and the worker that
+ * finishes it serializes the response and queues it back to the owning
+ * loop (woken through an eventfd).
+ *
+ * Connections are persistent unless the client sends "Connection: close"
+ * (or speaks HTTP/1.0 without keep-alive). Requests may be pipelined up to
+ * max_pipelined per connection; responses are always written in request
+ * order. Bodies are parsed straight into buffers of the ModelServer's
+ * TensorPool that the Request tensor views, so no intermediate copy is made.
+ * When a client disconnects (a reset, or a send that fails), the requests
+ * still running for it are cancelled through their ExecutionLimits token
+ * and stop at the next layer boundary. A client that only shuts down its
+ * sending side still gets the responses of every request it sent,
+ * including those still buffered behind max_pipelined.
+ *
+ * Request format:
+ *   POST /v1/models/{name}[/versions/{v}]/predict HTTP/1.1
+ *   Content-Length: n          (required; chunked bodies are rejected)
+ *   X-Shape: 1,4               (optional; default is a 1-D tensor)
+ *   X-Tenant-Id, X-Request-Id  (optional; forwarded to the ModelServer)
+ *   X-Deadline-Ms: 50          (optional; time budget, answered 504 when
+ *                               exceeded; capped at 24 hours)
+ *   X-Priority: background     (optional; latency-critical, normal or
+ *                               background: the request's executor lane)
+ *
+ *   [1.0, 2.0, 3.0, 4.0]       (numbers separated by commas/whitespace)
+ *
+ * Responses carry the output as the same kind of JSON array with an
+ * X-Shape header, plus the ModelServer response headers; errors carry the
+ * message as text/plain.
+ *
+ * With "Content-Type: application/x-titan-tensor" the body is instead one
+ * io::TensorWire frame (X-Shape is ignored). The frame is received into a
+ * 64-byte aligned, reference-counted block with its payload aligned, and
+ * the request tensor is a view of that block. The response then uses the
+ * same encoding (unless Accept asks otherwise; Accept naming the wire type
+ * also selects it for JSON requests) and is written with one gathered
+ * send of head, frame header and the output tensor's own memory.
+ *
+ * The ModelServer must outlive the HttpServer. Non-copyable, non-movable.
+ */
+class HttpServer {
+public:
+    HttpServer(ModelServer& server, const HttpServerConfig& config = {});
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    /**
+     * @brief Bind, listen and start the I/O threads
+     * @throws ServerException if the address cannot be bound
+     */
+    void start();
+
+    /// Stop accepting, close every connection and join the I/O threads.
+    /// Responses still being computed are dropped. Idempotent.
+    void stop();
+
+    bool running() const noexcept;
+
+    /// Bound port (the chosen one when HttpServerConfig::port is 0)
+    uint16_t port() const noexcept;
+
+    HttpServerStats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace titaninfer::engine
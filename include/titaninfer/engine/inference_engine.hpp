@@ -1,6 +1,7 @@
 #pragma once
 
 #include "titaninfer/tensor.hpp"
+#include "titaninfer/engine/cancellation.hpp"
 #include "titaninfer/layers/sequential.hpp"
 #include "titaninfer/io/model_parser.hpp"
 #include <memory>
@@ -61,6 +62,26 @@ public:
      */
     Tensor predict(const Tensor& input);
 
+    /**
+     * @brief Run inference that stops between layers once `limits` expire
+     *
+     * The deadline and cancellation token are checked before every layer,
+     * so an abandoned request gives up its engine after at most one more
+     * layer.
+     * @throws InferenceException(DEADLINE_EXCEEDED or CANCELLED) when stopped
+     */
+    Tensor predict(const Tensor& input, const ExecutionLimits& limits);
+
+    /**
+     * @brief Run inference with the last layer writing into `output`
+     *
+     * No result copy is made when `output` already has output_shape()
+     * (e.g. a TensorPool view); otherwise the layer replaces it with a
+     * tensor of the right shape.
+     */
+    void predict_into(const Tensor& input, Tensor& output,
+                      const ExecutionLimits& limits = {});
+
     /**
      * @brief Run inference on a batch of individual inputs
      * @param inputs Vector of input tensors
@@ -90,6 +111,12 @@ public:
      */
     const std::vector<size_t>& expected_input_shape() const;
 
+    /**
+     * @brief Shape of predict()'s result
+     * @throws std::runtime_error if no model is loaded
+     */
+    const std::vector<size_t>& output_shape() const;
+
     /**
      * @brief Get the model summary string
      * @throws std::runtime_error if no model is loaded
@@ -101,14 +128,24 @@ public:
      */
     size_t layer_count() const;
 
+    /**
+     * @brief The loaded model (e.g. to compile batched plans from it)
+     * @throws std::runtime_error if no model is loaded
+     */
+    const layers::Sequential& model() const;
+
 private:
     InferenceEngine();
 
     void load_model(const std::string& filepath,
                     const std::vector<size_t>& input_shape);
+    void set_model(std::unique_ptr<layers::Sequential> model,
+                   const std::vector<size_t>& input_shape);
     void allocate_buffers();
     void warmup(size_t num_runs);
     void validate_input(const Tensor& input) const;
+    void run(const Tensor& input, Tensor& output,
+             const ExecutionLimits& limits);
 
     std::unique_ptr<layers::Sequential> model_;
     std::vector<size_t> input_shape_;
@@ -136,10 +173,21 @@ public:
     /** @brief Override expected input shape (inferred from first DenseLayer if not set) */
     Builder& setInputShape(const std::vector<size_t>& shape);
 
+    /**
+     * @brief Run an already loaded model instead of reading a file
+     *
+     * The engine gets its own layers and buffers, but its weights are
+     * views of `model`'s (Sequential::clone_shared), which stays alive as
+     * long as any engine built from it. Many engines of one model then
+     * cost one copy of the weights. Takes precedence over setModelPath().
+     */
+    Builder& setSharedModel(std::shared_ptr<const layers::Sequential> model);
+
     /**
      * @brief Construct the InferenceEngine
      * @return Configured InferenceEngine
-     * @throws std::invalid_argument if model_path is not set
+     * @throws std::invalid_argument if neither a model path nor a shared
+     *         model is set
      * @throws std::runtime_error if model file cannot be loaded
      */
     InferenceEngine build();
@@ -149,6 +197,7 @@ private:
     bool profiling_enabled_;
     size_t warmup_runs_;
     std::vector<size_t> input_shape_;
+    std::shared_ptr<const layers::Sequential> shared_model_;
 };
 
 } // namespace engine
@@ -13,18 +13,38 @@ namespace engine {
 struct CompileOptions {
     bool enable_fusion = true;
     bool enable_quantization = false;
+    size_t max_batch_size = 0;  ///< > 0 also pre-allocates a batched plan
 };
 
 /**
  * @brief Compiled model with optimized execution plan
  *
- * Pre-allocates all intermediate buffers for zero-alloc inference.
+ * Pre-allocates all intermediate buffers for zero-alloc inference. When
+ * compiled with max_batch_size > 0 it also owns a batched plan: buffers
+ * sized for the largest batch, re-viewed at the actual batch size. Dense
+ * layers keep their transposed weights after the first batch, so once
+ * warm predict_batch() allocates no tensor buffers, except that quantized
+ * layers still quantize each batch into a fresh buffer.
  */
 class CompiledModel {
 public:
     /// Run inference with pre-allocated buffers
     Tensor predict(const Tensor& input);
 
+    /**
+     * @brief Run n stacked samples through the batched plan
+     * @param input Shape {n, input_shape...}, 1 <= n <= max_batch_size()
+     * @param output Final layer output; pass a view of batch_output_shape(n)
+     *               to have the result written in place
+     * @throws std::invalid_argument on shape mismatch or oversized batch
+     */
+    void predict_batch(const Tensor& input, Tensor& output);
+
+    /// Output shape of predict_batch() for a batch of n samples
+    const std::vector<size_t>& batch_output_shape(size_t n) const;
+
+    size_t max_batch_size() const { return batch_shapes_.size(); }
+
     std::string summary() const;
     const std::vector<size_t>& input_shape() const { return input_shape_; }
     size_t layer_count() const;
@@ -35,6 +55,12 @@ private:
     std::unique_ptr<layers::Sequential> model_;
     std::vector<size_t> input_shape_;
     std::vector<Tensor> buffers_;
+
+    // Batched plan: batch_shapes_[n - 1][i] is layer i's output for n samples
+    std::vector<std::vector<std::vector<size_t>>> batch_shapes_;
+    std::vector<Tensor> batch_buffers_;  // intermediates sized for max batch
+    std::vector<Tensor> batch_views_;    // batch_buffers_ at the current size
+    size_t batch_views_size_ = 0;
 };
 
 /**
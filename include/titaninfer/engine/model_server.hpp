@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <future>
 #include <memory>
 #include <set>
@@ -8,6 +9,11 @@
 #include <vector>
 
 #include "titaninfer/tensor.hpp"
+#include "titaninfer/engine/cancellation.hpp"
+#include "titaninfer/engine/demand_predictor.hpp"
+#include "titaninfer/engine/dynamic_batcher.hpp"
+#include "titaninfer/engine/result_cache.hpp"
+#include "titaninfer/engine/tensor_pool.hpp"
 
 namespace titaninfer::engine {
 
@@ -24,6 +30,10 @@ struct Request {
     std::string tenant_id;
     Tensor body{std::vector<size_t>{1}};
     std::unordered_map<std::string, std::string> headers;
+    // Deadline and cancellation, checked in the executor queue, the engine
+    // lease wait and between layers. A request stopped by them answers 504
+    // (deadline) or 499 (cancelled). limits.priority picks its lane.
+    ExecutionLimits limits = {};
 };
 
 struct Response {
@@ -49,18 +59,253 @@ struct ModelVersionInfo {
 struct TenantQuota {
     double max_qps = 100.0;
     size_t max_concurrent = 10;
+    double weight = 1.0;  // share of the workers under fair queuing
 };
 
 struct TrafficRule {
     uint32_t version = 0;
+    double weight = 1.0;  // relative to the other rules of the model
+};
+
+/**
+ * @brief What keeps a caller on one version under a traffic split
+ *
+ * With NONE every request is routed independently at random. TENANT and
+ * REQUEST_ID hash that ID onto the split instead, so the same caller
+ * lands on the same version (and its warm engines) while the rules stay
+ * unchanged. Requests without the ID fall back to random routing.
+ */
+enum class StickyRouting { NONE, TENANT, REQUEST_ID };
+
+/**
+ * @brief Batching mode for one model version (or every version of a model)
+ *
+ * Requests to a batched model version are coalesced by a DynamicBatcher
+ * into batched forward passes instead of leasing one engine each. The
+ * batcher runs one executor per pool engine (batcher.num_workers is
+ * replaced by the engine pool size).
+ */
+struct ModelBatchingConfig {
+    std::string model_name;
+    uint32_t version = 0;            // 0 = every version of model_name
+    BatcherConfig batcher = {};
+};
+
+/**
+ * @brief Result memoization for every version of one model
+ *
+ * Predictions of the model are looked up by a hash of the input tensor
+ * before they run, and successful outputs are kept in a byte-bounded
+ * sharded LRU (ResultCache). Entries belong to the engine pool that
+ * produced them, so a reload_model() or a new default version never
+ * serves stale results; the old entries are dropped as well. Only for
+ * deterministic models.
+ */
+struct ModelResultCacheConfig {
+    std::string model_name;
+    ResultCacheConfig cache = {};
+};
+
+/**
+ * @brief Single-flight counters of one model (Builder::enableCoalescing)
+ */
+struct CoalescingStats {
+    uint64_t leaders = 0;    ///< Requests that ran inference for their flight
+    uint64_t coalesced = 0;  ///< Requests answered by an identical in-flight one
+    uint64_t reruns = 0;     ///< Followers that ran alone after the leader
+                             ///< was stopped by its deadline or cancellation
+};
+
+/**
+ * @brief Elastic sizing of unbatched engine pools
+ *
+ * A loaded model version starts with min_engines engines. A request that
+ * waited grow_wait_us for a free engine adds one, up to max_engines; new
+ * engines share the pool's weights, so growing allocates only their
+ * activation buffers. At the end of each idle_ms window the engines that
+ * were never needed during it (beyond the most leased at once) are
+ * released, down to min_engines. Windows close as leases are returned and
+ * on a background timer, so a pool that stops receiving traffic shrinks
+ * back to min_engines within two windows.
+ * Batched pools keep one engine per batcher executor and do not resize.
+ */
+struct ElasticPoolConfig {
+    bool enabled = false;
+    size_t min_engines = 1;
+    size_t max_engines = 0;      // 0 = engines_per_model (or worker count)
+    size_t grow_wait_us = 500;   // lease wait that adds an engine
+    size_t idle_ms = 1000;       // spare-capacity window that retires engines
+};
+
+/**
+ * @brief Size of one model version's engine pool
+ */
+struct EnginePoolStats {
+    size_t engines = 0;       ///< Engines currently in the pool
+    size_t min_engines = 0;
+    size_t max_engines = 0;
+    uint64_t grown = 0;       ///< Engines added on lease waits
+    uint64_t shrunk = 0;      ///< Engines retired after idle windows
+};
+
+/**
+ * @brief How the model cache picks a victim when it is full
+ */
+enum class EvictionPolicy {
+    LRU,   ///< Least recently used
+    GDSF,  ///< GreedyDual-Size-Frequency: keep small, hot, slow-to-load models
+};
+
+/**
+ * @brief How reload_model() brings up and cuts over to a new model file
+ */
+struct ReloadConfig {
+    size_t warmup_runs = 2;    // zero-input passes per new engine
+    size_t replay_inputs = 8;  // recent request inputs replayed; 0 = none
+    size_t ramp_ms = 0;        // traffic shift duration; 0 = instant cutover
+};
+
+/**
+ * @brief CoDel admission control of the asynchronous request path
+ *
+ * The time each async request spends queued before a worker picks it up
+ * (its sojourn time) is tracked per model. Once sojourns have stayed above
+ * `target_delay_ms` for a whole `interval_ms`, the model has a standing
+ * queue and enters CoDel's dropping state: one request is dropped, then
+ * the next after interval / sqrt(drops so far), with the requests in
+ * between served, so the drop rate rises only while the queue persists.
+ * The state ends as soon as a request is dequeued below the target. A
+ * scheduled drop may refuse an arrival instead of a queued request. Both
+ * are 503 responses with a Retry-After header, so the queue delay is
+ * pulled back towards the target while goodput stays up.
+ */
+struct AdmissionConfig {
+    bool enabled = false;
+    size_t target_delay_ms = 5;   // acceptable standing queue delay
+    size_t interval_ms = 100;     // window the delay must exceed the target
+    size_t retry_after_s = 1;     // Retry-After of rejected requests
+};
+
+/**
+ * @brief Admission counters of one model (AdmissionConfig)
+ */
+struct AdmissionStats {
+    uint64_t admitted = 0;          ///< Async requests that reached a worker
+    uint64_t shed_on_arrival = 0;   ///< Rejected before being queued
+    uint64_t shed_in_queue = 0;     ///< Dropped at dequeue, past the limit
+    size_t queued = 0;              ///< Admitted, not yet dequeued
+    bool overloaded = false;        ///< In CoDel's dropping state
+    double last_sojourn_ms = 0.0;   ///< Queue wait of the last dequeued request
+};
+
+/**
+ * @brief Fallback of a model to a faster variant while it is overloaded
+ *
+ * Requests that do not name a version normally go to the model's traffic
+ * split or highest version. While the model is degraded they go to
+ * fallback_version instead (say, an INT8 compiled variant registered
+ * under the same name). Degradation starts when the smoothed queueing
+ * delay of the model's requests, or the number of predictions running
+ * per worker thread, rises above its enter threshold. It ends when both
+ * fall below their exit thresholds, but not before min_dwell_ms after the
+ * switch. A threshold of 0 ignores that signal. Requests that name a
+ * version (/versions/{v}/predict) count towards the load but are never
+ * rerouted.
+ */
+struct DegradationPolicy {
+    std::string model_name;
+    uint32_t fallback_version = 0;
+    double enter_delay_ms = 20.0;
+    double exit_delay_ms = 5.0;
+    double enter_saturation = 0.0;  // running predictions per worker
+    double exit_saturation = 0.0;
+    size_t min_dwell_ms = 1000;
+};
+
+/**
+ * @brief Degradation state of one model (Builder::enableDegradation)
+ */
+struct DegradationStats {
+    bool degraded = false;
+    uint64_t degradations = 0;       ///< Switches to the fallback version
+    uint64_t recoveries = 0;         ///< Switches back
+    uint64_t fallback_requests = 0;  ///< Requests routed to the fallback
+    double queue_delay_ms = 0.0;     ///< Smoothed, as last observed
+    double saturation = 0.0;         ///< Smoothed, as last observed
+};
+
+/**
+ * @brief Fair-queue counters of one tenant (Builder::enableFairQueuing)
+ *
+ * Wait time runs from submission until a worker was given the request.
+ */
+struct TenantQueueStats {
     double weight = 1.0;
+    size_t queued = 0;           ///< Waiting for a worker now
+    uint64_t dispatched = 0;     ///< Handed to a worker
+    uint64_t rejected = 0;       ///< Refused because the queue was full
+    double total_wait_ms = 0.0;
+    double max_wait_ms = 0.0;
+
+    double mean_wait_ms() const noexcept {
+        return dispatched == 0 ? 0.0 : total_wait_ms /
+                                       static_cast<double>(dispatched);
+    }
 };
 
 struct ModelServerConfig {
     size_t max_loaded_models = 16;
+    size_t max_loaded_bytes = 0;     // estimated pool memory budget; 0 = none
+    EvictionPolicy eviction_policy = EvictionPolicy::LRU;
     size_t worker_threads = 0;       // 0 = hardware_concurrency
     size_t engines_per_model = 0;    // 0 = worker_threads count
+    ElasticPoolConfig elastic_pools = {};
     bool enable_profiling = false;
+    size_t queue_capacity = 4096;    // async requests queued before 503
+    bool fair_queuing = false;       // per-tenant weighted queues, see Builder
+    size_t load_timeout_ms = 0;      // cold-load wait before 503; 0 = block
+    std::vector<ModelBatchingConfig> batching = {};  // exact version wins
+    std::vector<ModelResultCacheConfig> result_caches = {};
+    std::vector<std::string> coalesced_models = {};  // single-flight predicts
+    std::vector<DegradationPolicy> degradation = {};
+    PrefetchConfig prefetch = {};
+    ReloadConfig reload = {};
+    AdmissionConfig admission = {};
+    TensorPoolConfig tensor_pool = {};  // request/response buffer reuse
+};
+
+/**
+ * @brief Model cache counters
+ */
+struct CacheStats {
+    uint64_t hits = 0;        ///< Requests whose model was already loaded
+    uint64_t misses = 0;      ///< Requests that waited for (or timed out on) a load
+    uint64_t prefetches = 0;  ///< Loads started by the prefetcher
+
+    double hit_rate() const noexcept {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) /
+                                  static_cast<double>(total);
+    }
+};
+
+/**
+ * @brief Requests stopped by their ExecutionLimits
+ *
+ * Latency runs from the request's arrival at the server (its submission,
+ * for the async calls) until it was stopped.
+ */
+struct AbortStats {
+    uint64_t deadline_exceeded = 0;
+    uint64_t cancelled = 0;
+    double total_latency_ms = 0.0;
+    double max_latency_ms = 0.0;
+
+    double mean_latency_ms() const noexcept {
+        uint64_t total = deadline_exceeded + cancelled;
+        return total == 0 ? 0.0 : total_latency_ms /
+                                  static_cast<double>(total);
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -74,9 +319,47 @@ public:
         Builder() = default;
 
         Builder& setMaxLoadedModels(size_t count);
+        Builder& setMaxLoadedBytes(size_t bytes);
+        Builder& setEvictionPolicy(EvictionPolicy policy);
         Builder& setWorkerThreads(size_t count);
         Builder& setEnginesPerModel(size_t count);
+        Builder& enableElasticPools(const ElasticPoolConfig& config = {});
         Builder& enableProfiling(bool enable = true);
+        Builder& setQueueCapacity(size_t capacity);
+
+        /**
+         * @brief Share the workers between tenants by TenantQuota::weight
+         *
+         * Async requests wait in one queue per tenant_id, and the next
+         * request to run is picked by weighted deficit round robin, so a
+         * tenant flooding the server delays its own requests rather than
+         * everyone's. Requests without a tenant share one queue of
+         * weight 1. Synchronous predict() calls are not queued.
+         */
+        Builder& enableFairQueuing(bool enable = true);
+        Builder& setLoadTimeout(size_t ms);
+        Builder& enablePrefetch(const PrefetchConfig& config = {});
+        Builder& setReloadConfig(const ReloadConfig& config);
+        Builder& setTensorPoolConfig(const TensorPoolConfig& config);
+        Builder& enableAdmissionControl(const AdmissionConfig& config = {});
+        Builder& enableBatching(const std::string& model_name,
+                                uint32_t version = 0,
+                                const BatcherConfig& config = {});
+        Builder& enableResultCache(const std::string& model_name,
+                                   const ResultCacheConfig& config = {});
+
+        /**
+         * @brief Run concurrent identical predictions of a model once
+         *
+         * Requests whose input matches one already running on the same
+         * model version wait for that request's output instead of
+         * running inference again (answered with X-Coalesced: true).
+         * Only for deterministic models.
+         */
+        Builder& enableCoalescing(const std::string& model_name);
+
+        /// Route a model to a faster version under load (DegradationPolicy)
+        Builder& enableDegradation(const DegradationPolicy& policy);
 
         ModelServer build();
 
@@ -118,31 +401,149 @@ public:
     // ---- Traffic Splitting ----
 
     void set_traffic_rules(const std::string& model_name,
-                           const std::vector<TrafficRule>& rules);
+                           const std::vector<TrafficRule>& rules,
+                           StickyRouting sticky = StickyRouting::NONE);
 
     // ---- Inference ----
 
     Response predict(const std::string& model_name,
                      const Tensor& input,
                      const std::string& tenant_id = "",
-                     const std::string& request_id = "");
-
+                     const std::string& request_id = "",
+                     const ExecutionLimits& limits = {});
+
+    /**
+     * @brief Queue a prediction on the server's executor
+     *
+     * `input` is copied once, into a buffer of tensor_pool(). Keep a copy
+     * of `limits.cancellation` to abandon the request later: once
+     * cancelled it is skipped if still queued, or stops at the next layer
+     * boundary, and its future holds a 499 response.
+     *
+     * `limits.priority` picks the executor lane (and the batcher lane of a
+     * batched model): a LATENCY_CRITICAL request overtakes queued NORMAL
+     * and BACKGROUND ones, so an offline burst submitted as BACKGROUND
+     * does not delay interactive traffic. With fair queuing the tenant
+     * order is decided first.
+     */
     std::future<Response> predict_async(const std::string& model_name,
                                         const Tensor& input,
                                         const std::string& tenant_id = "",
-                                        const std::string& request_id = "");
+                                        const std::string& request_id = "",
+                                        const ExecutionLimits& limits = {});
+
+    /**
+     * @brief predict_async() that takes ownership of `input`
+     *
+     * The tensor is moved through the executor queue and never copied;
+     * the response body is drawn from tensor_pool() as well. Build large
+     * inputs with tensor_pool()->acquire() to keep their memory recycled.
+     */
+    std::future<Response> predict_async(const std::string& model_name,
+                                        Tensor&& input,
+                                        const std::string& tenant_id = "",
+                                        const std::string& request_id = "",
+                                        const ExecutionLimits& limits = {});
 
     Response handle_request(const Request& request);
+
+    /// Copies the request body once (into tensor_pool()), not its headers
     std::future<Response> handle_request_async(const Request& request);
 
+    /// Moves the request, body included, through the executor: no copies
+    std::future<Response> handle_request_async(Request&& request);
+
+    /**
+     * @brief Run a request on the server's executor and hand the response
+     *        to a callback instead of a future
+     *
+     * For event-loop front-ends that must never block. The request is
+     * moved in, so a body that views a pooled buffer is not copied.
+     * `on_done` runs on a worker thread, or inline with a 503 if the
+     * executor queue is full or admission control (AdmissionConfig)
+     * refuses the request; it must not throw.
+     */
+    void handle_request_async(Request request,
+                              std::function<void(Response)> on_done);
+
     // ---- Hot Reload ----
 
+    /**
+     * @brief Replace a model version's file without downtime
+     *
+     * The new engines are loaded and warmed up (ReloadConfig) in the
+     * background while the current pool keeps serving. Traffic then moves
+     * over ReloadConfig::ramp_ms, and the old pool is released once its
+     * in-flight requests finish. The registry path changes only after the
+     * new file loaded successfully.
+     * @return Future that is ready when the new pool starts taking traffic
+     *         (or holds the load error)
+     * @throws ServerException if the model/version is not registered
+     */
+    std::shared_future<void> reload_model_async(
+        const std::string& name, uint32_t version,
+        const std::string& new_file_path);
+
+    /// Blocking reload_model_async(); rethrows load errors
     void reload_model(const std::string& name, uint32_t version,
                       const std::string& new_file_path);
 
+    // ---- Preloading ----
+
+    /**
+     * @brief Load a model version into the cache in the background
+     *
+     * Joins a load already in flight for the same version. version 0 picks
+     * the highest registered version.
+     * @return Future that becomes ready once the model is cached (or holds
+     *         the load error)
+     * @throws ServerException if the model/version is not registered
+     */
+    std::shared_future<void> preload(const std::string& name,
+                                     uint32_t version = 0);
+
+    /**
+     * @brief Run one prefetch round now
+     *
+     * Closes the open access bucket, then loads the models the prefetcher
+     * forecasts for the next one (the background thread does this every
+     * PrefetchConfig::bucket_interval). No-op unless prefetching is enabled.
+     * @return Number of models loaded by this round
+     */
+    size_t prefetch_now();
+
     // ---- Stats ----
 
     size_t loaded_model_count() const;
+    size_t loaded_bytes() const;        // estimated memory of loaded pools
+    uint64_t cold_load_count() const;   // cache misses that loaded a model
+    CacheStats cache_stats() const;
+    AdmissionStats admission_stats(const std::string& model_name) const;
+    /// Zeros for a model without a result cache
+    ResultCacheStats result_cache_stats(const std::string& model_name) const;
+    /**
+     * @brief Engine pool size of a loaded model version
+     *
+     * version 0 picks the highest registered version. Zeros if that
+     * version is not loaded.
+     */
+    EnginePoolStats engine_pool_stats(const std::string& model_name,
+                                      uint32_t version = 0) const;
+    /// Zeros for a model without coalescing
+    CoalescingStats coalescing_stats(const std::string& model_name) const;
+    /// Zeros for a model without a degradation policy
+    DegradationStats degradation_stats(const std::string& model_name) const;
+    /**
+     * @brief Zeros (weight 1) for an unknown tenant or without fair queuing
+     *
+     * Counters survive for tenants with a quota; any other tenant is
+     * forgotten once it has nothing queued.
+     */
+    TenantQueueStats tenant_queue_stats(const std::string& tenant_id) const;
+    AbortStats abort_stats() const;
+
+    /// Recycling pool behind request copies and unbatched response bodies
+    std::shared_ptr<TensorPool> tensor_pool() const;
     size_t registered_model_count() const;
 
 private:
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace titaninfer {
+namespace engine {
+
+/// Cache line size assumed for padding shared atomics
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Bounded lock-free multi-producer/multi-consumer ring queue
+ *
+ * Dmitry Vyukov's array-based MPMC queue. Every slot carries a sequence
+ * number that tells producers and consumers whether it is free for the
+ * current lap; a single CAS on the head or tail index claims a slot.
+ * Slots and both indices are padded to a cache line so that producers and
+ * consumers working on neighbouring slots do not false-share.
+ *
+ * The queue never grows: try_push() returns false when it is full, which
+ * callers surface as a rejection (natural backpressure).
+ *
+ * Non-copyable, non-movable.
+ */
+template<typename T>
+class MpmcQueue {
+public:
+    /**
+     * @param capacity Maximum number of elements (rounded up to a power of two, min 2)
+     */
+    explicit MpmcQueue(size_t capacity)
+        : mask_(round_up_pow2(capacity) - 1)
+        , slots_(std::make_unique<Slot[]>(mask_ + 1))
+    {
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos_.value.store(0, std::memory_order_relaxed);
+        dequeue_pos_.value.store(0, std::memory_order_relaxed);
+    }
+
+    ~MpmcQueue() {
+        size_t head = dequeue_pos_.value.load(std::memory_order_relaxed);
+        size_t tail = enqueue_pos_.value.load(std::memory_order_relaxed);
+        for (size_t pos = head; pos != tail; ++pos) {
+            Slot& slot = slots_[pos & mask_];
+            if (slot.sequence.load(std::memory_order_relaxed) == pos + 1) {
+                std::launder(reinterpret_cast<T*>(slot.storage))->~T();
+            }
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Enqueue by move
+     * @return false if the queue is full (value is left untouched)
+     */
+    bool try_push(T&& value) {
+        size_t pos = 0;
+        Slot* slot = claim_for_push(pos);
+        if (!slot) {
+            return false;
+        }
+        ::new (static_cast<void*>(slot->storage)) T(std::move(value));
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue the oldest element
+     * @return std::nullopt if the queue is empty
+     */
+    std::optional<T> try_pop() {
+        size_t pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.value.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    T* item = std::launder(reinterpret_cast<T*>(slot.storage));
+                    std::optional<T> out(std::move(*item));
+                    item->~T();
+                    slot.sequence.store(pos + mask_ + 1,
+                                        std::memory_order_release);
+                    return out;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;  // empty
+            } else {
+                pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+    /// Approximate element count (exact when no operation is in flight)
+    size_t size_approx() const noexcept {
+        size_t tail = enqueue_pos_.value.load(std::memory_order_relaxed);
+        size_t head = dequeue_pos_.value.load(std::memory_order_relaxed);
+        return tail >= head ? tail - head : 0;
+    }
+
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct alignas(CACHE_LINE_SIZE) PaddedIndex {
+        std::atomic<size_t> value{0};
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        if (n < 2) {
+            return 2;
+        }
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    Slot* claim_for_push(size_t& pos) {
+        pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.value.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed)) {
+                    return &slot;
+                }
+            } else if (diff < 0) {
+                return nullptr;  // full
+            } else {
+                pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    PaddedIndex enqueue_pos_;
+    PaddedIndex dequeue_pos_;
+};
+
+/**
+ * @brief Sleep/wake helper for consumers of lock-free queues
+ *
+ * Consumers block only when they find nothing to do; producers pay for a
+ * mutex + notify only when at least one consumer is actually asleep.
+ * The caller-supplied predicate must observe state that producers publish
+ * (with seq_cst or release ordering) *before* calling notify_*().
+ */
+class IdleWaiter {
+public:
+    template<typename Pred>
+    void wait(Pred pred) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        cv_.wait(lock, pred);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// @return pred() at the time of return
+    template<typename Clock, typename Duration, typename Pred>
+    bool wait_until(const std::chrono::time_point<Clock, Duration>& deadline,
+                    Pred pred) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        bool result = cv_.wait_until(lock, deadline, pred);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    void notify_one() {
+        if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    void notify_all() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<size_t> sleepers_{0};
+};
+
+} // namespace engine
+} // namespace titaninfer
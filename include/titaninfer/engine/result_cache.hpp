@@ -0,0 +1,133 @@
+#pragma once
+
+#include "titaninfer/tensor.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace titaninfer {
+namespace engine {
+
+struct ResultCacheConfig {
+    size_t max_bytes = 64u << 20;  ///< Inputs + outputs held, over all shards
+    size_t shards = 16;            ///< Independently locked LRU lists
+};
+
+/**
+ * @brief Counters of one model's ResultCache
+ */
+struct ResultCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t insertions = 0;
+    uint64_t evictions = 0;      ///< Entries pushed out by the byte budget
+    uint64_t invalidations = 0;  ///< Entries dropped by a reload or re-register
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double hit_rate() const noexcept {
+        uint64_t total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) /
+                                  static_cast<double>(total);
+    }
+};
+
+/**
+ * @brief 64-bit hash of `size` bytes
+ *
+ * Four 64-bit lanes consume 32 bytes per step (one AVX2 multiply-add round
+ * when TITANINFER_ENABLE_SIMD is set, the same arithmetic in scalar code
+ * otherwise, so both builds agree), then fold into one avalanche-mixed
+ * value. Not cryptographic.
+ */
+uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0);
+
+/// hash_bytes() of a tensor's data, seeded with its shape
+uint64_t hash_tensor(const Tensor& tensor);
+
+/**
+ * @brief Memoized outputs of one model, keyed by input content
+ *
+ * Entries are keyed by (version, engine pool id, input hash) and keep a
+ * copy of their input, so a hash collision is a miss, never a wrong
+ * answer, and results of a replaced pool are never served for its
+ * successor. Each shard is an LRU list bounded by max_bytes / shards;
+ * an entry larger than that is not cached. Thread-safe.
+ */
+class ResultCache {
+public:
+    explicit ResultCache(const ResultCacheConfig& config);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    /**
+     * @brief Cached output for `input`, or nullptr
+     *
+     * The returned tensor is shared with the cache and must not be
+     * modified; it stays valid after the entry is evicted.
+     */
+    std::shared_ptr<const Tensor> lookup(uint32_t version, uint64_t pool_id,
+                                         uint64_t hash, const Tensor& input);
+
+    /// Store a copy of `input` and `output`, evicting from the shard's tail
+    void insert(uint32_t version, uint64_t pool_id, uint64_t hash,
+                const Tensor& input, const Tensor& output);
+
+    /// Drop every entry of `version`; 0 drops them all
+    void invalidate(uint32_t version = 0);
+
+    ResultCacheStats stats() const;
+
+private:
+    struct Key {
+        uint32_t version;
+        uint64_t pool_id;
+        uint64_t hash;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            return static_cast<size_t>(key.hash ^ (key.pool_id * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    struct Entry {
+        Key key;
+        Tensor input;
+        std::shared_ptr<const Tensor> output;
+        size_t bytes;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;  // most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        size_t bytes = 0;
+    };
+
+    Shard& shard_for(uint64_t hash) {
+        return shards_[(hash >> 40) % shards_.size()];
+    }
+
+    static bool same_input(const Tensor& a, const Tensor& b);
+
+    const size_t shard_budget_;
+    std::vector<Shard> shards_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> insertions_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> invalidations_{0};
+};
+
+} // namespace engine
+} // namespace titaninfer
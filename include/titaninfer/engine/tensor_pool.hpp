@@ -0,0 +1,97 @@
+#pragma once
+
+#include "titaninfer/tensor.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace titaninfer {
+namespace engine {
+
+/**
+ * @brief Counters of a TensorPool
+ */
+struct TensorPoolStats {
+    uint64_t reused = 0;      ///< Acquisitions served from a free list
+    uint64_t allocated = 0;   ///< Acquisitions that had to allocate
+    size_t cached_bytes = 0;  ///< Bytes parked on the free lists
+};
+
+/**
+ * @brief Bounds on what a TensorPool keeps for reuse
+ *
+ * A released buffer goes back to the allocator instead of its free list
+ * when it is larger than max_buffer_bytes, when its class already holds
+ * max_free_per_class buffers, or when keeping it would take the free lists
+ * past max_retained_bytes in total.
+ */
+struct TensorPoolConfig {
+    size_t max_free_per_class = 64;
+    size_t max_buffer_bytes = size_t{16} << 20;     // larger ones are never kept
+    size_t max_retained_bytes = size_t{256} << 20;  // all free lists together
+};
+
+/**
+ * @brief Recycling pool of 64-byte aligned float buffers
+ *
+ * Buffers come in power-of-two size classes. acquire() hands one out as a
+ * Tensor view whose keepalive puts the buffer back on its class's free
+ * list when the last reference goes away, on whichever thread that
+ * happens; moving the tensor (into a Request, through the executor, into
+ * a Response) never copies it. What the free lists keep is bounded by
+ * TensorPoolConfig; the rest goes back to the allocator, as do buffers
+ * released after the pool itself is gone.
+ *
+ * Thread-safe. Always owned by a shared_ptr (see create()).
+ */
+class TensorPool : public std::enable_shared_from_this<TensorPool> {
+public:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t MIN_CLASS = 4;  // 16 floats
+
+    static std::shared_ptr<TensorPool> create(const TensorPoolConfig& config = {});
+
+    ~TensorPool();
+
+    TensorPool(const TensorPool&) = delete;
+    TensorPool& operator=(const TensorPool&) = delete;
+
+    /**
+     * @brief Uninitialized tensor of `shape` over a pooled buffer
+     * @throws std::invalid_argument if shape is empty or contains zeros
+     */
+    Tensor acquire(const std::vector<size_t>& shape);
+
+    /// Pooled copy of `source` (one memcpy, no allocation once warm)
+    Tensor copy_of(const Tensor& source);
+
+    /**
+     * @brief Raw buffer of at least `count` floats
+     *
+     * For callers that fill a buffer before they know its final shape;
+     * build the Tensor view over it with the returned handle as keepalive.
+     */
+    std::shared_ptr<float> acquire_buffer(size_t count);
+
+    TensorPoolStats stats() const;
+
+private:
+    explicit TensorPool(const TensorPoolConfig& config);
+
+    void recycle(float* buffer, size_t size_class);
+
+    const TensorPoolConfig config_;
+    mutable std::mutex mutex_;
+    std::array<std::vector<float*>, 64> free_;
+    size_t retained_bytes_ = 0;  // on the free lists, guarded by mutex_
+    std::atomic<uint64_t> reused_{0};
+    std::atomic<uint64_t> allocated_{0};
+};
+
+} // namespace engine
+} // namespace titaninfer
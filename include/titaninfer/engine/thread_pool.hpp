@@ -1,30 +1,71 @@
 #pragma once
 
-#include <condition_variable>
+#include "titaninfer/engine/mpmc_queue.hpp"
+#include "titaninfer/exceptions.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
-#include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace titaninfer {
 namespace engine {
 
+/**
+ * @brief Scheduling class of a submitted task (lower value = served first)
+ */
+enum class TaskPriority : uint8_t {
+    LATENCY_CRITICAL = 0,  ///< Interactive requests
+    NORMAL           = 1,  ///< Default lane
+    BACKGROUND       = 2,  ///< Offline / batch work
+};
+
+/**
+ * @brief Per-task scheduling options
+ */
+struct TaskOptions {
+    TaskPriority priority = TaskPriority::NORMAL;
+
+    /// Tasks still queued at this point are cancelled without running.
+    /// time_point::max() disables the deadline.
+    std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::time_point::max();
+};
+
 /**
  * @brief Fixed-size thread pool for parallel task execution
  *
- * Uses a task queue with mutex + condition variable synchronization.
- * Non-copyable, non-movable (owns threads and mutex).
+ * Tasks are queued in one bounded lock-free MpmcQueue lane per
+ * TaskPriority; workers only touch a mutex to sleep when every lane is
+ * empty. A full lane rejects the task instead of growing. Workers serve
+ * the most urgent non-empty lane, except that a lower lane which has been
+ * bypassed STARVATION_LIMIT times in a row is served next, so background
+ * work keeps making progress under a sustained interactive load.
+ *
+ * A task whose deadline has passed when it is dequeued is never executed;
+ * its future throws InferenceException(DEADLINE_EXCEEDED).
+ *
+ * Non-copyable, non-movable (owns threads and queues).
  */
 class ThreadPool {
 public:
+    static constexpr size_t NUM_LANES = 3;
+    static constexpr size_t STARVATION_LIMIT = 8;
+    static constexpr size_t DEFAULT_QUEUE_CAPACITY = 16384;
+
     /**
      * @brief Construct thread pool
      * @param num_threads Number of worker threads (0 = hardware_concurrency, min 1)
+     * @param queue_capacity Max queued tasks per priority lane (rounded up to a power of two)
      */
-    explicit ThreadPool(size_t num_threads = 0);
+    explicit ThreadPool(size_t num_threads = 0,
+                        size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
 
     ~ThreadPool();
 
@@ -32,41 +73,96 @@ public:
     ThreadPool& operator=(const ThreadPool&) = delete;
 
     /**
-     * @brief Submit a callable for async execution
+     * @brief Submit a callable for async execution in the NORMAL lane
      * @return std::future for the result
      */
     template<typename F, typename... Args>
     auto submit(F&& f, Args&&... args)
         -> std::future<typename std::invoke_result<F, Args...>::type>
+    {
+        return submit(TaskOptions{}, std::forward<F>(f),
+                      std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Submit a callable with an explicit priority and deadline
+     * @return std::future for the result
+     * @throws TitanInferException(QUEUE_FULL) if the lane is full
+     */
+    template<typename F, typename... Args>
+    auto submit(const TaskOptions& options, F&& f, Args&&... args)
+        -> std::future<typename std::invoke_result<F, Args...>::type>
+    {
+        auto result = try_submit(options, std::forward<F>(f),
+                                 std::forward<Args>(args)...);
+        if (!result) {
+            throw TitanInferException("ThreadPool: queue full",
+                                      ErrorCode::QUEUE_FULL);
+        }
+        return std::move(*result);
+    }
+
+    /**
+     * @brief Submit without throwing on backpressure
+     * @return std::nullopt if the lane is full, otherwise the task's future
+     */
+    template<typename F, typename... Args>
+    auto try_submit(const TaskOptions& options, F&& f, Args&&... args)
+        -> std::optional<std::future<typename std::invoke_result<F, Args...>::type>>
     {
         using R = typename std::invoke_result<F, Args...>::type;
 
-        auto task = std::make_shared<std::packaged_task<R()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
+        auto task = std::make_shared<std::packaged_task<R(bool)>>(
+            [fn = std::bind(std::forward<F>(f), std::forward<Args>(args)...)]
+            (bool cancelled) mutable -> R {
+                if (cancelled) {
+                    throw InferenceException(
+                        "ThreadPool: task deadline exceeded before execution",
+                        ErrorCode::DEADLINE_EXCEEDED);
+                }
+                return fn();
+            });
 
         std::future<R> result = task->get_future();
-
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (stop_) {
-                throw std::runtime_error("ThreadPool: submit on stopped pool");
-            }
-            tasks_.emplace([task]() { (*task)(); });
+        if (!enqueue(Task{[task](bool cancelled) { (*task)(cancelled); },
+                          options.deadline},
+                     options.priority)) {
+            return std::nullopt;
         }
-        condition_.notify_one();
-
         return result;
     }
 
     size_t thread_count() const noexcept { return workers_.size(); }
 
+    /// Tasks queued but not yet picked up by a worker (approximate)
+    size_t pending() const noexcept {
+        auto n = pending_.load(std::memory_order_relaxed);
+        return n > 0 ? static_cast<size_t>(n) : 0;
+    }
+
+    /// Number of tasks dropped because their deadline expired in the queue
+    uint64_t cancelled_count() const noexcept {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
 private:
+    struct Task {
+        std::function<void(bool)> run;  // run(true) cancels
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    // Returns false if the lane is full
+    bool enqueue(Task task, TaskPriority priority);
+    std::optional<Task> try_dequeue();
+    void worker_loop();
+
     std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    std::mutex mutex_;
-    std::condition_variable condition_;
-    bool stop_;
+    std::array<std::unique_ptr<MpmcQueue<Task>>, NUM_LANES> lanes_;
+    std::array<std::atomic<size_t>, NUM_LANES> bypassed_{};
+    std::atomic<int64_t> pending_{0};
+    std::atomic<bool> stop_{false};
+    IdleWaiter idle_;
+    std::atomic<uint64_t> cancelled_{0};
 };
 
 } // namespace engine
@@ -21,6 +21,8 @@ enum class ErrorCode : int {
     NO_MODEL_LOADED   = 200,
     SHAPE_MISMATCH    = 201,
     NAN_INPUT         = 202,
+    DEADLINE_EXCEEDED = 203,
+    CANCELLED         = 204,
 
     // Internal errors (300-399)
     INTERNAL_ERROR    = 300,
@@ -31,6 +33,8 @@ enum class ErrorCode : int {
     QUOTA_EXCEEDED    = 402,
     INVALID_REQUEST   = 403,
     SERVER_STOPPED    = 404,
+    QUEUE_FULL        = 405,
+    MODEL_LOADING     = 406,
 };
 
 /**
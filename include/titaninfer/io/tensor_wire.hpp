@@ -0,0 +1,97 @@
+#pragma once
+
+#include "titaninfer/tensor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace titaninfer {
+namespace io {
+
+/// Magic number of a tensor wire frame: "TNSR"
+static constexpr char TENSOR_WIRE_MAGIC[4] = {'T', 'N', 'S', 'R'};
+
+/// Current wire format version
+static constexpr uint8_t TENSOR_WIRE_VERSION = 1;
+
+/// Payload offset granularity within a frame
+static constexpr size_t TENSOR_WIRE_ALIGNMENT = 64;
+
+static constexpr size_t TENSOR_WIRE_MAX_DIMS = 8;
+
+/// MIME type of a request/response body holding one frame
+static constexpr const char* TENSOR_WIRE_CONTENT_TYPE =
+    "application/x-titan-tensor";
+
+/// Element type identifiers of the wire format
+enum class WireDType : uint8_t {
+    FLOAT32 = 1
+};
+
+/**
+ * @brief Length-prefixed binary encoding of one Tensor
+ *
+ * Frame layout (integers little-endian):
+ *
+ *     0  char[4]  magic "TNSR"
+ *     4  uint8    version
+ *     5  uint8    dtype (WireDType)
+ *     6  uint8    ndim, 1..TENSOR_WIRE_MAX_DIMS
+ *     7  uint8    reserved, 0
+ *     8  uint32   header_bytes: payload offset, a multiple of 64
+ *    12  uint32   reserved, 0
+ *    16  uint64   payload_bytes
+ *    24  uint64   dims[ndim]
+ *        zero padding up to header_bytes
+ *    header_bytes: payload, product(dims) little-endian float32 values
+ *
+ * The first 24 bytes give the whole frame length (header_bytes +
+ * payload_bytes), so frames can be split off a byte stream. When the
+ * frame itself starts 64-byte aligned, so does the payload.
+ */
+class TensorWire {
+public:
+    static constexpr size_t FIXED_HEADER_BYTES = 24;
+
+    /// header_bytes of a frame with `ndim` dimensions
+    static size_t header_size(size_t ndim);
+
+    /**
+     * @brief Encode the frame header of `tensor`
+     *
+     * The payload is tensor.data() itself (little-endian hosts), so a
+     * writer can send header and payload as two buffers without copying.
+     * @throws ValidationException if the tensor has more than
+     *         TENSOR_WIRE_MAX_DIMS dimensions
+     */
+    static std::string encode_header(const Tensor& tensor);
+
+    /// Header followed by a copy of the payload, as one buffer
+    static std::string encode(const Tensor& tensor);
+
+    /**
+     * @brief Total length of the frame starting at `data`
+     * @return 0 if fewer than FIXED_HEADER_BYTES are available
+     * @throws ValidationException(INVALID_FORMAT) on a bad magic/version
+     */
+    static size_t frame_size(const char* data, size_t size);
+
+    /**
+     * @brief Decode one frame
+     *
+     * Returns a view over the payload in `data` (no copy) when the payload
+     * is float-aligned and the host is little-endian; `keepalive` is then
+     * attached to the view to keep the buffer alive. Otherwise the values
+     * are copied into an owning tensor.
+     * @param size Bytes available; must be exactly one frame
+     * @throws ValidationException(INVALID_FORMAT) on a malformed or
+     *         truncated frame
+     */
+    static Tensor decode(const char* data, size_t size,
+                         std::shared_ptr<void> keepalive = nullptr);
+};
+
+} // namespace io
+} // namespace titaninfer
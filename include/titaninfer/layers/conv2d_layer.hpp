@@ -28,6 +28,8 @@ public:
                 bool use_bias = true);
 
     std::unique_ptr<Layer> clone() const override;
+    std::unique_ptr<Layer> clone_shared(
+        const std::shared_ptr<void>& owner) const override;
     void forward(const Tensor& input, Tensor& output) override;
     std::string name() const override;
     size_t parameter_count() const override;
@@ -49,6 +51,9 @@ public:
     bool has_bias() const { return use_bias_; }
 
 private:
+    // clone_shared(): same configuration, parameters aliased
+    Conv2DLayer(const Conv2DLayer& source, const std::shared_ptr<void>& owner);
+
     void forward_single(const float* input_data, size_t H, size_t W,
                         float* output_data, size_t out_H, size_t out_W);
 
@@ -28,6 +28,8 @@ public:
     DenseLayer(size_t in_features, size_t out_features, bool use_bias = true);
 
     std::unique_ptr<Layer> clone() const override;
+    std::unique_ptr<Layer> clone_shared(
+        const std::shared_ptr<void>& owner) const override;
     void forward(const Tensor& input, Tensor& output) override;
     std::string name() const override;
     size_t parameter_count() const override;
@@ -55,12 +57,19 @@ public:
     bool has_bias() const { return use_bias_; }
 
 private:
+    // clone_shared(): same configuration, parameters aliased
+    DenseLayer(const DenseLayer& source, const std::shared_ptr<void>& owner);
+
     size_t in_features_;
     size_t out_features_;
     bool use_bias_;
 
     Tensor weights_;  // Shape: (out_features_, in_features_)
     Tensor bias_;     // Shape: (out_features_,)
+
+    // W^T for batched input, built on the first batch after set_weights()
+    Tensor weights_t_;  // Shape: (in_features_, out_features_)
+    bool weights_t_stale_ = true;
 };
 
 } // namespace layers
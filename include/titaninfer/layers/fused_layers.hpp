@@ -30,6 +30,7 @@ private:
     size_t in_features_, out_features_;
     bool use_bias_;
     Tensor weights_, bias_;
+    Tensor weights_t_{std::vector<size_t>{1}};  // W^T, built on the first batch
 };
 
 /**
@@ -53,6 +54,7 @@ private:
     size_t in_features_, out_features_;
     bool use_bias_;
     Tensor weights_, bias_;
+    Tensor weights_t_{std::vector<size_t>{1}};  // W^T, built on the first batch
 };
 
 } // namespace layers
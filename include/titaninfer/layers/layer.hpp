@@ -23,6 +23,21 @@ public:
      */
     virtual std::unique_ptr<Layer> clone() const = 0;
 
+    /**
+     * @brief Copy of this layer whose parameters alias this layer's
+     *
+     * For engines that run one model side by side: the copy has its own
+     * scratch state but views this layer's weight tensors, so no weights
+     * are duplicated. `owner` must keep this layer alive; every aliasing
+     * tensor holds it. Layers without parameters (or without aliasing
+     * support) return clone().
+     */
+    virtual std::unique_ptr<Layer> clone_shared(
+        const std::shared_ptr<void>& owner) const {
+        (void)owner;
+        return clone();
+    }
+
     /**
      * @brief Run forward pass
      *
@@ -51,6 +66,15 @@ public:
         const std::vector<size_t>& input_shape) const {
         return input_shape;
     }
+
+protected:
+    /// Read-only view of `source` kept alive by `owner` (for clone_shared)
+    static Tensor alias(const Tensor& source,
+                        const std::shared_ptr<void>& owner) {
+        // Forward passes never write through parameter tensors
+        return Tensor::view(const_cast<float*>(source.data()),
+                            source.shape(), owner);
+    }
 };
 
 } // namespace layers
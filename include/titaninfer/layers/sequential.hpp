@@ -50,6 +50,13 @@ public:
     Layer& layer(size_t index);
     const Layer& layer(size_t index) const;
 
+    /**
+     * @brief Copy of the model whose layers alias this model's parameters
+     * @param owner Handle that keeps this model alive (see Layer::clone_shared)
+     */
+    std::unique_ptr<Sequential> clone_shared(
+        const std::shared_ptr<void>& owner) const;
+
     /** @brief Total parameter count across all layers */
     size_t total_parameters() const;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 #include <string>
@@ -13,6 +14,10 @@ namespace titaninfer {
  * 
  * Provides RAII-managed, 32-byte aligned memory allocation suitable for AVX2.
  * Supports dynamic N-dimensional shapes with zero-copy move semantics.
+ *
+ * A tensor created with view() does not own its data: it aliases memory
+ * managed elsewhere and, optionally, holds a keepalive handle on the owner.
+ * Copying a view produces an owning deep copy.
  */
 class Tensor {
 public:
@@ -32,6 +37,17 @@ public:
      * @param shape Dimensions (e.g., {2, 3, 4})
      */
     explicit Tensor(std::initializer_list<size_t> shape);
+
+    /**
+     * @brief Create a non-owning view over existing memory (no allocation, no copy)
+     * @param data Pointer to at least product(shape) floats
+     * @param shape View dimensions
+     * @param keepalive Optional handle released when the view is destroyed;
+     *                  use it to keep the owning buffer alive or to recycle it
+     * @throws std::invalid_argument if shape is empty or contains zeros
+     */
+    static Tensor view(float* data, const std::vector<size_t>& shape,
+                       std::shared_ptr<void> keepalive = nullptr);
     
     /**
      * @brief Copy constructor (deep copy)
@@ -110,6 +126,11 @@ public:
      * @brief Check if tensor is empty
      */
     bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief True if the tensor aliases memory it does not own
+     */
+    bool is_view() const noexcept { return !owns_data_; }
     
     // ========================================
     // Memory Operations
@@ -126,6 +147,11 @@ public:
     void zero();
     
 private:
+    /**
+     * @brief Empty tensor (used by view())
+     */
+    Tensor() noexcept : data_(nullptr), size_(0) {}
+
     // ========================================
     // Memory Management
     // ========================================
@@ -150,6 +176,11 @@ private:
      * @brief Validate shape vector
      */
     static void validate_shape(const std::vector<size_t>& shape);
+
+    /**
+     * @brief Release owned memory (no-op for views) and drop the keepalive
+     */
+    void release() noexcept;
     
     // ========================================
     // Member Variables
@@ -158,6 +189,8 @@ private:
     float* data_;                    // 32-byte aligned data pointer
     std::vector<size_t> shape_;      // Tensor dimensions
     size_t size_;                    // Total number of elements
+    bool owns_data_ = true;          // false for view()
+    std::shared_ptr<void> keepalive_; // owner handle held by views
     
     static constexpr size_t ALIGNMENT = 32;  // AVX2 alignment requirement
 };
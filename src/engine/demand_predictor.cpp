@@ -0,0 +1,77 @@
+#include "titaninfer/engine/demand_predictor.hpp"
+
+#include <algorithm>
+
+namespace titaninfer {
+namespace engine {
+
+DemandPredictor::DemandPredictor(const PrefetchConfig& config)
+    : config_(config)
+{
+    config_.alpha = std::clamp(config_.alpha, 0.0, 1.0);
+    config_.seasonal_alpha = std::clamp(config_.seasonal_alpha, 0.0, 1.0);
+}
+
+void DemandPredictor::record(const ModelKey& key, uint64_t count) {
+    auto [it, inserted] = series_.try_emplace(key);
+    if (inserted && config_.season_buckets > 0) {
+        it->second.seasonal.assign(config_.season_buckets, 0.0);
+        it->second.seasonal_seen.assign(config_.season_buckets, false);
+    }
+    it->second.count += static_cast<double>(count);
+}
+
+void DemandPredictor::advance() {
+    const size_t phase = config_.season_buckets > 0
+        ? static_cast<size_t>(bucket_ % config_.season_buckets) : 0;
+
+    for (auto& [key, series] : series_) {
+        series.level = config_.alpha * series.count +
+                       (1.0 - config_.alpha) * series.level;
+        if (config_.season_buckets > 0) {
+            double& value = series.seasonal[phase];
+            if (series.seasonal_seen[phase]) {
+                value = config_.seasonal_alpha * series.count +
+                        (1.0 - config_.seasonal_alpha) * value;
+            } else {
+                value = series.count;
+                series.seasonal_seen[phase] = true;
+            }
+        }
+        series.count = 0.0;
+    }
+    ++bucket_;
+}
+
+double DemandPredictor::forecast(const Series& series) const {
+    double prediction = series.level;
+    if (config_.season_buckets > 0) {
+        const size_t phase = static_cast<size_t>(bucket_ % config_.season_buckets);
+        if (series.seasonal_seen[phase]) {
+            prediction = std::max(prediction, series.seasonal[phase]);
+        }
+    }
+    return prediction;
+}
+
+double DemandPredictor::forecast(const ModelKey& key) const {
+    auto it = series_.find(key);
+    return it == series_.end() ? 0.0 : forecast(it->second);
+}
+
+std::vector<std::pair<ModelKey, double>> DemandPredictor::ranked() const {
+    std::vector<std::pair<ModelKey, double>> result;
+    result.reserve(series_.size());
+    for (const auto& [key, series] : series_) {
+        result.emplace_back(key, forecast(series));
+    }
+    std::sort(result.begin(), result.end(),
+              [](const auto& a, const auto& b) {
+                  if (a.second != b.second) return a.second > b.second;
+                  return a.first < b.first;
+              });
+    return result;
+}
+
+} // namespace engine
+} // namespace titaninfer
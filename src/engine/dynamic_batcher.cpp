@@ -1,137 +1,962 @@
 #include "titaninfer/engine/dynamic_batcher.hpp"
+#include "titaninfer/exceptions.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 namespace titaninfer {
 namespace engine {
 
-DynamicBatcher::DynamicBatcher(layers::Sequential& model,
+namespace {
+
+constexpr double EXEC_EWMA_ALPHA = 0.2;
+constexpr double RATE_TAU_MS = 100.0;  // arrival-rate smoothing horizon
+constexpr double SLACK_SHRINK = 0.8;
+constexpr double SLACK_GROW = 1.05;
+constexpr double MIN_SLACK = 0.1;
+constexpr double SLACK_RECOVER_RATIO = 0.7;  // grow slack when p99 < 70% target
+constexpr size_t MIN_P99_SAMPLES = 16;
+constexpr double CAPACITY_HEADROOM = 1.25;   // throughput margin over arrivals
+
+double percentile_99(std::vector<double> samples) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    size_t idx = static_cast<size_t>(0.99 * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(idx),
+                     samples.end());
+    return samples[idx];
+}
+
+} // anonymous namespace
+
+// ============================================================
+// AdaptiveBatchPolicy
+// ============================================================
+
+AdaptiveBatchPolicy::AdaptiveBatchPolicy(const BatcherConfig& config)
+    : config_(config)
+    , exec_ewma_(std::max<size_t>(1, config.max_batch_size), 0.0)
+{
+    latencies_.reserve(LATENCY_WINDOW);
+    state_.batch_size = std::max<size_t>(1, config.max_batch_size);
+    state_.wait_ms = static_cast<double>(config.max_wait_ms);
+    state_.target_p99_ms = config.target_p99_ms;
+    state_.latency_budget_ms = config.target_p99_ms;
+}
+
+void AdaptiveBatchPolicy::record_batch(size_t batch_size, double exec_ms) {
+    if (batch_size == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    double& e = exec_ewma_[std::min(batch_size, exec_ewma_.size()) - 1];
+    e = (e == 0.0) ? exec_ms : e + EXEC_EWMA_ALPHA * (exec_ms - e);
+    state_.batches_observed++;
+}
+
+void AdaptiveBatchPolicy::record_latency(double latency_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_.size() < LATENCY_WINDOW) {
+        latencies_.push_back(latency_ms);
+    } else {
+        latencies_[latency_next_] = latency_ms;
+    }
+    latency_next_ = (latency_next_ + 1) % LATENCY_WINDOW;
+}
+
+double AdaptiveBatchPolicy::predicted_exec_ms(size_t batch_size) const {
+    if (exec_ewma_[batch_size - 1] > 0.0) {
+        return exec_ewma_[batch_size - 1];
+    }
+
+    // Least-squares line through the observed (size, exec) points
+    double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    double min_exec = std::numeric_limits<double>::max();
+    size_t last_size = 0;
+    for (size_t i = 0; i < exec_ewma_.size(); ++i) {
+        if (exec_ewma_[i] <= 0.0) {
+            continue;
+        }
+        double x = static_cast<double>(i + 1);
+        double y = exec_ewma_[i];
+        n += 1.0;
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+        min_exec = std::min(min_exec, y);
+        last_size = i + 1;
+    }
+    if (n == 0.0) {
+        return 0.0;
+    }
+
+    double b = static_cast<double>(batch_size);
+    if (n == 1.0) {
+        // Single observation: assume no batching gains (cost scales linearly)
+        return exec_ewma_[last_size - 1] * b / static_cast<double>(last_size);
+    }
+    double slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    double intercept = (sy - slope * sx) / n;
+    return std::max(intercept + slope * b, min_exec);
+}
+
+AdaptiveBatchPolicy::Decision
+AdaptiveBatchPolicy::decide(std::chrono::steady_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Arrival rate: exponentially smoothed over ~RATE_TAU_MS
+    uint64_t total = arrivals_.load(std::memory_order_relaxed);
+    if (!rate_initialized_) {
+        rate_initialized_ = true;
+    } else {
+        double dt_ms = std::chrono::duration<double, std::milli>(
+            now - last_decide_).count();
+        if (dt_ms > 0.0) {
+            double instant = static_cast<double>(total - last_arrivals_) / dt_ms;
+            double w = 1.0 - std::exp(-dt_ms / RATE_TAU_MS);
+            state_.arrival_rate_per_ms += w * (instant - state_.arrival_rate_per_ms);
+        }
+    }
+    last_decide_ = now;
+    last_arrivals_ = total;
+
+    // Feedback: tighten the budget while the observed tail misses the SLO
+    const double target = config_.target_p99_ms;
+    if (latencies_.size() >= MIN_P99_SAMPLES) {
+        state_.observed_p99_ms = percentile_99(latencies_);
+        if (state_.observed_p99_ms > target) {
+            slack_ = std::max(MIN_SLACK, slack_ * SLACK_SHRINK);
+        } else if (state_.observed_p99_ms < SLACK_RECOVER_RATIO * target) {
+            slack_ = std::min(1.0, slack_ * SLACK_GROW);
+        }
+    }
+    const double budget = target * slack_;
+    state_.latency_budget_ms = budget;
+
+    const size_t max_batch = exec_ewma_.size();
+    if (state_.batches_observed == 0) {
+        // No cost model yet: take whatever is queued without waiting
+        state_.batch_size = max_batch;
+        state_.wait_ms = 0.0;
+        return {max_batch, std::chrono::microseconds(0)};
+    }
+
+    const double rate = state_.arrival_rate_per_ms;
+    const double max_wait_ms = static_cast<double>(config_.max_wait_ms);
+    const double workers = static_cast<double>(std::max<size_t>(1, config_.num_workers));
+    size_t best_size = 1;
+    double best_wait = 0.0;
+    double best_throughput = -1.0;
+
+    for (size_t b = 1; b <= max_batch; ++b) {
+        double fill_ms = 0.0;
+        if (b > 1) {
+            fill_ms = rate > 0.0 ? static_cast<double>(b - 1) / rate
+                                 : std::numeric_limits<double>::infinity();
+        }
+        if (fill_ms > max_wait_ms) {
+            break;  // fill time only grows with b
+        }
+        double exec_ms = predicted_exec_ms(b);
+        if (fill_ms + exec_ms > budget) {
+            continue;
+        }
+        double throughput = exec_ms > 0.0
+            ? workers * static_cast<double>(b) / exec_ms
+            : std::numeric_limits<double>::max();
+        if (throughput > best_throughput) {
+            best_throughput = throughput;
+            best_size = b;
+            best_wait = fill_ms;
+        }
+        if (throughput >= rate * CAPACITY_HEADROOM) {
+            break;  // smallest batch that keeps up: larger ones only add wait
+        }
+    }
+
+    state_.batch_size = best_size;
+    state_.wait_ms = best_wait;
+    return {best_size, std::chrono::microseconds(
+        static_cast<int64_t>(std::llround(best_wait * 1000.0)))};
+}
+
+BatchPolicyState AdaptiveBatchPolicy::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BatchPolicyState snapshot = state_;
+    snapshot.observed_p99_ms = percentile_99(latencies_);
+    snapshot.exec_ms_by_size = exec_ewma_;
+    return snapshot;
+}
+
+// ============================================================
+// DynamicBatcher
+// ============================================================
+
+namespace {
+
+constexpr uint32_t SEALED = 1u << 30;  // reservation count of a closed arena
+
+size_t element_count(const std::vector<size_t>& shape) {
+    size_t n = 1;
+    for (auto d : shape) {
+        n *= d;
+    }
+    return n;
+}
+
+std::vector<size_t> row_major_strides(const std::vector<size_t>& shape) {
+    std::vector<size_t> strides(shape.size(), 1);
+    for (size_t i = shape.size(); i-- > 1;) {
+        strides[i - 1] = strides[i] * shape[i];
+    }
+    return strides;
+}
+
+/// Copy the leading-corner `region` of src (src_shape) into dst (dst_shape)
+void copy_region(const float* src, const std::vector<size_t>& src_shape,
+                 float* dst, const std::vector<size_t>& dst_shape,
+                 const std::vector<size_t>& region) {
+    const size_t rank = region.size();
+    const auto src_strides = row_major_strides(src_shape);
+    const auto dst_strides = row_major_strides(dst_shape);
+    const size_t run = region[rank - 1];  // contiguous innermost run
+    std::vector<size_t> index(rank, 0);
+    for (;;) {
+        size_t src_off = 0;
+        size_t dst_off = 0;
+        for (size_t d = 0; d + 1 < rank; ++d) {
+            src_off += index[d] * src_strides[d];
+            dst_off += index[d] * dst_strides[d];
+        }
+        std::memcpy(dst + dst_off, src + src_off, run * sizeof(float));
+
+        size_t d = rank - 1;
+        while (d-- > 0) {
+            if (++index[d] < region[d]) {
+                break;
+            }
+            index[d] = 0;
+        }
+        if (d == static_cast<size_t>(-1)) {
+            return;
+        }
+    }
+}
+
+/// Zero every element of data (shape) outside its leading-corner `region`
+void mask_outside(float* data, const std::vector<size_t>& shape,
+                  const std::vector<size_t>& region) {
+    const size_t total = element_count(shape);
+    const auto strides = row_major_strides(shape);
+    for (size_t flat = 0; flat < total; ++flat) {
+        for (size_t d = 0; d < shape.size(); ++d) {
+            if ((flat / strides[d]) % shape[d] >= region[d]) {
+                data[flat] = 0.0f;
+                break;
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+struct DynamicBatcher::Arena {
+    struct Row {
+        std::promise<Tensor> promise;
+        std::chrono::steady_clock::time_point enqueued;
+        std::chrono::steady_clock::time_point deadline;
+        std::vector<size_t> shape;  // real sample shape (<= bucket shape)
+        bool padded = false;
+        bool live = false;  // false if the slot was dropped unsubmitted
+    };
+
+    Arena(Bucket* owner, const std::vector<size_t>& staging_shape, size_t rows)
+        : bucket(owner), staging(staging_shape), rows(rows) {}
+
+    Bucket* bucket;
+    Tensor staging;                         // {max_batch_size, bucket shape...}
+    std::vector<Row> rows;
+    std::atomic<uint32_t> reserved{SEALED};
+    std::atomic<uint32_t> committed{0};
+    std::atomic<int64_t> first_commit{0};   // steady_clock ticks; starts the timer
+    uint32_t size = 0;                      // rows in the batch once sealed
+    size_t lane = 0;                        // TaskPriority of its requests
+};
+
+/// Free list of batch output buffers shared with outstanding result views
+struct DynamicBatcher::OutputPool {
+    OutputPool(const std::vector<size_t>& buffer_shape, size_t capacity)
+        : shape(buffer_shape), free(capacity) {}
+
+    ~OutputPool() {
+        while (auto buffer = free.try_pop()) {
+            delete *buffer;
+        }
+    }
+
+    static std::shared_ptr<Tensor> acquire(const std::shared_ptr<OutputPool>& pool) {
+        Tensor* buffer = nullptr;
+        if (auto recycled = pool->free.try_pop()) {
+            buffer = *recycled;
+        } else {
+            buffer = new Tensor(pool->shape);
+        }
+        // The last result view of the batch hands the buffer back
+        return std::shared_ptr<Tensor>(buffer, [pool](Tensor* t) {
+            if (!pool->free.try_push(std::move(t))) {
+                delete t;
+            }
+        });
+    }
+
+    std::vector<size_t> shape;  // {max_batch_size, output_shape...}
+    MpmcQueue<Tensor*> free;
+};
+
+/// One padded sample shape with everything needed to batch it
+struct DynamicBatcher::Bucket {
+    Bucket(const std::vector<size_t>& sample_shape, const BatcherConfig& config,
+           size_t num_arenas)
+        : shape(sample_shape)
+        , sample_size(element_count(sample_shape))
+        , policy(config)
+        , free(num_arenas) {}
+
+    std::vector<size_t> shape;
+    size_t sample_size;
+    AdaptiveBatchPolicy policy;
+    std::vector<CompiledModel> plans;    // one per worker
+    std::vector<size_t> output_shape;    // single-sample output
+    std::shared_ptr<OutputPool> outputs;
+    std::vector<std::unique_ptr<Arena>> arenas;
+    MpmcQueue<Arena*> free;
+    std::array<std::atomic<Arena*>, ThreadPool::NUM_LANES> open{};  // per lane
+};
+
+DynamicBatcher::InputSlot::InputSlot(DynamicBatcher* owner, Arena* arena,
+                                     uint32_t row, Tensor view)
+    : owner_(owner), arena_(arena), row_(row), view_(std::move(view)) {}
+
+DynamicBatcher::InputSlot::InputSlot(InputSlot&& other) noexcept
+    : owner_(other.owner_)
+    , arena_(std::exchange(other.arena_, nullptr))
+    , row_(other.row_)
+    , view_(std::move(other.view_)) {}
+
+DynamicBatcher::InputSlot::~InputSlot() {
+    if (arena_) {
+        owner_->commit(arena_, row_, false);
+    }
+}
+
+DynamicBatcher::DynamicBatcher(const layers::Sequential& model,
                                const std::vector<size_t>& input_shape,
                                const BatcherConfig& config)
-    : model_(model)
-    , input_shape_(input_shape)
+    : input_shape_(input_shape)
     , config_(config)
-    , stop_(false)
-    , thread_(&DynamicBatcher::batcher_loop, this)
 {
+    config_.num_workers = std::max<size_t>(1, config_.num_workers);
+    config_.max_batch_size = std::max<size_t>(1, config_.max_batch_size);
+
+    auto shapes = config_.shape_buckets;
+    if (shapes.empty()) {
+        shapes.push_back(input_shape_);
+    }
+    std::sort(shapes.begin(), shapes.end(),
+              [](const auto& a, const auto& b) {
+                  return element_count(a) < element_count(b);
+              });
+
+    // Staging arenas per bucket: enough rows for queue_capacity plus one
+    // batch per worker. Each lane installs an open arena on first use.
+    const size_t arenas_per_bucket =
+        (config_.queue_capacity + config_.max_batch_size - 1) /
+            config_.max_batch_size + config_.num_workers;
+    CompileOptions options;
+    options.max_batch_size = config_.max_batch_size;
+    for (const auto& shape : shapes) {
+        if (shape.size() != input_shape_.size()) {
+            throw std::invalid_argument(
+                "DynamicBatcher: bucket rank must match input_shape rank");
+        }
+        auto bucket = std::make_unique<Bucket>(shape, config_, arenas_per_bucket);
+
+        // One batched plan per worker: private buffers, no shared layer state
+        bucket->plans.reserve(config_.num_workers);
+        for (size_t w = 0; w < config_.num_workers; ++w) {
+            bucket->plans.push_back(ModelCompiler::compile(model, shape, options));
+        }
+        const auto& max_output =
+            bucket->plans[0].batch_output_shape(config_.max_batch_size);
+        bucket->output_shape.assign(max_output.begin() + 1, max_output.end());
+        bucket->outputs = std::make_shared<OutputPool>(max_output,
+                                                       bucket->free.capacity());
+
+        std::vector<size_t> staging_shape = {config_.max_batch_size};
+        staging_shape.insert(staging_shape.end(), shape.begin(), shape.end());
+        for (size_t i = 0; i < arenas_per_bucket; ++i) {
+            bucket->arenas.push_back(std::make_unique<Arena>(
+                bucket.get(), staging_shape, config_.max_batch_size));
+            Arena* arena = bucket->arenas.back().get();
+            bucket->free.try_push(std::move(arena));
+        }
+        buckets_.push_back(std::move(bucket));
+    }
+
+    const size_t total_arenas = arenas_per_bucket * buckets_.size();
+    for (auto& lane : closed_) {
+        lane = std::make_unique<MpmcQueue<Arena*>>(total_arenas);
+    }
+    batches_ = std::make_unique<MpmcQueue<Arena*>>(total_arenas);
+    filling_.reserve(total_arenas);
+
+    workers_.reserve(config_.num_workers);
+    for (size_t w = 0; w < config_.num_workers; ++w) {
+        workers_.emplace_back(&DynamicBatcher::worker_loop, this, w);
+    }
+    thread_ = std::thread(&DynamicBatcher::batcher_loop, this);
 }
 
 DynamicBatcher::~DynamicBatcher() {
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        stop_ = true;
+    stop_.store(true, std::memory_order_seq_cst);
+    idle_.notify_all();
+    thread_.join();  // former seals and dispatches every staged request
+
+    former_done_.store(true, std::memory_order_seq_cst);
+    workers_idle_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
     }
-    cv_.notify_one();
-    thread_.join();
 }
 
-std::future<Tensor> DynamicBatcher::submit(Tensor input) {
-    std::promise<Tensor> promise;
-    auto future = promise.get_future();
+DynamicBatcher::Bucket& DynamicBatcher::bucket_for(const std::vector<size_t>& shape) {
+    // Without configured buckets only the exact input shape is accepted
+    if (config_.shape_buckets.empty() && shape == buckets_[0]->shape) {
+        return *buckets_[0];
+    }
+    for (auto& bucket : buckets_) {
+        if (config_.shape_buckets.empty()) {
+            break;
+        }
+        if (bucket->shape.size() != shape.size()) {
+            continue;
+        }
+        bool fits = true;
+        for (size_t d = 0; d < shape.size(); ++d) {
+            fits = fits && shape[d] <= bucket->shape[d];
+        }
+        if (fits) {
+            return *bucket;  // buckets are sorted, so this is the smallest
+        }
+    }
 
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (stop_) {
-            promise.set_exception(std::make_exception_ptr(
-                std::runtime_error("DynamicBatcher: submit on stopped batcher")));
-            return future;
+    std::string dims;
+    for (auto d : shape) {
+        dims += (dims.empty() ? "" : ", ") + std::to_string(d);
+    }
+    throw ValidationException("DynamicBatcher: no shape bucket fits input {" +
+                              dims + "}");
+}
+
+DynamicBatcher::InputSlot DynamicBatcher::reserve(const TaskOptions& options) {
+    return reserve(input_shape_, options);
+}
+
+DynamicBatcher::InputSlot DynamicBatcher::reserve(const std::vector<size_t>& shape,
+                                                  const TaskOptions& options) {
+    return reserve(bucket_for(shape), shape, options);
+}
+
+DynamicBatcher::InputSlot DynamicBatcher::reserve(Bucket& bucket,
+                                                  const std::vector<size_t>& shape,
+                                                  const TaskOptions& options) {
+    const auto max_rows = static_cast<uint32_t>(config_.max_batch_size);
+    const auto lane = static_cast<size_t>(options.priority);
+    for (;;) {
+        if (stop_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("DynamicBatcher: submit on stopped batcher");
+        }
+
+        // Fast path: one atomic increment claims a row of the open arena
+        Arena* arena = bucket.open[lane].load(std::memory_order_acquire);
+        if (arena) {
+            uint32_t row = arena->reserved.fetch_add(1, std::memory_order_acq_rel);
+            if (row < max_rows) {
+                auto& slot_row = arena->rows[row];
+                slot_row.promise = std::promise<Tensor>();
+                slot_row.deadline = options.deadline;
+                slot_row.padded = shape != bucket.shape;
+                slot_row.live = false;
+                float* data = arena->staging.data() + row * bucket.sample_size;
+                if (slot_row.padded) {
+                    slot_row.shape = shape;
+                    std::memset(data, 0, bucket.sample_size * sizeof(float));
+                }
+                if (row + 1 == max_rows) {
+                    // Filled it: close now so the former need not wait
+                    std::lock_guard<std::mutex> lock(rotate_mutex_);
+                    if (bucket.open[arena->lane].load(std::memory_order_relaxed) ==
+                        arena) {
+                        seal_arena_locked(arena);
+                    }
+                }
+                // The arena may have been sealed, run and reinstalled for
+                // another lane between the load and the claim. The claimed
+                // row pins it (its batch waits for the commit), so lane is
+                // stable here; give the row back as dropped and retry.
+                if (arena->lane != lane) {
+                    commit(arena, row, false);
+                    continue;
+                }
+                return InputSlot(this, arena, row, Tensor::view(data, bucket.shape));
+            }
+        }
+
+        // Slow path: open arena full or none installed
+        std::lock_guard<std::mutex> lock(rotate_mutex_);
+        Arena* open = bucket.open[lane].load(std::memory_order_relaxed);
+        if (open && open == arena &&
+            open->reserved.load(std::memory_order_relaxed) >= max_rows) {
+            seal_arena_locked(open);
+        } else if (!open) {
+            install_arena_locked(bucket, lane);
+        }
+        if (!bucket.open[lane].load(std::memory_order_relaxed)) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            throw TitanInferException("DynamicBatcher: queue full",
+                                      ErrorCode::QUEUE_FULL);
         }
-        queue_.push(Request{std::move(input), std::move(promise)});
     }
-    cv_.notify_one();
+}
 
+std::future<Tensor> DynamicBatcher::submit(InputSlot slot) {
+    if (!slot.arena_) {
+        throw std::invalid_argument("DynamicBatcher: slot already submitted");
+    }
+    auto& row = slot.arena_->rows[slot.row_];
+    auto future = row.promise.get_future();
+    Bucket* bucket = slot.arena_->bucket;
+    commit(std::exchange(slot.arena_, nullptr), slot.row_, true);
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    bucket->policy.record_arrival();
     return future;
 }
 
-void DynamicBatcher::batcher_loop() {
-    for (;;) {
-        std::vector<Request> batch;
+std::future<Tensor> DynamicBatcher::submit(const Tensor& input,
+                                           const TaskOptions& options) {
+    try {
+        Bucket& bucket = bucket_for(input.shape());
+        InputSlot slot = reserve(bucket, input.shape(), options);
+        if (input.shape() == bucket.shape) {
+            std::memcpy(slot.tensor().data(), input.data(),
+                        bucket.sample_size * sizeof(float));
+        } else {
+            copy_region(input.data(), input.shape(), slot.tensor().data(),
+                        bucket.shape, input.shape());
+        }
+        return submit(std::move(slot));
+    } catch (...) {
+        std::promise<Tensor> promise;
+        promise.set_exception(std::current_exception());
+        return promise.get_future();
+    }
+}
 
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
+void DynamicBatcher::commit(Arena* arena, uint32_t row, bool live) {
+    auto& r = arena->rows[row];
+    r.live = live;
+    r.enqueued = std::chrono::steady_clock::now();
+    // First request starts this arena's batch-formation timer
+    int64_t unset = 0;
+    arena->first_commit.compare_exchange_strong(
+        unset, r.enqueued.time_since_epoch().count(), std::memory_order_relaxed);
+    // Publishes the row (release) and orders before the former's wake-up check
+    arena->committed.fetch_add(1, std::memory_order_seq_cst);
+    idle_.notify_one();
+}
 
-            // Wait for at least one request or stop signal
-            cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+BatchPolicyState DynamicBatcher::policy_state(size_t bucket) const {
+    return buckets_.at(bucket)->policy.state();
+}
 
-            if (stop_ && queue_.empty()) {
-                return;
+BatcherMetrics DynamicBatcher::metrics() const {
+    BatcherMetrics m;
+    m.submitted = submitted_.load(std::memory_order_relaxed);
+    m.completed = completed_.load(std::memory_order_relaxed);
+    m.shed_expired = shed_.load(std::memory_order_relaxed);
+    m.rejected_full = rejected_.load(std::memory_order_relaxed);
+    m.batches = batch_count_.load(std::memory_order_relaxed);
+    return m;
+}
+
+void DynamicBatcher::install_arena_locked(Bucket& bucket, size_t lane) {
+    if (auto next = bucket.free.try_pop()) {
+        Arena* arena = *next;
+        arena->committed.store(0, std::memory_order_relaxed);
+        arena->first_commit.store(0, std::memory_order_relaxed);
+        arena->size = 0;
+        arena->lane = lane;
+        arena->reserved.store(0, std::memory_order_release);
+        bucket.open[lane].store(arena, std::memory_order_release);
+    } else {
+        bucket.open[lane].store(nullptr, std::memory_order_release);
+    }
+}
+
+void DynamicBatcher::seal_arena_locked(Arena* arena) {
+    uint32_t reserved = arena->reserved.exchange(SEALED, std::memory_order_acq_rel);
+    arena->size = std::min(reserved, static_cast<uint32_t>(config_.max_batch_size));
+    install_arena_locked(*arena->bucket, arena->lane);
+    if (arena->size == 0) {
+        arena->bucket->free.try_push(std::move(arena));
+        return;
+    }
+    closed_[arena->lane]->try_push(std::move(arena));  // sized to hold every arena
+    idle_.notify_one();
+}
+
+void DynamicBatcher::seal_open_arena(Bucket& bucket, size_t lane) {
+    std::lock_guard<std::mutex> lock(rotate_mutex_);
+    Arena* open = bucket.open[lane].load(std::memory_order_relaxed);
+    if (open && open->reserved.load(std::memory_order_relaxed) > 0) {
+        seal_arena_locked(open);
+    }
+}
+
+size_t DynamicBatcher::shed_expired(Arena& arena) {
+    // Compact live, unexpired rows to the front so the model never sees
+    // requests whose callers have already given up
+    const auto now = std::chrono::steady_clock::now();
+    const auto never = std::chrono::steady_clock::time_point::max();
+    const size_t sample_size = arena.bucket->sample_size;
+    size_t shed = 0;
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < arena.size; ++i) {
+        auto& row = arena.rows[i];
+        if (!row.live) {
+            continue;
+        }
+        if (row.deadline != never && now >= row.deadline) {
+            row.promise.set_exception(std::make_exception_ptr(InferenceException(
+                "DynamicBatcher: request deadline exceeded before batching",
+                ErrorCode::DEADLINE_EXCEEDED)));
+            ++shed;
+            continue;
+        }
+        if (kept != i) {
+            std::memcpy(arena.staging.data() + kept * sample_size,
+                        arena.staging.data() + i * sample_size,
+                        sample_size * sizeof(float));
+            auto& dst = arena.rows[kept];
+            dst.promise = std::move(row.promise);
+            dst.enqueued = row.enqueued;
+            dst.deadline = row.deadline;
+            dst.padded = row.padded;
+            std::swap(dst.shape, row.shape);
+            dst.live = true;
+            row.live = false;
+        }
+        ++kept;
+    }
+    arena.size = kept;
+    shed_.fetch_add(shed, std::memory_order_relaxed);
+    return shed;
+}
+
+std::optional<DynamicBatcher::Arena*> DynamicBatcher::next_closed() {
+    // Same rule as ThreadPool: most urgent lane first, unless a lower lane
+    // has been bypassed STARVATION_LIMIT times in a row
+    for (size_t lane = 1; lane < ThreadPool::NUM_LANES; ++lane) {
+        if (bypassed_[lane] >= ThreadPool::STARVATION_LIMIT) {
+            if (auto arena = closed_[lane]->try_pop()) {
+                bypassed_[lane] = 0;
+                return arena;
+            }
+        }
+    }
+    for (size_t lane = 0; lane < ThreadPool::NUM_LANES; ++lane) {
+        if (auto arena = closed_[lane]->try_pop()) {
+            bypassed_[lane] = 0;
+            for (size_t lower = lane + 1; lower < ThreadPool::NUM_LANES; ++lower) {
+                if (!closed_[lower]->empty_approx()) {
+                    ++bypassed_[lower];
+                }
             }
+            return arena;
+        }
+    }
+    return std::nullopt;
+}
 
-            // Wait up to max_wait_ms to collect more requests
-            auto deadline = std::chrono::steady_clock::now() +
-                std::chrono::milliseconds(config_.max_wait_ms);
-
-            while (batch.size() < config_.max_batch_size) {
-                if (!queue_.empty()) {
-                    batch.push_back(std::move(queue_.front()));
-                    queue_.pop();
-                } else {
-                    // Wait for more or timeout
-                    if (cv_.wait_until(lock, deadline,
-                            [this] { return stop_ || !queue_.empty(); })) {
-                        if (stop_ && queue_.empty()) {
-                            break;
-                        }
-                    } else {
-                        break; // Timeout
-                    }
+void DynamicBatcher::dispatch(Arena* arena) {
+    if (arena->committed.load(std::memory_order_seq_cst) < arena->size) {
+        // Rows reserved before sealing are still being filled: set the
+        // arena aside rather than stall every other bucket and lane on it
+        filling_.push_back(arena);
+        return;
+    }
+    shed_expired(*arena);
+    if (arena->size == 0) {
+        recycle(arena);  // nothing left worth running
+        return;
+    }
+    in_flight_.fetch_add(1, std::memory_order_seq_cst);
+    // Count first so a worker that pops the batch never sees a negative count
+    pending_batches_.fetch_add(1, std::memory_order_seq_cst);
+    batches_->try_push(std::move(arena));  // sized to hold every arena
+    workers_idle_.notify_one();
+}
+
+bool DynamicBatcher::dispatch_filled() {
+    // Most urgent lane first, like next_closed()
+    bool dispatched = false;
+    for (size_t lane = 0; lane < ThreadPool::NUM_LANES; ++lane) {
+        for (size_t i = 0; i < filling_.size();) {
+            Arena* arena = filling_[i];
+            if (arena->lane == lane &&
+                arena->committed.load(std::memory_order_seq_cst) >= arena->size) {
+                filling_.erase(filling_.begin() + static_cast<std::ptrdiff_t>(i));
+                dispatch(arena);
+                dispatched = true;
+            } else {
+                ++i;
+            }
+        }
+    }
+    return dispatched;
+}
+
+void DynamicBatcher::recycle(Arena* arena) {
+    Bucket& bucket = *arena->bucket;
+    std::lock_guard<std::mutex> lock(rotate_mutex_);
+    bucket.free.try_push(std::move(arena));
+    for (size_t lane = 0; lane < ThreadPool::NUM_LANES; ++lane) {
+        if (!bucket.open[lane].load(std::memory_order_relaxed)) {
+            install_arena_locked(bucket, lane);
+        }
+    }
+}
+
+void DynamicBatcher::batcher_loop() {
+    using Clock = std::chrono::steady_clock;
+    const auto max_wait = std::chrono::milliseconds(config_.max_wait_ms);
+    std::vector<size_t> targets(buckets_.size(), config_.max_batch_size);
+    std::vector<std::chrono::microseconds> waits(buckets_.size(), max_wait);
+
+    auto any_closed = [this] {
+        for (const auto& lane : closed_) {
+            if (!lane->empty_approx()) {
+                return true;
+            }
+        }
+        return false;
+    };
+    // Calls fn(bucket index, lane, arena, committed) for each open arena with requests
+    auto for_each_open = [this](auto&& fn) {
+        for (size_t b = 0; b < buckets_.size(); ++b) {
+            for (size_t lane = 0; lane < ThreadPool::NUM_LANES; ++lane) {
+                Arena* open = buckets_[b]->open[lane].load(std::memory_order_acquire);
+                uint32_t n = open ? open->committed.load(std::memory_order_seq_cst) : 0;
+                if (n > 0 && fn(b, lane, *open, n)) {
+                    return true;
                 }
             }
         }
+        return false;
+    };
+    auto any_filled = [this] {
+        for (const Arena* arena : filling_) {
+            if (arena->committed.load(std::memory_order_seq_cst) >= arena->size) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto has_requests = [&] {
+        return for_each_open([](size_t, size_t, Arena&, uint32_t) { return true; });
+    };
+    auto reached_target = [&] {
+        return for_each_open([&](size_t b, size_t, Arena&, uint32_t n) {
+            return n >= targets[b];
+        });
+    };
 
-        if (batch.empty()) {
+    for (;;) {
+        // Sealed arenas go first, most urgent lane first
+        if (auto closed = next_closed()) {
+            dispatch(*closed);
+            continue;
+        }
+        if (dispatch_filled()) {
             continue;
         }
 
-        // Process batch
-        try {
-            if (batch.size() == 1) {
-                // Single request — no need to form batch tensor
-                Tensor result = model_.forward(batch[0].input);
-                batch[0].promise.set_value(std::move(result));
-            } else {
-                // Stack inputs into batched tensor
-                const size_t N = batch.size();
-                size_t sample_size = 1;
-                for (auto d : input_shape_) {
-                    sample_size *= d;
+        // Wait for at least one request or stop signal
+        idle_.wait([&] {
+            return stop_.load(std::memory_order_seq_cst) || any_closed() ||
+                   any_filled() || has_requests();
+        });
+        if (any_closed() || any_filled()) {
+            continue;
+        }
+        if (stop_.load(std::memory_order_seq_cst)) {
+            // Drain what is staged, including reserved-but-uncommitted rows
+            bool staged = false;
+            for (auto& bucket : buckets_) {
+                for (size_t lane = 0; lane < ThreadPool::NUM_LANES; ++lane) {
+                    Arena* open = bucket->open[lane].load(std::memory_order_acquire);
+                    if (open && open->reserved.load(std::memory_order_seq_cst) > 0) {
+                        seal_open_arena(*bucket, lane);
+                        staged = true;
+                    }
+                }
+            }
+            if (!staged) {
+                if (filling_.empty()) {
+                    return;
                 }
+                idle_.wait(any_filled);  // last rows of set-aside arenas
+            }
+            continue;
+        }
 
-                std::vector<size_t> batch_shape = {N};
-                batch_shape.insert(batch_shape.end(),
-                                   input_shape_.begin(), input_shape_.end());
-                Tensor batched_input(batch_shape);
+        // Each open arena has its own timer, started by its first request.
+        // Seal those that reached their bucket's target or timed out.
+        const auto now = Clock::now();
+        if (config_.adaptive) {
+            for (size_t b = 0; b < buckets_.size(); ++b) {
+                auto decision = buckets_[b]->policy.decide(now);
+                targets[b] = decision.batch_size;
+                waits[b] = decision.max_wait;
+            }
+        }
+        const bool worker_free =
+            in_flight_.load(std::memory_order_seq_cst) < config_.num_workers;
+        auto wake_at = now + max_wait;
+        bool holding = false;
+        for_each_open([&](size_t b, size_t lane, Arena& arena, uint32_t n) {
+            auto started = Clock::time_point(Clock::duration(
+                arena.first_commit.load(std::memory_order_relaxed)));
+            auto due = (started == Clock::time_point() ? now : started) + waits[b];
+            if (n < targets[b] && now < due) {
+                wake_at = std::min(wake_at, due);
+            } else if (worker_free) {
+                seal_open_arena(*buckets_[b], lane);
+            } else {
+                holding = true;  // every worker busy: let the batch keep growing
+            }
+            return false;
+        });
+        if (any_closed()) {
+            continue;
+        }
 
-                for (size_t i = 0; i < N; ++i) {
-                    std::memcpy(batched_input.data() + i * sample_size,
-                                batch[i].input.data(),
-                                sample_size * sizeof(float));
-                }
+        idle_.wait_until(wake_at, [&] {
+            return stop_.load(std::memory_order_seq_cst) || any_closed() ||
+                   any_filled() ||
+                   (holding ? in_flight_.load(std::memory_order_seq_cst) <
+                                  config_.num_workers
+                            : reached_target());
+        });
+    }
+}
 
-                Tensor batched_output = model_.forward(batched_input);
+void DynamicBatcher::worker_loop(size_t index) {
+    for (;;) {
+        auto batch = batches_->try_pop();
+        if (!batch) {
+            workers_idle_.wait([this] {
+                return former_done_.load(std::memory_order_seq_cst) ||
+                       pending_batches_.load(std::memory_order_seq_cst) > 0;
+            });
+            if (former_done_.load(std::memory_order_seq_cst) &&
+                pending_batches_.load(std::memory_order_seq_cst) <= 0) {
+                return;
+            }
+            continue;
+        }
+        pending_batches_.fetch_sub(1, std::memory_order_seq_cst);
+        Arena& arena = **batch;
+        execute(arena.bucket->plans[index], arena);
+        recycle(*batch);
+        in_flight_.fetch_sub(1, std::memory_order_seq_cst);
+        idle_.notify_one();  // a held batch may go now
+    }
+}
+
+void DynamicBatcher::execute(CompiledModel& plan, Arena& arena) {
+    Bucket& bucket = *arena.bucket;
+    const size_t n = arena.size;
+    batch_count_.fetch_add(1, std::memory_order_relaxed);
+    completed_.fetch_add(n, std::memory_order_relaxed);
+    auto exec_start = std::chrono::steady_clock::now();
+    try {
+        // The staged rows already form the batched input: no gather copy
+        std::vector<size_t> batch_shape = {n};
+        batch_shape.insert(batch_shape.end(), bucket.shape.begin(),
+                           bucket.shape.end());
+        Tensor input = Tensor::view(arena.staging.data(), batch_shape);
 
-                // Split output
-                size_t out_sample_size = batched_output.size() / N;
-                std::vector<size_t> single_out_shape(
-                    batched_output.shape().begin() + 1,
-                    batched_output.shape().end());
+        std::shared_ptr<Tensor> output = OutputPool::acquire(bucket.outputs);
+        Tensor out = Tensor::view(output->data(), plan.batch_output_shape(n));
+        plan.predict_batch(input, out);
+        if (out.data() != output->data()) {
+            // The last layer replaced its buffer; serve views into that one
+            output = std::make_shared<Tensor>(std::move(out));
+        }
 
-                for (size_t i = 0; i < N; ++i) {
-                    Tensor result(single_out_shape);
-                    std::memcpy(result.data(),
-                                batched_output.data() + i * out_sample_size,
-                                out_sample_size * sizeof(float));
-                    batch[i].promise.set_value(std::move(result));
+        // Hand out views; the buffer is recycled when the last one dies
+        const auto& out_shape = bucket.output_shape;
+        const size_t out_sample_size = element_count(out_shape);
+        const bool maps_to_input = config_.pad_output != PadOutput::KEEP &&
+                                   out_shape.size() == bucket.shape.size();
+        std::vector<size_t> valid(out_shape.size());
+        for (size_t i = 0; i < n; ++i) {
+            auto& row = arena.rows[i];
+            if (!row.live) {
+                continue;
+            }
+            float* result = output->data() + i * out_sample_size;
+            if (row.padded && maps_to_input) {
+                for (size_t d = 0; d < out_shape.size(); ++d) {
+                    valid[d] = (out_shape[d] * row.shape[d] + bucket.shape[d] - 1) /
+                               bucket.shape[d];
+                }
+                if (config_.pad_output == PadOutput::CROP) {
+                    Tensor cropped(valid);
+                    copy_region(result, out_shape, cropped.data(), valid, valid);
+                    row.promise.set_value(std::move(cropped));
+                    continue;
                 }
+                mask_outside(result, out_shape, valid);
             }
-        } catch (...) {
-            // Propagate exception to all pending requests
-            auto ex = std::current_exception();
-            for (auto& req : batch) {
-                req.promise.set_exception(ex);
+            row.promise.set_value(Tensor::view(result, out_shape, output));
+        }
+    } catch (...) {
+        // Propagate exception to all pending requests
+        auto ex = std::current_exception();
+        for (size_t i = 0; i < n; ++i) {
+            if (arena.rows[i].live) {
+                arena.rows[i].promise.set_exception(ex);
             }
         }
     }
+
+    auto done = std::chrono::steady_clock::now();
+    bucket.policy.record_batch(n,
+        std::chrono::duration<double, std::milli>(done - exec_start).count());
+    for (size_t i = 0; i < n; ++i) {
+        if (arena.rows[i].live) {
+            bucket.policy.record_latency(std::chrono::duration<double, std::milli>(
+                done - arena.rows[i].enqueued).count());
+        }
+    }
 }
 
 } // namespace engine
@@ -0,0 +1,1060 @@
+#include "titaninfer/engine/http_server.hpp"
+#include "titaninfer/engine/tensor_pool.hpp"
+#include "titaninfer/exceptions.hpp"
+#include "titaninfer/io/tensor_wire.hpp"
+#include "titaninfer/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace titaninfer::engine {
+
+// ===========================================================================
+// Anonymous namespace — internal components
+// ===========================================================================
+namespace {
+
+constexpr uint64_t LISTENER_ID = 0;   // epoll data of the listening socket
+constexpr uint64_t WAKE_ID = 1;       // epoll data of the loop's eventfd
+constexpr uint64_t FIRST_CONN_ID = 2;
+constexpr size_t RECV_BLOCK_BYTES = 64 * 1024;
+constexpr size_t MIN_READ_BYTES = 16 * 1024;  // reads start below this much room
+constexpr size_t MAX_IOV = 64;
+constexpr int MAX_EVENTS = 128;
+constexpr uint64_t MAX_DEADLINE_MS = 24ull * 60 * 60 * 1000;  // X-Deadline-Ms cap
+
+std::string errno_message(const std::string& what) {
+    return what + ": " + std::strerror(errno);
+}
+
+// ---------------------------------------------------------------------------
+// CompletionQueue — responses finished by workers, bound for one I/O loop
+// ---------------------------------------------------------------------------
+// Serialized response: HTTP head (plus a wire frame header) and, for
+// binary responses, the output tensor itself, sent from its own memory
+struct OutMessage {
+    std::string head;
+    std::optional<Tensor> payload;
+    bool close = false;  // last response on the connection
+};
+
+struct Completion {
+    uint64_t conn_id = 0;
+    uint64_t seq = 0;
+    OutMessage message;
+};
+
+class CompletionQueue {
+public:
+    CompletionQueue() : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (fd_ < 0) {
+            throw ServerException(errno_message("HttpServer: eventfd"));
+        }
+    }
+
+    ~CompletionQueue() { ::close(fd_); }
+
+    CompletionQueue(const CompletionQueue&) = delete;
+    CompletionQueue& operator=(const CompletionQueue&) = delete;
+
+    void push(Completion completion) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(std::move(completion));
+        }
+        wake();
+    }
+
+    void wake() {
+        uint64_t one = 1;
+        if (::write(fd_, &one, sizeof(one)) < 0) {
+            // Counter saturated: the loop is already due to wake up
+        }
+    }
+
+    std::vector<Completion> drain() {
+        uint64_t count;
+        if (::read(fd_, &count, sizeof(count)) < 0) {
+            // EAGAIN: woken for another reason
+        }
+        std::vector<Completion> items;
+        std::lock_guard<std::mutex> lock(mutex_);
+        items.swap(items_);
+        return items;
+    }
+
+    int fd() const noexcept { return fd_; }
+
+private:
+    int fd_;
+    std::mutex mutex_;
+    std::vector<Completion> items_;
+};
+
+// ---------------------------------------------------------------------------
+// HTTP helpers
+// ---------------------------------------------------------------------------
+bool iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return (x | 0x20) == (y | 0x20);
+           });
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+const char* reason_phrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 411: return "Length Required";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 431: return "Request Header Fields Too Large";
+        case 499: return "Client Closed Request";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        case 505: return "HTTP Version Not Supported";
+        default:  return "Unknown";
+    }
+}
+
+bool is_separator(char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\n' ||
+           c == '[' || c == ']';
+}
+
+void append_number(std::string& out, size_t value) {
+    char buf[24];
+    auto result = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, result.ptr);
+}
+
+void append_shape(std::string& out, const std::vector<size_t>& shape) {
+    for (size_t i = 0; i < shape.size(); ++i) {
+        if (i > 0) out += ',';
+        append_number(out, shape[i]);
+    }
+}
+
+OutMessage serialize_response(Response response, bool keep_alive,
+                              bool binary) {
+    const bool ok = response.status_code == 200;
+    const bool frame = ok && binary;
+
+    std::string body;
+    std::string frame_header;
+    if (frame) {
+        frame_header = io::TensorWire::encode_header(response.body);
+    } else if (ok) {
+        const Tensor& output = response.body;
+        body.reserve(output.size() * 12 + 2);
+        body += '[';
+        char buf[32];
+        for (size_t i = 0; i < output.size(); ++i) {
+            if (i > 0) body += ',';
+            auto result = std::to_chars(buf, buf + sizeof(buf), output.data()[i]);
+            body.append(buf, result.ptr);
+        }
+        body += ']';
+    } else {
+        body = std::move(response.error_message);
+    }
+    size_t content_length = frame
+        ? frame_header.size() + response.body.size() * sizeof(float)
+        : body.size();
+
+    OutMessage message;
+    std::string& out = message.head;
+    out.reserve(body.size() + frame_header.size() + 256);
+    out += "HTTP/1.1 ";
+    append_number(out, static_cast<size_t>(response.status_code));
+    out += ' ';
+    out += reason_phrase(response.status_code);
+    out += "\r\nContent-Type: ";
+    out += frame ? io::TENSOR_WIRE_CONTENT_TYPE
+                 : ok ? "application/json" : "text/plain";
+    if (ok) {
+        out += "\r\nX-Shape: ";
+        append_shape(out, response.body.shape());
+    }
+    out += "\r\nContent-Length: ";
+    append_number(out, content_length);
+    for (const auto& [name, value] : response.headers) {
+        out += "\r\n";
+        out += name;
+        out += ": ";
+        out += value;
+    }
+    out += keep_alive ? "\r\nConnection: keep-alive\r\n\r\n"
+                      : "\r\nConnection: close\r\n\r\n";
+    out += body;
+    out += frame_header;
+
+    if (frame) {
+        if constexpr (std::endian::native == std::endian::little) {
+            message.payload = std::move(response.body);
+        } else {
+            std::string encoded = io::TensorWire::encode(response.body);
+            out.append(encoded, frame_header.size());
+        }
+    }
+    message.close = !keep_alive;
+    return message;
+}
+
+OutMessage error_response(int status, const std::string& message) {
+    Response response;
+    response.status_code = status;
+    response.error_message = message;
+    return serialize_response(std::move(response), false, false);
+}
+
+// ---------------------------------------------------------------------------
+// RecvBuffer — a connection's received bytes in one 64-byte aligned block
+//
+// Binary request tensors are views into the block and hold a reference to
+// it, so the loop never moves or overwrites bytes of a shared block; it
+// continues in a fresh block instead.
+// ---------------------------------------------------------------------------
+class RecvBuffer {
+public:
+    static constexpr size_t ALIGNMENT = io::TENSOR_WIRE_ALIGNMENT;
+
+    explicit RecvBuffer(size_t capacity)
+        : capacity_((capacity + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT),
+          data_(static_cast<char*>(std::aligned_alloc(ALIGNMENT, capacity_)))
+    {
+        if (!data_) throw std::bad_alloc();
+    }
+
+    ~RecvBuffer() { std::free(data_); }
+
+    RecvBuffer(const RecvBuffer&) = delete;
+    RecvBuffer& operator=(const RecvBuffer&) = delete;
+
+    // Unparsed bytes
+    const char* data() const noexcept { return data_ + head_; }
+    size_t size() const noexcept { return tail_ - head_; }
+
+    char* write_ptr() noexcept { return data_ + tail_; }
+    size_t writable() const noexcept { return capacity_ - tail_; }
+    void commit(size_t n) noexcept { tail_ += n; }
+    void consume(size_t n) noexcept { head_ += n; }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+    // Place the unparsed bytes at offset `start` of the block
+    // (the caller guarantees the block is not shared)
+    void move_to(size_t start) noexcept {
+        std::memmove(data_ + start, data_ + head_, size());
+        tail_ = start + size();
+        head_ = start;
+    }
+
+    // Copy the unparsed bytes of `other` to offset `start`
+    void copy_from(const RecvBuffer& other, size_t start) noexcept {
+        std::memcpy(data_ + start, other.data(), other.size());
+        head_ = start;
+        tail_ = start + other.size();
+    }
+
+private:
+    size_t capacity_;
+    char* data_;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Shared state of the I/O loops
+// ---------------------------------------------------------------------------
+struct LoopShared {
+    ModelServer& server;
+    HttpServerConfig config;
+    std::shared_ptr<TensorPool> buffers;  // the ModelServer's pool
+    int listen_fd = -1;
+    std::atomic<bool> stop{false};
+
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> open{0};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> bad_requests{0};
+};
+
+// ---------------------------------------------------------------------------
+// IoLoop — one epoll loop and the connections it accepted
+// ---------------------------------------------------------------------------
+class IoLoop {
+public:
+    explicit IoLoop(LoopShared& shared)
+        : shared_(shared),
+          completions_(std::make_shared<CompletionQueue>())
+    {
+        epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_ < 0) {
+            throw ServerException(errno_message("HttpServer: epoll_create1"));
+        }
+        epoll_event wake{};
+        wake.events = EPOLLIN;
+        wake.data.u64 = WAKE_ID;
+        epoll_event listen{};
+        listen.events = EPOLLIN | EPOLLEXCLUSIVE;
+        listen.data.u64 = LISTENER_ID;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, completions_->fd(), &wake) < 0 ||
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, shared_.listen_fd, &listen) < 0) {
+            std::string message = errno_message("HttpServer: epoll_ctl");
+            ::close(epoll_fd_);
+            throw ServerException(message);
+        }
+    }
+
+    ~IoLoop() {
+        for (auto& [id, conn] : conns_) {
+            ::close(conn->fd);
+            shared_.open.fetch_sub(1, std::memory_order_relaxed);
+        }
+        ::close(epoll_fd_);
+    }
+
+    IoLoop(const IoLoop&) = delete;
+    IoLoop& operator=(const IoLoop&) = delete;
+
+    void wake() { completions_->wake(); }
+
+    void run() {
+        std::array<epoll_event, MAX_EVENTS> events;
+        while (!shared_.stop.load(std::memory_order_acquire)) {
+            int n = ::epoll_wait(epoll_fd_, events.data(), MAX_EVENTS, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                TITANINFER_LOG_ERROR(errno_message("HttpServer: epoll_wait"));
+                return;
+            }
+            for (int i = 0; i < n; ++i) {
+                uint64_t id = events[i].data.u64;
+                if (id == LISTENER_ID) {
+                    accept_all();
+                } else if (id == WAKE_ID) {
+                    deliver(completions_->drain());
+                } else if (auto it = conns_.find(id); it != conns_.end()) {
+                    on_event(*it->second, events[i].events);
+                }
+            }
+        }
+    }
+
+private:
+    struct Connection {
+        uint64_t id = 0;
+        int fd = -1;
+        std::shared_ptr<RecvBuffer> in =
+            std::make_shared<RecvBuffer>(RECV_BLOCK_BYTES);
+        std::deque<OutMessage> out;  // in order, front partly sent
+        size_t out_sent = 0;         // bytes of out.front() already sent
+        uint64_t next_seq = 0;   // seq of the next parsed request
+        uint64_t write_seq = 0;  // seq of the next response to queue
+        std::map<uint64_t, OutMessage> finished;  // out-of-order arrivals
+        std::map<uint64_t, CancellationToken> running;  // cancelled on close
+        bool read_closed = false;       // no further requests are parsed
+        bool peer_eof = false;          // FIN received; buffered ones still are
+        bool close_after_write = false; // last response is queued
+        uint32_t interest = 0;
+
+        size_t in_flight() const { return next_seq - write_seq; }
+    };
+
+    enum class Parse { INCOMPLETE, DISPATCHED, FAILED };
+
+    void accept_all() {
+        for (;;) {
+            int fd = ::accept4(shared_.listen_fd, nullptr, nullptr,
+                               SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    TITANINFER_LOG_WARNING(errno_message("HttpServer: accept"));
+                }
+                return;
+            }
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            auto conn = std::make_unique<Connection>();
+            conn->id = next_conn_id_++;
+            conn->fd = fd;
+            epoll_event ev{};
+            ev.events = conn->interest = EPOLLIN | EPOLLRDHUP;
+            ev.data.u64 = conn->id;
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+                ::close(fd);
+                continue;
+            }
+            shared_.accepted.fetch_add(1, std::memory_order_relaxed);
+            shared_.open.fetch_add(1, std::memory_order_relaxed);
+            conns_.emplace(conn->id, std::move(conn));
+        }
+    }
+
+    void on_event(Connection& conn, uint32_t events) {
+        if (events & (EPOLLERR | EPOLLHUP)) {
+            close_connection(conn);
+            return;
+        }
+        try {
+            if ((events & (EPOLLIN | EPOLLRDHUP)) && !read_some(conn)) {
+                return;  // closed
+            }
+        } catch (const std::exception& e) {
+            fail(conn, 500, e.what());  // e.g. no memory for the receive buffer
+        }
+        process(conn);
+    }
+
+    // Make room for `need` more bytes after the unparsed ones. With
+    // `align_at` set, also place unparsed byte `align_at` on a 64-byte
+    // boundary (the start of a binary frame, so its payload is aligned).
+    void reserve(Connection& conn, size_t need, size_t align_at = SIZE_MAX) {
+        RecvBuffer& in = *conn.in;
+        const bool shared = conn.in.use_count() > 1;  // views still alive
+        if (!shared && in.size() == 0 && align_at == SIZE_MAX) {
+            in.move_to(0);
+        }
+
+        size_t start = 0;
+        if (align_at != SIZE_MAX) {
+            if (reinterpret_cast<uintptr_t>(in.data() + align_at) %
+                    RecvBuffer::ALIGNMENT == 0 && in.writable() >= need) {
+                return;
+            }
+            start = (RecvBuffer::ALIGNMENT - align_at % RecvBuffer::ALIGNMENT) %
+                    RecvBuffer::ALIGNMENT;
+        } else if (in.writable() >= need) {
+            return;
+        }
+
+        if (!shared && start + in.size() + need <= in.capacity()) {
+            in.move_to(start);
+            return;
+        }
+        // Outgrowing the block doubles it, so a body read in many pieces
+        // is copied O(log n) times rather than once per read
+        size_t wanted = start + in.size() + need;
+        if (wanted > in.capacity()) {
+            wanted = std::max(wanted, 2 * in.capacity());
+        }
+        auto block = std::make_shared<RecvBuffer>(
+            std::max(RECV_BLOCK_BYTES, wanted));
+        block->copy_from(in, start);
+        conn.in = std::move(block);
+    }
+
+    // Returns false if the connection was closed
+    bool read_some(Connection& conn) {
+        for (;;) {
+            reserve(conn, MIN_READ_BYTES);
+            RecvBuffer& in = *conn.in;
+            size_t room = in.writable();
+            ssize_t n = ::recv(conn.fd, in.write_ptr(), room, 0);
+            if (n > 0) {
+                in.commit(static_cast<size_t>(n));
+                if (static_cast<size_t>(n) < room) return true;
+                continue;
+            }
+            if (n == 0) {
+                // Peer finished sending but may still read: answer what it
+                // sent, then close. Only a reset or failed send cancels.
+                conn.peer_eof = true;
+                return true;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            close_connection(conn);
+            return false;
+        }
+    }
+
+    // Parse and dispatch buffered requests, flush finished responses, then
+    // re-arm epoll for whatever the connection is waiting on
+    void process(Connection& conn) {
+        queue_finished(conn);  // frees pipeline slots before parsing
+        while (!conn.read_closed &&
+               conn.in_flight() < shared_.config.max_pipelined &&
+               guarded_parse_one(conn) == Parse::DISPATCHED) {
+        }
+        if (!flush(conn)) return;
+
+        // Nothing in flight means parsing stopped short of a complete
+        // request, so after EOF nothing more can arrive to answer
+        if ((conn.read_closed || conn.peer_eof) && conn.in_flight() == 0 &&
+            conn.out.empty()) {
+            close_connection(conn);
+            return;
+        }
+
+        // Reads pause (no EPOLLIN) while the pipeline is full, so buffered
+        // bytes stay put and level-triggered epoll does not spin on them
+        uint32_t interest = 0;
+        if (!conn.read_closed && !conn.peer_eof &&
+            conn.in_flight() < shared_.config.max_pipelined) {
+            interest |= EPOLLIN | EPOLLRDHUP;
+        }
+        if (!conn.out.empty()) {
+            interest |= EPOLLOUT;
+        }
+        if (interest != conn.interest) {
+            epoll_event ev{};
+            ev.events = conn.interest = interest;
+            ev.data.u64 = conn.id;
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, conn.fd, &ev);
+        }
+    }
+
+    // A throw must not escape the loop thread: answer it on the connection
+    Parse guarded_parse_one(Connection& conn) {
+        try {
+            return parse_one(conn);
+        } catch (const TitanInferException& e) {
+            return fail(conn, 400, e.what());
+        } catch (const std::exception& e) {
+            return fail(conn, 500, e.what());
+        }
+    }
+
+    Parse parse_one(Connection& conn) {
+        std::string_view buffer(conn.in->data(), conn.in->size());
+        size_t header_end = buffer.find("\r\n\r\n");
+        if (header_end == std::string_view::npos) {
+            if (buffer.size() > shared_.config.max_header_bytes) {
+                return fail(conn, 431, "Request headers too large");
+            }
+            return Parse::INCOMPLETE;
+        }
+
+        // Request line
+        std::string_view head = buffer.substr(0, header_end);
+        size_t line_end = head.find("\r\n");
+        std::string_view line = head.substr(0, line_end);
+        size_t sp1 = line.find(' ');
+        size_t sp2 = line.rfind(' ');
+        if (sp1 == std::string_view::npos || sp1 == sp2) {
+            return fail(conn, 400, "Malformed request line");
+        }
+        std::string_view method = line.substr(0, sp1);
+        std::string_view target = line.substr(sp1 + 1, sp2 - sp1 - 1);
+        std::string_view version = line.substr(sp2 + 1);
+        if (version != "HTTP/1.1" && version != "HTTP/1.0") {
+            return fail(conn, 505, "Unsupported HTTP version");
+        }
+        bool keep_alive = version == "HTTP/1.1";
+
+        Request request;
+        if (method == "POST") {
+            request.method = HttpMethod::POST;
+        } else if (method == "GET") {
+            request.method = HttpMethod::GET;
+        } else if (method == "DELETE") {
+            request.method = HttpMethod::DELETE_METHOD;
+        } else {
+            return fail(conn, 405, "Method not allowed");
+        }
+        request.path = std::string(target);
+
+        // Headers
+        size_t content_length = 0;
+        bool has_length = false;
+        std::string_view shape_header;
+        std::string_view accept;
+        bool binary_body = false;
+        std::string_view rest = line_end == std::string_view::npos
+            ? std::string_view() : head.substr(line_end + 2);
+        while (!rest.empty()) {
+            size_t eol = rest.find("\r\n");
+            std::string_view field = rest.substr(0, eol);
+            rest = eol == std::string_view::npos ? std::string_view()
+                                                 : rest.substr(eol + 2);
+            size_t colon = field.find(':');
+            if (colon == std::string_view::npos) {
+                return fail(conn, 400, "Malformed header");
+            }
+            std::string_view name = field.substr(0, colon);
+            std::string_view value = trim(field.substr(colon + 1));
+
+            if (iequals(name, "Content-Length")) {
+                auto result = std::from_chars(value.data(),
+                                              value.data() + value.size(),
+                                              content_length);
+                if (result.ec != std::errc() ||
+                    result.ptr != value.data() + value.size()) {
+                    return fail(conn, 400, "Invalid Content-Length");
+                }
+                has_length = true;
+            } else if (iequals(name, "Transfer-Encoding")) {
+                return fail(conn, 501, "Chunked bodies are not supported");
+            } else if (iequals(name, "Connection")) {
+                if (iequals(value, "close")) keep_alive = false;
+                if (iequals(value, "keep-alive")) keep_alive = true;
+            } else if (iequals(name, "Content-Type")) {
+                binary_body = iequals(value.substr(0, value.find(';')),
+                                      io::TENSOR_WIRE_CONTENT_TYPE);
+            } else if (iequals(name, "Accept")) {
+                accept = value;
+            } else if (iequals(name, "X-Shape")) {
+                shape_header = value;
+            } else if (iequals(name, "X-Tenant-Id")) {
+                request.tenant_id = std::string(value);
+            } else if (iequals(name, "X-Request-Id")) {
+                request.request_id = std::string(value);
+            } else if (iequals(name, "X-Priority")) {
+                if (iequals(value, "latency-critical")) {
+                    request.limits.priority = TaskPriority::LATENCY_CRITICAL;
+                } else if (iequals(value, "normal")) {
+                    request.limits.priority = TaskPriority::NORMAL;
+                } else if (iequals(value, "background")) {
+                    request.limits.priority = TaskPriority::BACKGROUND;
+                } else {
+                    return fail(conn, 400, "Invalid X-Priority");
+                }
+            } else if (iequals(name, "X-Deadline-Ms")) {
+                uint64_t ms = 0;
+                auto result = std::from_chars(value.data(),
+                                              value.data() + value.size(), ms);
+                if (result.ec != std::errc() ||
+                    result.ptr != value.data() + value.size()) {
+                    return fail(conn, 400, "Invalid X-Deadline-Ms");
+                }
+                // Capped so the time point cannot overflow
+                request.limits.deadline =
+                    std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(std::min(ms, MAX_DEADLINE_MS));
+            }
+        }
+
+        if (request.method == HttpMethod::POST && !has_length) {
+            return fail(conn, 411, "Content-Length required");
+        }
+        if (content_length > shared_.config.max_body_bytes) {
+            return fail(conn, 413, "Request body too large");
+        }
+        const size_t body_start = header_end + 4;
+        const size_t total = body_start + content_length;
+        if (buffer.size() < total) {
+            // Room for the whole body (and a full read, which keeps
+            // read_some from moving it), so it is received in place; a
+            // binary frame also gets its payload aligned
+            reserve(conn, std::max(total - buffer.size(), MIN_READ_BYTES),
+                    binary_body ? body_start : SIZE_MAX);
+            return Parse::INCOMPLETE;
+        }
+
+        bool binary_response = accept.empty()
+            ? binary_body
+            : accept.find(io::TENSOR_WIRE_CONTENT_TYPE) != std::string_view::npos;
+
+        if (binary_body) {
+            try {
+                request.body = io::TensorWire::decode(
+                    buffer.data() + body_start, content_length, conn.in);
+            } catch (const TitanInferException& e) {
+                return fail(conn, 400, e.what());
+            }
+        } else if (content_length > 0) {
+            std::string error;
+            if (!parse_body(buffer.substr(body_start, content_length),
+                            shape_header, request.body, error)) {
+                return fail(conn, 400, error);
+            }
+        }
+        conn.in->consume(total);
+        dispatch(conn, std::move(request), keep_alive, binary_response);
+        return Parse::DISPATCHED;
+    }
+
+    // Numbers go straight into a pooled buffer that the tensor views
+    bool parse_body(std::string_view body, std::string_view shape_header,
+                    Tensor& tensor, std::string& error) {
+        std::vector<size_t> shape;
+        size_t count = 0;
+        if (!shape_header.empty()) {
+            // Every value takes a character and all but the last a
+            // separator, so the body bounds the count before anything is
+            // allocated (and keeps the product from overflowing)
+            const size_t max_count = std::min(
+                body.size() / 2 + 1,
+                shared_.config.max_body_bytes / sizeof(float));
+            count = 1;
+            while (!shape_header.empty()) {
+                size_t dim = 0;
+                auto result = std::from_chars(
+                    shape_header.data(),
+                    shape_header.data() + shape_header.size(), dim);
+                if (result.ec != std::errc() || dim == 0) {
+                    error = "Invalid X-Shape header";
+                    return false;
+                }
+                if (dim > max_count / count) {
+                    error = "X-Shape does not fit the body";
+                    return false;
+                }
+                shape.push_back(dim);
+                count *= dim;
+                shape_header.remove_prefix(
+                    static_cast<size_t>(result.ptr - shape_header.data()));
+                if (!shape_header.empty()) {
+                    if (shape_header.front() != ',') {
+                        error = "Invalid X-Shape header";
+                        return false;
+                    }
+                    shape_header.remove_prefix(1);
+                }
+            }
+        } else {
+            bool in_token = false;
+            for (char c : body) {
+                bool token_char = !is_separator(c);
+                if (token_char && !in_token) ++count;
+                in_token = token_char;
+            }
+            shape = {count};
+        }
+        if (count == 0) {
+            error = "Empty tensor body";
+            return false;
+        }
+
+        auto buffer = shared_.buffers->acquire_buffer(count);
+        float* out = buffer.get();
+        size_t parsed = 0;
+        const char* p = body.data();
+        const char* end = p + body.size();
+        for (;;) {
+            while (p < end && is_separator(*p)) ++p;
+            if (p == end) break;
+            if (parsed == count) {
+                error = "Body has more values than X-Shape";
+                return false;
+            }
+            auto result = std::from_chars(p, end, out[parsed]);
+            if (result.ec != std::errc()) {
+                error = "Invalid number in body";
+                return false;
+            }
+            ++parsed;
+            p = result.ptr;
+        }
+        if (parsed != count) {
+            error = "Body has fewer values than X-Shape";
+            return false;
+        }
+        tensor = Tensor::view(out, shape, std::move(buffer));
+        return true;
+    }
+
+    void dispatch(Connection& conn, Request request, bool keep_alive,
+                  bool binary) {
+        shared_.requests.fetch_add(1, std::memory_order_relaxed);
+        uint64_t seq = conn.next_seq++;
+        if (!keep_alive) conn.read_closed = true;
+        request.limits.cancellation = CancellationToken::create();
+        conn.running.emplace(seq, request.limits.cancellation);
+
+        shared_.server.handle_request_async(
+            std::move(request),
+            [queue = completions_, id = conn.id, seq, keep_alive,
+             binary](Response response) {
+                queue->push(Completion{
+                    id, seq,
+                    serialize_response(std::move(response), keep_alive, binary)});
+            });
+    }
+
+    // Queue an error as the connection's last response
+    Parse fail(Connection& conn, int status, const std::string& message) {
+        shared_.bad_requests.fetch_add(1, std::memory_order_relaxed);
+        conn.finished.emplace(conn.next_seq++, error_response(status, message));
+        conn.read_closed = true;
+        return Parse::FAILED;
+    }
+
+    void deliver(std::vector<Completion> completions) {
+        // Queue everything first, so one send covers several responses
+        std::vector<uint64_t> touched;
+        touched.reserve(completions.size());
+        for (auto& completion : completions) {
+            auto it = conns_.find(completion.conn_id);
+            if (it == conns_.end()) continue;  // connection already gone
+            touched.push_back(completion.conn_id);
+            it->second->running.erase(completion.seq);
+            it->second->finished.emplace(completion.seq,
+                                         std::move(completion.message));
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (uint64_t id : touched) {
+            if (auto it = conns_.find(id); it != conns_.end()) {
+                process(*it->second);
+            }
+        }
+    }
+
+    // Move responses that are next in request order to the output
+    void queue_finished(Connection& conn) {
+        while (!conn.close_after_write) {
+            auto it = conn.finished.find(conn.write_seq);
+            if (it == conn.finished.end()) break;
+            conn.close_after_write = it->second.close;
+            conn.out.push_back(std::move(it->second));
+            conn.finished.erase(it);
+            ++conn.write_seq;
+        }
+    }
+
+    // Append in-order responses to the output and send what the socket
+    // takes. Returns false if the connection was closed.
+    bool flush(Connection& conn) {
+        queue_finished(conn);
+
+        // Gather heads and tensor payloads of queued responses into one
+        // gathered send, skipping what earlier calls already sent
+        std::array<iovec, MAX_IOV> iov;
+        while (!conn.out.empty()) {
+            size_t count = 0;
+            size_t skip = conn.out_sent;
+            for (const auto& message : conn.out) {
+                if (count + 2 > MAX_IOV) break;
+                auto add = [&](const void* data, size_t size) {
+                    if (skip >= size) {
+                        skip -= size;
+                        return;
+                    }
+                    iov[count].iov_base =
+                        const_cast<char*>(static_cast<const char*>(data)) + skip;
+                    iov[count].iov_len = size - skip;
+                    skip = 0;
+                    ++count;
+                };
+                add(message.head.data(), message.head.size());
+                if (message.payload) {
+                    add(message.payload->data(),
+                        message.payload->size() * sizeof(float));
+                }
+            }
+
+            // sendmsg rather than writev: MSG_NOSIGNAL avoids SIGPIPE
+            msghdr msg{};
+            msg.msg_iov = iov.data();
+            msg.msg_iovlen = count;
+            ssize_t n = ::sendmsg(conn.fd, &msg, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+                close_connection(conn);
+                return false;
+            }
+
+            // Retire fully sent messages
+            size_t sent = conn.out_sent + static_cast<size_t>(n);
+            while (!conn.out.empty()) {
+                const auto& front = conn.out.front();
+                size_t bytes = front.head.size() +
+                    (front.payload ? front.payload->size() * sizeof(float) : 0);
+                if (sent < bytes) break;
+                sent -= bytes;
+                conn.out.pop_front();
+            }
+            conn.out_sent = sent;
+        }
+
+        if (conn.close_after_write) {
+            close_connection(conn);
+            return false;
+        }
+        return true;
+    }
+
+    // The peer is gone, nobody will read these responses: stop their work
+    void cancel_running(Connection& conn) {
+        for (auto& [seq, token] : conn.running) token.cancel();
+        conn.running.clear();
+    }
+
+    void close_connection(Connection& conn) {
+        cancel_running(conn);
+        ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, conn.fd, nullptr);
+        ::close(conn.fd);
+        shared_.open.fetch_sub(1, std::memory_order_relaxed);
+        conns_.erase(conn.id);  // destroys conn
+    }
+
+    LoopShared& shared_;
+    std::shared_ptr<CompletionQueue> completions_;
+    int epoll_fd_ = -1;
+    uint64_t next_conn_id_ = FIRST_CONN_ID;
+    std::unordered_map<uint64_t, std::unique_ptr<Connection>> conns_;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// HttpServer::Impl
+// ===========================================================================
+
+struct HttpServer::Impl {
+    Impl(ModelServer& server, const HttpServerConfig& config)
+        : shared{server, config, server.tensor_pool()} {}
+
+    LoopShared shared;
+    std::vector<std::unique_ptr<IoLoop>> loops;
+    std::vector<std::thread> threads;
+    std::atomic<bool> running{false};
+    uint16_t port = 0;
+    std::mutex lifecycle_mutex;
+
+    void open_listener() {
+        const auto& config = shared.config;
+        int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw ServerException(errno_message("HttpServer: socket"));
+        }
+        int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(config.port);
+        if (::inet_pton(AF_INET, config.bind_address.c_str(), &addr.sin_addr) != 1) {
+            ::close(fd);
+            throw ServerException("HttpServer: invalid bind address '" +
+                                  config.bind_address + "'",
+                                  ErrorCode::INVALID_REQUEST);
+        }
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            ::listen(fd, config.listen_backlog) < 0) {
+            std::string message = errno_message(
+                "HttpServer: cannot listen on " + config.bind_address + ":" +
+                std::to_string(config.port));
+            ::close(fd);
+            throw ServerException(message);
+        }
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+        port = ntohs(addr.sin_port);
+        shared.listen_fd = fd;
+    }
+};
+
+// ===========================================================================
+// HttpServer public methods
+// ===========================================================================
+
+HttpServer::HttpServer(ModelServer& server, const HttpServerConfig& config)
+    : impl_(std::make_unique<Impl>(server, config)) {}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+void HttpServer::start() {
+    std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
+    if (impl_->running.load()) return;
+
+    impl_->open_listener();
+    impl_->shared.stop.store(false);
+    try {
+        size_t n = std::max<size_t>(impl_->shared.config.io_threads, 1);
+        for (size_t i = 0; i < n; ++i) {
+            impl_->loops.push_back(std::make_unique<IoLoop>(impl_->shared));
+        }
+    } catch (...) {
+        impl_->loops.clear();
+        ::close(impl_->shared.listen_fd);
+        impl_->shared.listen_fd = -1;
+        throw;
+    }
+    for (auto& loop : impl_->loops) {
+        impl_->threads.emplace_back([l = loop.get()] { l->run(); });
+    }
+    impl_->running.store(true);
+
+    TITANINFER_LOG_INFO("HttpServer listening on " +
+                        impl_->shared.config.bind_address + ":" +
+                        std::to_string(impl_->port) + " with " +
+                        std::to_string(impl_->loops.size()) + " I/O threads");
+}
+
+void HttpServer::stop() {
+    std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
+    if (!impl_->running.load()) return;
+
+    impl_->shared.stop.store(true, std::memory_order_release);
+    for (auto& loop : impl_->loops) {
+        loop->wake();
+    }
+    for (auto& thread : impl_->threads) {
+        thread.join();
+    }
+    impl_->threads.clear();
+    impl_->loops.clear();  // closes the remaining connections
+    ::close(impl_->shared.listen_fd);
+    impl_->shared.listen_fd = -1;
+    impl_->running.store(false);
+
+    TITANINFER_LOG_INFO("HttpServer stopped");
+}
+
+bool HttpServer::running() const noexcept {
+    return impl_->running.load();
+}
+
+uint16_t HttpServer::port() const noexcept {
+    return impl_->port;
+}
+
+HttpServerStats HttpServer::stats() const {
+    HttpServerStats stats;
+    stats.accepted_connections = impl_->shared.accepted.load(std::memory_order_relaxed);
+    stats.open_connections = impl_->shared.open.load(std::memory_order_relaxed);
+    stats.requests = impl_->shared.requests.load(std::memory_order_relaxed);
+    stats.bad_requests = impl_->shared.bad_requests.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace titaninfer::engine
@@ -40,15 +40,30 @@ InferenceEngine::Builder::setInputShape(const std::vector<size_t>& shape) {
     return *this;
 }
 
+InferenceEngine::Builder&
+InferenceEngine::Builder::setSharedModel(
+        std::shared_ptr<const layers::Sequential> model) {
+    shared_model_ = std::move(model);
+    return *this;
+}
+
 InferenceEngine InferenceEngine::Builder::build() {
-    if (model_path_.empty()) {
+    if (model_path_.empty() && !shared_model_) {
         throw std::invalid_argument(
             "InferenceEngine::Builder::build: model path not set");
     }
 
     InferenceEngine engine;
     engine.profiling_enabled_ = profiling_enabled_;
-    engine.load_model(model_path_, input_shape_);
+    if (shared_model_) {
+        // The clone's parameter views keep shared_model_ alive
+        engine.set_model(shared_model_->clone_shared(
+                             std::const_pointer_cast<layers::Sequential>(
+                                 shared_model_)),
+                         input_shape_);
+    } else {
+        engine.load_model(model_path_, input_shape_);
+    }
 
     if (warmup_runs_ > 0) {
         engine.warmup(warmup_runs_);
@@ -94,8 +109,14 @@ InferenceEngine::~InferenceEngine() = default;
 void InferenceEngine::load_model(
         const std::string& filepath,
         const std::vector<size_t>& input_shape) {
+    set_model(io::ModelParser::load(filepath), input_shape);
+}
+
+void InferenceEngine::set_model(
+        std::unique_ptr<layers::Sequential> model,
+        const std::vector<size_t>& input_shape) {
 
-    model_ = io::ModelParser::load(filepath);
+    model_ = std::move(model);
 
     if (model_->empty()) {
         throw std::runtime_error(
@@ -208,12 +229,37 @@ void InferenceEngine::validate_input(const Tensor& input) const {
 // ============================================================
 
 Tensor InferenceEngine::predict(const Tensor& input) {
+    static const ExecutionLimits no_limits;
+    return predict(input, no_limits);
+}
+
+Tensor InferenceEngine::predict(const Tensor& input,
+                                const ExecutionLimits& limits) {
     if (!model_) {
         throw std::runtime_error(
             "InferenceEngine::predict: no model loaded");
     }
 
+    run(input, buffers_.back(), limits);
+
+    // Return a deep copy — internal buffer is reused across calls
+    return Tensor(buffers_.back());
+}
+
+void InferenceEngine::predict_into(const Tensor& input, Tensor& output,
+                                   const ExecutionLimits& limits) {
+    if (!model_) {
+        throw std::runtime_error(
+            "InferenceEngine::predict_into: no model loaded");
+    }
+
+    run(input, output, limits);
+}
+
+void InferenceEngine::run(const Tensor& input, Tensor& output,
+                          const ExecutionLimits& limits) {
     validate_input(input);
+    const bool limited = limits.active();
 
     using clock = std::chrono::steady_clock;
     clock::time_point total_start;
@@ -222,28 +268,21 @@ Tensor InferenceEngine::predict(const Tensor& input) {
         total_start = clock::now();
     }
 
-    // Layer 0: input -> buffers_[0]
-    if (profiling_enabled_) {
-        auto start = clock::now();
-        model_->layer(0).forward(input, buffers_[0]);
-        auto end = clock::now();
-        stats_.layer_times_ms[0] +=
-            std::chrono::duration<double, std::milli>(end - start).count();
-    } else {
-        model_->layer(0).forward(input, buffers_[0]);
-    }
-
-    // Layers 1..N-1: buffers_[i-1] -> buffers_[i]
-    for (size_t i = 1; i < model_->size(); ++i) {
+    // Layer i: (input or buffers_[i-1]) -> (buffers_[i] or output)
+    const size_t last = model_->size() - 1;
+    for (size_t i = 0; i <= last; ++i) {
+        if (limited) limits.check("InferenceEngine::predict");
+        const Tensor& layer_in = i == 0 ? input : buffers_[i - 1];
+        Tensor& layer_out = i == last ? output : buffers_[i];
         if (profiling_enabled_) {
             auto start = clock::now();
-            model_->layer(i).forward(buffers_[i - 1], buffers_[i]);
+            model_->layer(i).forward(layer_in, layer_out);
             auto end = clock::now();
             stats_.layer_times_ms[i] +=
                 std::chrono::duration<double, std::milli>(
                     end - start).count();
         } else {
-            model_->layer(i).forward(buffers_[i - 1], buffers_[i]);
+            model_->layer(i).forward(layer_in, layer_out);
         }
     }
 
@@ -269,9 +308,6 @@ Tensor InferenceEngine::predict(const Tensor& input) {
                 std::max(stats_.max_latency_ms, elapsed_ms);
         }
     }
-
-    // Return a deep copy — internal buffer is reused across calls
-    return Tensor(buffers_.back());
 }
 
 std::vector<Tensor> InferenceEngine::predict_batch(
@@ -317,6 +353,22 @@ InferenceEngine::expected_input_shape() const {
     return input_shape_;
 }
 
+const std::vector<size_t>& InferenceEngine::output_shape() const {
+    if (!model_) {
+        throw std::runtime_error(
+            "InferenceEngine::output_shape: no model loaded");
+    }
+    return buffers_.back().shape();
+}
+
+const layers::Sequential& InferenceEngine::model() const {
+    if (!model_) {
+        throw std::runtime_error(
+            "InferenceEngine::model: no model loaded");
+    }
+    return *model_;
+}
+
 std::string InferenceEngine::summary() const {
     if (!model_) {
         throw std::runtime_error(
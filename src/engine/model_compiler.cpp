@@ -41,6 +41,62 @@ Tensor CompiledModel::predict(const Tensor& input) {
     return result;
 }
 
+void CompiledModel::predict_batch(const Tensor& input, Tensor& output) {
+    if (!model_ || model_->empty()) {
+        throw std::runtime_error("CompiledModel: no model loaded");
+    }
+
+    // Validate input shape
+    const size_t n = input.ndim() > 0 ? input.shape()[0] : 0;
+    if (n == 0 || n > batch_shapes_.size()) {
+        throw std::invalid_argument("CompiledModel: batch size outside plan");
+    }
+    if (input.ndim() != input_shape_.size() + 1) {
+        throw std::invalid_argument("CompiledModel: input dimension mismatch");
+    }
+    for (size_t i = 0; i < input_shape_.size(); ++i) {
+        if (input.shape()[i + 1] != input_shape_[i]) {
+            throw std::invalid_argument("CompiledModel: input shape mismatch");
+        }
+    }
+
+    const size_t n_layers = model_->size();
+    const auto& shapes = batch_shapes_[n - 1];
+
+    // Re-view intermediates only when the batch size changes
+    if (batch_views_size_ != n) {
+        for (size_t i = 0; i + 1 < n_layers; ++i) {
+            batch_views_[i] = Tensor::view(batch_buffers_[i].data(), shapes[i]);
+        }
+        batch_views_size_ = n;
+    }
+
+    if (n_layers == 1) {
+        model_->layer(0).forward(input, output);
+    } else {
+        model_->layer(0).forward(input, batch_views_[0]);
+        for (size_t i = 1; i + 1 < n_layers; ++i) {
+            model_->layer(i).forward(batch_views_[i - 1], batch_views_[i]);
+        }
+        model_->layer(n_layers - 1).forward(batch_views_[n_layers - 2], output);
+    }
+
+    for (size_t i = 0; i + 1 < n_layers; ++i) {
+        if (batch_views_[i].data() != batch_buffers_[i].data()) {
+            // A layer replaced its output buffer; rebuild views next time
+            batch_views_size_ = 0;
+            break;
+        }
+    }
+}
+
+const std::vector<size_t>& CompiledModel::batch_output_shape(size_t n) const {
+    if (n == 0 || n > batch_shapes_.size()) {
+        throw std::invalid_argument("CompiledModel: batch size outside plan");
+    }
+    return batch_shapes_[n - 1].back();
+}
+
 std::string CompiledModel::summary() const {
     if (!model_) return "(no model)";
     return model_->summary(input_shape_);
@@ -100,6 +156,29 @@ CompiledModel ModelCompiler::compile(
         compiled.buffers_.emplace_back(current_shape);
     }
 
+    // Step 5: Pre-allocate the batched plan
+    if (options.max_batch_size > 0) {
+        compiled.batch_shapes_.resize(options.max_batch_size);
+        for (size_t n = 1; n <= options.max_batch_size; ++n) {
+            std::vector<size_t> shape = {n};
+            shape.insert(shape.end(), input_shape.begin(), input_shape.end());
+            auto& per_layer = compiled.batch_shapes_[n - 1];
+            per_layer.reserve(n_layers);
+            for (size_t i = 0; i < n_layers; ++i) {
+                shape = compiled.model_->layer(i).output_shape(shape);
+                per_layer.push_back(shape);
+            }
+        }
+
+        const auto& max_shapes = compiled.batch_shapes_.back();
+        for (size_t i = 0; i + 1 < n_layers; ++i) {
+            compiled.batch_buffers_.emplace_back(max_shapes[i]);
+            compiled.batch_views_.push_back(
+                Tensor::view(compiled.batch_buffers_[i].data(), max_shapes[i]));
+        }
+        compiled.batch_views_size_ = options.max_batch_size;
+    }
+
     return compiled;
 }
 
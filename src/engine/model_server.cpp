@@ -1,23 +1,37 @@
 #include "titaninfer/engine/model_server.hpp"
+#include "titaninfer/engine/demand_predictor.hpp"
 #include "titaninfer/engine/inference_engine.hpp"
+#include "titaninfer/engine/mpmc_queue.hpp"
+#include "titaninfer/engine/result_cache.hpp"
+#include "titaninfer/engine/tensor_pool.hpp"
 #include "titaninfer/engine/thread_pool.hpp"
 #include "titaninfer/exceptions.hpp"
 #include "titaninfer/logger.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <limits>
 #include <list>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <random>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <utility>
 
 namespace titaninfer::engine {
@@ -43,23 +57,97 @@ std::string generate_request_id() {
 
 // ---------------------------------------------------------------------------
 // EnginePool — pool of InferenceEngine instances for one model-version
+//
+// Free engines are tracked in an atomic bitmap (bit set = leased): a lease
+// is one fetch_or, a release one fetch_and. Each thread first retries the
+// engine it used last on this pool, whose weights and buffers are likely
+// still in its caches. Callers sleep only when every engine is leased.
+//
+// The model file is parsed once; every engine views its weights and owns
+// only its layers' scratch state and activation buffers. An elastic pool
+// has slots for pool_size engines but populates only [0, size): the bits
+// of empty slots stay set, so nobody can claim them. A caller that waited
+// grow_wait for a lease fills the next slot and keeps the new engine; the
+// highest engine is retired once a whole idle window passed in which
+// fewer engines than the pool holds were ever leased at once.
 // ---------------------------------------------------------------------------
+struct PoolOptions {
+    size_t pool_size = 1;          // maximum size when elastic
+    size_t min_pool_size = 0;      // elastic lower bound; 0 = fixed size
+    std::chrono::microseconds grow_wait{500};
+    std::chrono::milliseconds idle_window{1000};
+    bool profiling = false;
+    // Requests go through a DynamicBatcher compiled from the loaded model,
+    // with one executor per pool engine; nullptr = unbatched (batched
+    // pools are never elastic)
+    const BatcherConfig* batching = nullptr;
+    size_t warmup_runs = 0;        // zero-input passes per engine
+    size_t replay_capacity = 0;    // recent inputs kept to warm a reload
+    // Unbatched outputs are written straight into tensors drawn from it;
+    // nullptr = plain owning tensors
+    std::shared_ptr<TensorPool> tensors;
+};
+
 class EnginePool {
 public:
-    EnginePool(const std::string& model_path, size_t pool_size,
-               bool profiling)
+    static constexpr size_t REPLAY_SAMPLE_EVERY = 16;
+    static constexpr std::chrono::milliseconds CANCEL_POLL{2};
+
+    EnginePool(const std::string& model_path, const PoolOptions& options)
+        : capacity_(std::max<size_t>(options.pool_size, 1)),
+          min_size_(options.batching || options.min_pool_size == 0
+                        ? capacity_
+                        : std::min(options.min_pool_size, capacity_)),
+          grow_wait_(options.grow_wait),
+          idle_window_ns_(std::chrono::nanoseconds(options.idle_window).count()),
+          profiling_(options.profiling), warmup_runs_(options.warmup_runs),
+          tensors_(options.tensors), replay_capacity_(options.replay_capacity)
     {
-        engines_.reserve(pool_size);
-        in_use_.resize(pool_size, false);
-        for (size_t i = 0; i < pool_size; ++i) {
-            auto engine = InferenceEngine::Builder()
-                .setModelPath(model_path)
-                .enableProfiling(profiling)
-                .build();
+        const BatcherConfig* batching = options.batching;
+        model_ = io::ModelParser::load(model_path);
+        engines_.resize(capacity_);
+        const size_t words = (capacity_ + BITS - 1) / BITS;
+        leased_ = std::make_unique<std::atomic<uint64_t>[]>(words);
+        word_count_ = words;
+        for (size_t w = 0; w < words; ++w) {
+            // Bits of empty slots stay set so they are never handed out
+            size_t valid = min_size_ > w * BITS
+                ? std::min(BITS, min_size_ - w * BITS) : 0;
+            uint64_t spare = valid == BITS ? 0 : ~uint64_t{0} << valid;
+            leased_[w].store(spare, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < min_size_; ++i) {
+            engines_[i].emplace(make_engine());
             if (i == 0) {
-                input_shape_ = engine.expected_input_shape();
+                input_shape_ = engines_[i]->expected_input_shape();
+                output_shape_ = engines_[i]->output_shape();
             }
-            engines_.push_back(std::move(engine));
+        }
+        size_.store(min_size_, std::memory_order_relaxed);
+        window_end_ns_.store(now_ns() + idle_window_ns_,
+                             std::memory_order_relaxed);
+
+        // Estimated footprint: one copy of the weights, plus activation
+        // buffers for every engine the pool may grow to; a batcher adds
+        // one plan per worker whose buffers are sized for the largest batch
+        const size_t params = model_->total_parameters();
+        size_t activations = 0;
+        std::vector<size_t> shape = input_shape_;
+        for (size_t i = 0; i < model_->size(); ++i) {
+            shape = model_->layer(i).output_shape(shape);
+            size_t count = 1;
+            for (size_t dim : shape) count *= dim;
+            activations += count;
+        }
+        bytes_ = (params + activations * capacity_) * sizeof(float);
+
+        if (batching) {
+            BatcherConfig config = *batching;
+            config.num_workers = capacity_;
+            batcher_ = std::make_unique<DynamicBatcher>(
+                *model_, input_shape_, config);
+            bytes_ += (params + activations * config.max_batch_size) *
+                      sizeof(float) * capacity_;
         }
     }
 
@@ -95,115 +183,508 @@ public:
         Lease(const Lease&) = delete;
         Lease& operator=(const Lease&) = delete;
 
-        InferenceEngine& engine() { return pool_->engines_[index_]; }
+        InferenceEngine& engine() { return *pool_->engines_[index_]; }
 
     private:
         EnginePool* pool_;
         size_t index_;
     };
 
-    Lease acquire() {
-        std::unique_lock<std::mutex> lock(mutex_);
-        cv_.wait(lock, [this]() {
-            for (size_t i = 0; i < in_use_.size(); ++i) {
-                if (!in_use_[i]) return true;
+    Lease acquire(const ExecutionLimits& limits = {}) {
+        size_t index = 0;
+        if (!try_claim(index)) {
+            wait_for_engine(index, limits);
+        }
+        remember(index);
+        return Lease(*this, index);
+    }
+
+    // Run one request: coalesced with concurrent ones when batching is
+    // enabled, otherwise at batch 1 on a leased engine. `limits` bound the
+    // lease wait and are checked between layers; a batched request carries
+    // the deadline into the batcher queue.
+    Tensor predict(const Tensor& input, const ExecutionLimits& limits = {}) {
+        if (!batcher_) {
+            auto lease = acquire(limits);
+            Tensor output = tensors_ ? tensors_->acquire(output_shape_)
+                                     : Tensor(output_shape_);
+            lease.engine().predict_into(input, output, limits);
+            return output;
+        }
+        const float* data = input.data();
+        if (std::any_of(data, data + input.size(),
+                        [](float v) { return std::isnan(v); })) {
+            throw std::invalid_argument("EnginePool: input contains NaN");
+        }
+        limits.check("EnginePool: batched predict");
+        TaskOptions options;
+        options.priority = limits.priority;
+        options.deadline = limits.deadline;
+        return batcher_->submit(input, options).get();
+    }
+
+    // Keep one in REPLAY_SAMPLE_EVERY request inputs (the latest
+    // replay_capacity of them) to warm up a reloaded version of this model
+    void sample_input(const Tensor& input) {
+        if (replay_capacity_ == 0 ||
+            sampled_.fetch_add(1, std::memory_order_relaxed) %
+                REPLAY_SAMPLE_EVERY != 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(replay_mutex_);
+        if (recent_inputs_.size() < replay_capacity_) {
+            recent_inputs_.push_back(input);
+        } else {
+            recent_inputs_[replay_next_] = input;
+        }
+        replay_next_ = (replay_next_ + 1) % replay_capacity_;
+    }
+
+    std::vector<Tensor> recent_inputs() const {
+        std::lock_guard<std::mutex> lock(replay_mutex_);
+        return recent_inputs_;
+    }
+
+    // Run `inputs` through every engine (and the batcher) before the pool
+    // takes traffic; inputs the new version rejects are skipped
+    void warm_up(const std::vector<Tensor>& inputs) {
+        for (auto& engine : engines_) {
+            if (!engine) continue;
+            for (const auto& input : inputs) {
+                try {
+                    engine->predict(input);
+                } catch (const std::exception&) {
+                }
             }
-            return false;
-        });
-        for (size_t i = 0; i < in_use_.size(); ++i) {
-            if (!in_use_[i]) {
-                in_use_[i] = true;
-                return Lease(*this, i);
+        }
+        if (batcher_) {
+            std::vector<std::future<Tensor>> pending;
+            pending.reserve(inputs.size());
+            for (const auto& input : inputs) {
+                pending.push_back(batcher_->submit(input));
+            }
+            for (auto& result : pending) {
+                try {
+                    result.get();
+                } catch (const std::exception&) {
+                }
             }
         }
-        // Should never reach here due to the wait predicate
-        throw ServerException("EnginePool: no available engine",
-                              ErrorCode::INTERNAL_ERROR);
     }
 
-    size_t pool_size() const noexcept { return engines_.size(); }
+    uint64_t id() const noexcept { return id_; }
+    size_t pool_size() const noexcept {
+        return size_.load(std::memory_order_relaxed);
+    }
     const std::vector<size_t>& input_shape() const { return input_shape_; }
+    bool batched() const noexcept { return batcher_ != nullptr; }
+    size_t memory_bytes() const noexcept { return bytes_; }
+
+    // Periodic check, so a pool that stops taking requests (and so stops
+    // returning leases) still gives back its spare engines
+    void shrink_if_idle() {
+        if (elastic()) {
+            maybe_shrink();
+        }
+    }
+
+    EnginePoolStats stats() const {
+        EnginePoolStats out;
+        out.engines = pool_size();
+        out.min_engines = min_size_;
+        out.max_engines = capacity_;
+        out.grown = grown_.load(std::memory_order_relaxed);
+        out.shrunk = shrunk_.load(std::memory_order_relaxed);
+        return out;
+    }
 
 private:
+    static constexpr size_t BITS = 64;
+    static constexpr size_t AFFINITY_SLOTS = 8;
+
+    struct Affinity {
+        uint64_t pool_id = 0;
+        size_t index = 0;
+    };
+
+    static int64_t now_ns() {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    InferenceEngine make_engine() const {
+        return InferenceEngine::Builder()
+            .setSharedModel(model_)
+            .enableProfiling(profiling_)
+            .setWarmupRuns(warmup_runs_)
+            .build();
+    }
+
+    bool elastic() const noexcept { return min_size_ < capacity_; }
+
+    // Per-thread "last engine used" hints, direct-mapped by pool id
+    static Affinity& affinity(uint64_t pool_id) {
+        thread_local std::array<Affinity, AFFINITY_SLOTS> hints{};
+        return hints[pool_id % AFFINITY_SLOTS];
+    }
+
+    size_t preferred_index() const {
+        const Affinity& hint = affinity(id_);
+        if (hint.pool_id == id_) return hint.index;
+        // No history: spread threads over the pool
+        return std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+               std::max<size_t>(pool_size(), 1);
+    }
+
+    void remember(size_t index) const {
+        affinity(id_) = Affinity{id_, index};
+    }
+
+    bool try_claim(size_t& index) {
+        const size_t preferred = preferred_index();
+        const size_t first_word = preferred / BITS;
+        const uint64_t preferred_bit = uint64_t{1} << (preferred % BITS);
+        // seq_cst pairs with release() so a sleeper never misses a free bit
+        if (!(leased_[first_word].fetch_or(preferred_bit,
+                                           std::memory_order_seq_cst) &
+              preferred_bit)) {
+            index = preferred;
+            return true;
+        }
+
+        // Any free bit, starting at the preferred word
+        for (size_t n = 0; n < word_count_; ++n) {
+            const size_t w = (first_word + n) % word_count_;
+            uint64_t word = leased_[w].load(std::memory_order_relaxed);
+            while (~word) {
+                const uint64_t bit = uint64_t{1} << std::countr_one(word);
+                word = leased_[w].fetch_or(bit, std::memory_order_seq_cst);
+                if (!(word & bit)) {
+                    index = w * BITS +
+                            static_cast<size_t>(std::countr_zero(bit));
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Sleep until an engine frees up, within `limits`; a token is polled
+    // every CANCEL_POLL since cancel() does not wake the waiter. Below its
+    // maximum, an elastic pool grows for a caller that waited grow_wait_.
+    void wait_for_engine(size_t& index, const ExecutionLimits& limits) {
+        for (;;) {
+            limits.check("EnginePool: waiting for an engine");
+            const bool may_grow = pool_size() < capacity_;
+            auto until = limits.deadline;
+            if (limits.cancellation.cancellable() || may_grow) {
+                const auto now = std::chrono::steady_clock::now();
+                if (limits.cancellation.cancellable()) {
+                    until = std::min(until, now + CANCEL_POLL);
+                }
+                if (may_grow) {
+                    until = std::min(
+                        until, now + std::chrono::duration_cast<
+                                         std::chrono::steady_clock::duration>(
+                                         grow_wait_));
+                }
+            }
+            if (until == std::chrono::steady_clock::time_point::max()) {
+                idle_.wait([&] { return try_claim(index); });
+                return;
+            }
+            if (idle_.wait_until(until, [&] { return try_claim(index); })) {
+                return;
+            }
+            if (may_grow && try_grow(index)) {
+                return;
+            }
+        }
+    }
+
+    // Fill the next empty slot and hand it to the caller. Its bit has been
+    // set since the slot was emptied, so nobody else can claim it.
+    bool try_grow(size_t& index) {
+        std::unique_lock<std::mutex> lock(resize_mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return false;  // another caller is resizing
+        }
+        const size_t slot = size_.load(std::memory_order_relaxed);
+        if (slot >= capacity_) {
+            return false;
+        }
+        engines_[slot].emplace(make_engine());
+        size_.store(slot + 1, std::memory_order_relaxed);
+        grown_.fetch_add(1, std::memory_order_relaxed);
+        index = slot;
+        return true;
+    }
+
+    // Retire the highest engines while they are free, down to `target`
+    // (at least min_size_); a leased one stops it until the next window
+    void shrink_to(size_t target) {
+        std::unique_lock<std::mutex> lock(resize_mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return;
+        }
+        target = std::max(target, min_size_);
+        for (size_t size = size_.load(std::memory_order_relaxed);
+             size > target; --size) {
+            const size_t slot = size - 1;
+            const uint64_t bit = uint64_t{1} << (slot % BITS);
+            if (leased_[slot / BITS].fetch_or(bit, std::memory_order_seq_cst) &
+                bit) {
+                return;
+            }
+            size_.store(slot, std::memory_order_relaxed);
+            engines_[slot].reset();
+            shrunk_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Track the most engines leased at once, sampled as leases end (the
+    // releasing one included)
+    void note_leased() {
+        const size_t size = pool_size();
+        size_t leased = 0;
+        for (size_t w = 0; w < word_count_; ++w) {
+            leased += static_cast<size_t>(std::popcount(
+                leased_[w].load(std::memory_order_relaxed)));
+        }
+        // Minus the bits of empty and out-of-range slots; approximate
+        // while resizing
+        leased -= std::min(leased, word_count_ * BITS - size);
+        if (leased > peak_leased_.load(std::memory_order_relaxed)) {
+            peak_leased_.store(leased, std::memory_order_relaxed);
+        }
+    }
+
+    // Close the idle window once it is over; retire the engines that were
+    // spare throughout it
+    void maybe_shrink() {
+        const int64_t now = now_ns();
+        int64_t end = window_end_ns_.load(std::memory_order_relaxed);
+        if (now < end ||
+            !window_end_ns_.compare_exchange_strong(
+                end, now + idle_window_ns_, std::memory_order_relaxed)) {
+            return;
+        }
+        const size_t peak = peak_leased_.exchange(0, std::memory_order_relaxed);
+        if (peak < pool_size()) {
+            shrink_to(peak);
+        }
+    }
+
     void release(size_t index) {
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            in_use_[index] = false;
+        if (elastic()) {
+            note_leased();
+        }
+        leased_[index / BITS].fetch_and(~(uint64_t{1} << (index % BITS)),
+                                        std::memory_order_seq_cst);
+        idle_.notify_one();
+        if (elastic()) {
+            maybe_shrink();
         }
-        cv_.notify_one();
     }
 
-    std::vector<InferenceEngine> engines_;
-    std::vector<bool> in_use_;
-    std::mutex mutex_;
-    std::condition_variable cv_;
+    static inline std::atomic<uint64_t> next_id_{1};
+
+    const uint64_t id_ = next_id_.fetch_add(1, std::memory_order_relaxed);
+    const size_t capacity_;
+    const size_t min_size_;
+    const std::chrono::microseconds grow_wait_;
+    const int64_t idle_window_ns_;
+    const bool profiling_;
+    const size_t warmup_runs_;
+    std::shared_ptr<const layers::Sequential> model_;  // weights of every engine
+    std::vector<std::optional<InferenceEngine>> engines_;  // [0, size_) populated
+    std::unique_ptr<std::atomic<uint64_t>[]> leased_;
+    size_t word_count_ = 0;
+    IdleWaiter idle_;  // sleeps only when the pool is exhausted
+    std::atomic<size_t> size_{0};
+    std::mutex resize_mutex_;  // serializes growing and shrinking
+    std::atomic<size_t> peak_leased_{0};
+    std::atomic<int64_t> window_end_ns_{0};
+    std::atomic<uint64_t> grown_{0};
+    std::atomic<uint64_t> shrunk_{0};
     std::vector<size_t> input_shape_;
+    std::vector<size_t> output_shape_;
+    std::shared_ptr<TensorPool> tensors_;
+    size_t bytes_ = 0;
+
+    const size_t replay_capacity_;
+    std::atomic<uint64_t> sampled_{0};
+    mutable std::mutex replay_mutex_;
+    std::vector<Tensor> recent_inputs_;
+    size_t replay_next_ = 0;
+    std::unique_ptr<DynamicBatcher> batcher_;
 };
 
 // ---------------------------------------------------------------------------
-// ModelCache — LRU cache of loaded EnginePool instances
+// ModelCache — cache of loaded EnginePool instances
+//
+// Bounded by a model count and optionally by estimated bytes. Victims are
+// chosen by strict LRU, or by GreedyDual-Size-Frequency: each entry has
+// priority clock + hits * load_ms / bytes and the lowest goes first, so
+// small, hot or expensive-to-reload models stay; the clock rises to each
+// victim's priority so entries that stop being used age out.
+//
+// Loads are single-flight: the first request for a cold model-version
+// becomes its loader and concurrent requests wait on the same shared future
+// instead of loading copies of their own. Background loads (preload, or
+// requests with a load timeout) run on a small dedicated loader pool.
 // ---------------------------------------------------------------------------
-using CacheKey = std::pair<std::string, uint32_t>;
+using CacheKey = ModelKey;
+using CacheKeyHash = ModelKeyHash;
 
-struct CacheKeyHash {
-    size_t operator()(const CacheKey& k) const {
-        size_t h1 = std::hash<std::string>{}(k.first);
-        size_t h2 = std::hash<uint32_t>{}(k.second);
-        return h1 ^ (h2 * 2654435761u);
+// Batching mode for a model version: an exact version entry wins over a
+// whole-model (version 0) entry; nullptr = unbatched
+const BatcherConfig* find_batching(
+    const std::vector<ModelBatchingConfig>& batching, const CacheKey& key)
+{
+    const BatcherConfig* any_version = nullptr;
+    for (const auto& entry : batching) {
+        if (entry.model_name != key.first) continue;
+        if (entry.version == key.second) return &entry.batcher;
+        if (entry.version == 0 && !any_version) any_version = &entry.batcher;
     }
-};
+    return any_version;
+}
 
 class ModelCache {
 public:
-    ModelCache(size_t max_loaded, size_t pool_size, bool profiling)
-        : max_loaded_(max_loaded), pool_size_(pool_size),
-          profiling_(profiling) {}
+    using PoolPtr = std::shared_ptr<EnginePool>;
+    using PinnedFn = std::function<bool(const CacheKey&)>;
+
+    static constexpr size_t LOADER_THREADS = 2;
+
+    // One in-flight (or, for an already loaded model, completed) load
+    struct Loading {
+        Loading()
+            : pool(result.get_future().share())
+            , done(signal.get_future().share()) {}
+
+        std::promise<PoolPtr> result;
+        std::promise<void> signal;
+        std::shared_future<PoolPtr> pool;
+        std::shared_future<void> done;
+    };
+
+    ModelCache(const ModelServerConfig& config, size_t pool_size,
+               std::shared_ptr<TensorPool> tensors)
+        : max_loaded_(config.max_loaded_models),
+          max_bytes_(config.max_loaded_bytes),
+          policy_(config.eviction_policy), pool_size_(pool_size),
+          profiling_(config.enable_profiling), batching_(config.batching),
+          replay_capacity_(config.reload.replay_inputs),
+          elastic_(config.elastic_pools),
+          tensors_(std::move(tensors)),
+          loader_(std::make_unique<ThreadPool>(LOADER_THREADS)) {}
+
+    PoolPtr make_pool(const std::string& path, const CacheKey& key,
+                      size_t warmup_runs = 0) const {
+        PoolOptions options;
+        options.pool_size = pool_size_;
+        if (elastic_.enabled) {
+            options.pool_size = elastic_.max_engines > 0
+                ? elastic_.max_engines : pool_size_;
+            options.min_pool_size = std::max<size_t>(elastic_.min_engines, 1);
+            options.grow_wait = std::chrono::microseconds(elastic_.grow_wait_us);
+            options.idle_window = std::chrono::milliseconds(elastic_.idle_ms);
+        }
+        options.profiling = profiling_;
+        options.batching = find_batching(batching_, key);
+        options.warmup_runs = warmup_runs;
+        options.replay_capacity = replay_capacity_;
+        options.tensors = tensors_;
+        return std::make_shared<EnginePool>(path, options);
+    }
 
-    std::shared_ptr<EnginePool> get_or_load(
-        const ModelVersionInfo& info,
-        const std::function<bool(const CacheKey&)>& is_pinned)
+    // Run `work` on the loader pool
+    std::future<void> run_in_background(std::function<void()> work) {
+        return loader_->submit(TaskOptions{TaskPriority::BACKGROUND},
+                               std::move(work));
+    }
+
+    // Loads on the calling thread, or joins a load already in flight. With
+    // a nonzero timeout the load runs in the background instead and
+    // ServerException(MODEL_LOADING) is thrown if it is not ready in time.
+    PoolPtr get_or_load(const ModelVersionInfo& info,
+                        const PinnedFn& is_pinned,
+                        std::chrono::milliseconds timeout =
+                            std::chrono::milliseconds{0})
     {
         CacheKey key{info.name, info.version};
-
+        std::shared_ptr<Loading> loading;
+        bool loader = false;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            auto it = pools_.find(key);
-            if (it != pools_.end()) {
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
                 touch(key);
-                return it->second;
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return serving_pool_locked(it->second);
+            }
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            auto in_flight = loading_.find(key);
+            if (in_flight != loading_.end()) {
+                loading = in_flight->second;
+            } else if (timeout.count() == 0) {
+                loading = begin_load_locked(key);
+                loader = true;
             }
         }
 
-        // Load outside the lock (slow I/O)
-        TITANINFER_LOG_INFO("Loading model '" + info.name +
-                            "' v" + std::to_string(info.version) +
-                            " from " + info.file_path);
-        auto pool = std::make_shared<EnginePool>(
-            info.file_path, pool_size_, profiling_);
+        if (loader) {
+            load(info, is_pinned, *loading);
+        } else if (!loading) {
+            loading = load_async(info, is_pinned);
+        }
+        if (timeout.count() > 0 &&
+            loading->pool.wait_for(timeout) != std::future_status::ready) {
+            throw ServerException("Model '" + info.name + "' v" +
+                                  std::to_string(info.version) +
+                                  " is still loading",
+                                  ErrorCode::MODEL_LOADING);
+        }
+        return loading->pool.get();
+    }
 
+    // Start a background load unless the model-version is already loaded
+    // or loading; the result completes when it is in the cache
+    std::shared_ptr<Loading> load_async(const ModelVersionInfo& info,
+                                        const PinnedFn& is_pinned,
+                                        bool prefetch = false) {
+        CacheKey key{info.name, info.version};
+        std::shared_ptr<Loading> loading;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            // Double-check: another thread may have loaded it
-            auto it = pools_.find(key);
-            if (it != pools_.end()) {
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
                 touch(key);
-                return it->second;
+                auto ready = std::make_shared<Loading>();
+                ready->result.set_value(serving_pool_locked(it->second));
+                ready->signal.set_value();
+                return ready;
             }
-
-            // Evict if at capacity
-            while (pools_.size() >= max_loaded_ && !lru_order_.empty()) {
-                evict_lru(is_pinned);
+            auto in_flight = loading_.find(key);
+            if (in_flight != loading_.end()) {
+                return in_flight->second;
             }
-
-            pools_[key] = pool;
-            lru_order_.push_front(key);
-            lru_map_[key] = lru_order_.begin();
+            loading = begin_load_locked(key);
+        }
+        if (prefetch) {
+            prefetches_.fetch_add(1, std::memory_order_relaxed);
         }
 
-        TITANINFER_LOG_INFO("Loaded model '" + info.name +
-                            "' v" + std::to_string(info.version) +
-                            " (pool size: " + std::to_string(pool_size_) + ")");
-        return pool;
+        auto queued = loader_->try_submit(
+            TaskOptions{TaskPriority::BACKGROUND},
+            [this, info, is_pinned, loading] {
+                load(info, is_pinned, *loading);
+            });
+        if (!queued) {
+            load(info, is_pinned, *loading);  // loader backlog full
+        }
+        return loading;
     }
 
     void evict(const CacheKey& key) {
@@ -213,23 +694,221 @@ public:
             lru_order_.erase(map_it->second);
             lru_map_.erase(map_it);
         }
-        pools_.erase(key);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            loaded_bytes_ -= it->second.bytes;
+            entries_.erase(it);
+        }
         TITANINFER_LOG_INFO("Evicted model '" + key.first +
                             "' v" + std::to_string(key.second));
     }
 
-    void replace(const CacheKey& key, std::shared_ptr<EnginePool> pool) {
+    // Install a reloaded pool; its access history carries over. With a
+    // nonzero ramp, requests move to it gradually: each picks the new pool
+    // with probability elapsed / ramp. The cache then drops the old pool,
+    // which is freed once the requests still holding it return their leases.
+    void replace(const CacheKey& key, std::shared_ptr<EnginePool> pool,
+                 double load_ms, std::chrono::milliseconds ramp) {
         std::lock_guard<std::mutex> lock(mutex_);
-        pools_[key] = std::move(pool);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            insert_locked(key, std::move(pool), load_ms);
+            return;
+        }
+        Entry& entry = it->second;
+        if (entry.next) {
+            finish_ramp_locked(entry);  // a previous reload is still ramping
+        }
+        const size_t bytes = pool->memory_bytes();
+        known_bytes_[key] = bytes;
+        entry.load_ms = load_ms;
+        if (ramp.count() > 0) {
+            entry.next = std::move(pool);
+            entry.next_bytes = bytes;
+            entry.ramp_start = std::chrono::steady_clock::now();
+            entry.ramp = ramp;
+            entry.bytes += bytes;
+            loaded_bytes_ += bytes;
+        } else {
+            loaded_bytes_ = loaded_bytes_ - entry.bytes + bytes;
+            entry.bytes = bytes;
+            entry.pool = std::move(pool);
+        }
         touch(key);
     }
 
+    // Newest pool of `key` (the ramping one, if any), without counting a hit
+    PoolPtr peek(const CacheKey& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return nullptr;
+        return it->second.next ? it->second.next : it->second.pool;
+    }
+
     size_t loaded_count() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return pools_.size();
+        return entries_.size();
+    }
+
+    size_t loaded_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loaded_bytes_;
+    }
+
+    // Every loaded pool, a reload's replacement included
+    std::vector<PoolPtr> loaded_pools() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<PoolPtr> pools;
+        pools.reserve(entries_.size());
+        for (const auto& pair : entries_) {
+            pools.push_back(pair.second.pool);
+            if (pair.second.next) pools.push_back(pair.second.next);
+        }
+        return pools;
+    }
+
+    std::vector<CacheKey> loaded_keys() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<CacheKey> keys;
+        keys.reserve(entries_.size());
+        for (const auto& pair : entries_) {
+            keys.push_back(pair.first);
+        }
+        return keys;
+    }
+
+    // Size of the last pool loaded for `key` (0 if never loaded)
+    size_t known_bytes(const CacheKey& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = known_bytes_.find(key);
+        return it == known_bytes_.end() ? 0 : it->second;
+    }
+
+    // True if a model of `bytes` can be loaded without evicting anything
+    bool has_room(size_t bytes) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size() + loading_.size() < max_loaded_ &&
+               (max_bytes_ == 0 || loaded_bytes_ + bytes <= max_bytes_);
+    }
+
+    CacheStats stats() const noexcept {
+        CacheStats result;
+        result.hits = hits_.load(std::memory_order_relaxed);
+        result.misses = misses_.load(std::memory_order_relaxed);
+        result.prefetches = prefetches_.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    uint64_t cold_load_count() const noexcept {
+        return cold_loads_.load(std::memory_order_relaxed);
     }
 
 private:
+    std::shared_ptr<Loading> begin_load_locked(const CacheKey& key) {
+        auto loading = std::make_shared<Loading>();
+        loading_[key] = loading;
+        return loading;
+    }
+
+    // Load outside the lock (slow I/O), publish, then wake every waiter
+    void load(const ModelVersionInfo& info, const PinnedFn& is_pinned,
+              Loading& loading) {
+        CacheKey key{info.name, info.version};
+        TITANINFER_LOG_INFO("Loading model '" + info.name +
+                            "' v" + std::to_string(info.version) +
+                            " from " + info.file_path);
+        cold_loads_.fetch_add(1, std::memory_order_relaxed);
+
+        PoolPtr pool;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            pool = make_pool(info.file_path, key);
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                loading_.erase(key);
+            }
+            loading.result.set_exception(std::current_exception());
+            loading.signal.set_exception(std::current_exception());
+            return;
+        }
+
+        double load_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end()) {
+                // A hot reload installed a newer pool meanwhile
+                pool = serving_pool_locked(it->second);
+                touch(key);
+            } else {
+                make_room_locked(pool->memory_bytes(), is_pinned);
+                insert_locked(key, pool, load_ms);
+            }
+            loading_.erase(key);
+        }
+
+        TITANINFER_LOG_INFO("Loaded model '" + info.name +
+                            "' v" + std::to_string(info.version) +
+                            " (pool size: " + std::to_string(pool_size_) +
+                            (pool->batched() ? ", batched" : "") + ")");
+        loading.result.set_value(std::move(pool));
+        loading.signal.set_value();
+    }
+
+    struct Entry {
+        PoolPtr pool;
+        size_t bytes = 0;       // both pools while ramping
+        double load_ms = 0.0;   // measured reload cost
+        uint64_t hits = 0;
+        double priority = 0.0;  // GDSF: clock + hits * load_ms / bytes
+
+        // Hot reload in progress: traffic shifts from `pool` to `next`
+        PoolPtr next;
+        size_t next_bytes = 0;
+        std::chrono::steady_clock::time_point ramp_start;
+        std::chrono::milliseconds ramp{0};
+    };
+
+    PoolPtr serving_pool_locked(Entry& entry) {
+        if (!entry.next) {
+            return entry.pool;
+        }
+        double progress = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - entry.ramp_start).count() /
+            static_cast<double>(entry.ramp.count());
+        if (progress >= 1.0) {
+            finish_ramp_locked(entry);
+            return entry.pool;
+        }
+        thread_local std::mt19937 rng(std::random_device{}());
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        return dist(rng) < progress ? entry.next : entry.pool;
+    }
+
+    void finish_ramp_locked(Entry& entry) {
+        loaded_bytes_ -= entry.bytes - entry.next_bytes;
+        entry.bytes = entry.next_bytes;
+        entry.pool = std::move(entry.next);
+        entry.next.reset();
+        entry.next_bytes = 0;
+    }
+
+    void insert_locked(const CacheKey& key, PoolPtr pool, double load_ms) {
+        Entry entry;
+        entry.bytes = pool->memory_bytes();
+        entry.load_ms = load_ms;
+        entry.pool = std::move(pool);
+        loaded_bytes_ += entry.bytes;
+        known_bytes_[key] = entry.bytes;
+        entries_[key] = std::move(entry);
+        lru_order_.push_front(key);
+        lru_map_[key] = lru_order_.begin();
+        touch(key);
+    }
+
     void touch(const CacheKey& key) {
         auto it = lru_map_.find(key);
         if (it != lru_map_.end()) {
@@ -237,148 +916,767 @@ private:
             lru_order_.push_front(key);
             it->second = lru_order_.begin();
         }
+        auto entry = entries_.find(key);
+        if (entry != entries_.end()) {
+            Entry& e = entry->second;
+            ++e.hits;
+            e.priority = clock_ + static_cast<double>(e.hits) *
+                std::max(e.load_ms, 1e-3) /
+                static_cast<double>(std::max<size_t>(e.bytes, 1));
+        }
+    }
+
+    // Evict until the count and byte budget admit `incoming` more bytes
+    void make_room_locked(size_t incoming, const PinnedFn& is_pinned) {
+        while (!entries_.empty() &&
+               (entries_.size() >= max_loaded_ ||
+                (max_bytes_ > 0 && loaded_bytes_ + incoming > max_bytes_))) {
+            if (!evict_one_locked(is_pinned)) {
+                break;
+            }
+        }
+        if (max_bytes_ > 0 && loaded_bytes_ + incoming > max_bytes_) {
+            TITANINFER_LOG_WARNING("Model cache over its byte budget: " +
+                                   std::to_string(loaded_bytes_ + incoming) +
+                                   " > " + std::to_string(max_bytes_));
+        }
     }
 
-    void evict_lru(const std::function<bool(const CacheKey&)>& is_pinned) {
-        // Walk from back (least recently used) to find an evictable entry
+    // Returns false if every loaded model is pinned
+    bool evict_one_locked(const PinnedFn& is_pinned) {
+        // Walk from back (least recently used); GDSF ties go to the oldest
+        auto victim = lru_order_.end();
+        double lowest = std::numeric_limits<double>::infinity();
         for (auto rit = lru_order_.rbegin(); rit != lru_order_.rend(); ++rit) {
-            if (!is_pinned(*rit)) {
-                CacheKey victim = *rit;
-                lru_map_.erase(victim);
-                lru_order_.erase(std::next(rit).base());
-                pools_.erase(victim);
-                TITANINFER_LOG_INFO("LRU evicted model '" + victim.first +
-                                    "' v" + std::to_string(victim.second));
-                return;
+            if (is_pinned(*rit)) continue;
+            if (policy_ == EvictionPolicy::LRU) {
+                victim = std::next(rit).base();
+                break;
+            }
+            double priority = entries_.at(*rit).priority;
+            if (priority < lowest) {
+                lowest = priority;
+                victim = std::next(rit).base();
             }
         }
-        // All models are pinned — cannot evict
-        TITANINFER_LOG_WARNING("Cannot evict: all loaded models are pinned");
+        if (victim == lru_order_.end()) {
+            // All models are pinned — cannot evict
+            TITANINFER_LOG_WARNING("Cannot evict: all loaded models are pinned");
+            return false;
+        }
+        if (policy_ == EvictionPolicy::GDSF) {
+            clock_ = lowest;
+        }
+
+        CacheKey key = *victim;
+        lru_map_.erase(key);
+        lru_order_.erase(victim);
+        loaded_bytes_ -= entries_.at(key).bytes;
+        entries_.erase(key);
+        TITANINFER_LOG_INFO("Evicted model '" + key.first +
+                            "' v" + std::to_string(key.second) +
+                            " to make room");
+        return true;
     }
 
     size_t max_loaded_;
+    size_t max_bytes_;
+    EvictionPolicy policy_;
     size_t pool_size_;
     bool profiling_;
+    std::vector<ModelBatchingConfig> batching_;
+    size_t replay_capacity_;
+    ElasticPoolConfig elastic_;
+    std::shared_ptr<TensorPool> tensors_;
 
     std::list<CacheKey> lru_order_;
     std::unordered_map<CacheKey, std::list<CacheKey>::iterator, CacheKeyHash> lru_map_;
-    std::unordered_map<CacheKey, std::shared_ptr<EnginePool>, CacheKeyHash> pools_;
+    std::unordered_map<CacheKey, Entry, CacheKeyHash> entries_;
+    size_t loaded_bytes_ = 0;
+    double clock_ = 0.0;    // GDSF inflation value
+    std::unordered_map<CacheKey, std::shared_ptr<Loading>, CacheKeyHash> loading_;
+    std::unordered_map<CacheKey, size_t, CacheKeyHash> known_bytes_;
+    std::atomic<uint64_t> cold_loads_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> prefetches_{0};
     mutable std::mutex mutex_;
+    // Last member: its destructor finishes queued loads while the maps live
+    std::unique_ptr<ThreadPool> loader_;
 };
 
 // ---------------------------------------------------------------------------
-// RateLimiter — token bucket per tenant
+// RateLimiter — per-tenant QPS and concurrency quotas
+//
+// Tenants are spread over shards by hash. Each shard publishes an immutable
+// sorted table of (hash, tenant, state); requests find their tenant by
+// binary search without locking, and quota changes copy the table, swap it
+// in and free the old one after a grace period (two-epoch RCU). A tenant's
+// token bucket is one atomic word holding the time at which the bucket
+// would be full again (GCRA form), so tokens and refill time are updated
+// together by a single CAS.
 // ---------------------------------------------------------------------------
 class RateLimiter {
 public:
+    RateLimiter() {
+        for (auto& shard : shards_) {
+            shard.table.store(new Table(), std::memory_order_relaxed);
+        }
+    }
+
+    ~RateLimiter() {
+        for (auto& shard : shards_) {
+            delete shard.table.load(std::memory_order_relaxed);
+        }
+    }
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
     void set_quota(const std::string& tenant_id, const TenantQuota& quota) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto& state = tenants_[tenant_id];
-        state.quota = quota;
-        state.tokens = quota.max_qps;
-        state.last_refill = std::chrono::steady_clock::now();
-        state.concurrent.store(0, std::memory_order_relaxed);
+        size_t hash = std::hash<std::string>{}(tenant_id);
+        auto state = std::make_shared<TenantState>(quota);
+        update(hash, [&](std::vector<Slot>& slots) {
+            auto it = find_slot(slots, hash, tenant_id);
+            if (it != slots.end()) {
+                it->state = std::move(state);
+            } else {
+                auto pos = std::lower_bound(
+                    slots.begin(), slots.end(), hash,
+                    [](const Slot& slot, size_t h) { return slot.hash < h; });
+                slots.insert(pos, Slot{hash, tenant_id, std::move(state)});
+            }
+        });
     }
 
     void remove_quota(const std::string& tenant_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        tenants_.erase(tenant_id);
+        size_t hash = std::hash<std::string>{}(tenant_id);
+        update(hash, [&](std::vector<Slot>& slots) {
+            auto it = find_slot(slots, hash, tenant_id);
+            if (it != slots.end()) {
+                slots.erase(it);
+            }
+        });
     }
 
     // Returns true if request is allowed
     bool try_acquire(const std::string& tenant_id) {
         if (tenant_id.empty()) return true;
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = tenants_.find(tenant_id);
-        if (it == tenants_.end()) return true; // No quota = unlimited
-
-        auto& state = it->second;
-        refill_tokens(state);
-
-        if (state.tokens < 1.0) return false;
-
-        if (state.concurrent.load(std::memory_order_relaxed) >=
-            state.quota.max_concurrent) {
+        size_t hash = std::hash<std::string>{}(tenant_id);
+        Shard& shard = shard_for(hash);
+        ReadGuard guard(shard);
+        TenantState* state = find(*guard.table, hash, tenant_id);
+        if (!state) return true; // No quota = unlimited
+
+        // Claim a concurrency slot first: it is the cheaper one to give back
+        size_t running = state->concurrent.load(std::memory_order_relaxed);
+        do {
+            if (running >= state->max_concurrent) return false;
+        } while (!state->concurrent.compare_exchange_weak(
+            running, running + 1, std::memory_order_relaxed));
+
+        if (!state->take_token()) {
+            state->concurrent.fetch_sub(1, std::memory_order_relaxed);
             return false;
         }
-
-        state.tokens -= 1.0;
-        state.concurrent.fetch_add(1, std::memory_order_relaxed);
         return true;
     }
 
     void release(const std::string& tenant_id) {
         if (tenant_id.empty()) return;
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = tenants_.find(tenant_id);
-        if (it != tenants_.end()) {
-            auto val = it->second.concurrent.load(std::memory_order_relaxed);
-            if (val > 0) {
-                it->second.concurrent.fetch_sub(1, std::memory_order_relaxed);
-            }
+        size_t hash = std::hash<std::string>{}(tenant_id);
+        Shard& shard = shard_for(hash);
+        ReadGuard guard(shard);
+        TenantState* state = find(*guard.table, hash, tenant_id);
+        if (!state) return;
+
+        // The quota may have been replaced while the request ran; never
+        // drop the new state's counter below zero
+        size_t running = state->concurrent.load(std::memory_order_relaxed);
+        while (running > 0 && !state->concurrent.compare_exchange_weak(
+                   running, running - 1, std::memory_order_relaxed)) {
         }
     }
 
 private:
-    struct TenantState {
-        TenantQuota quota;
-        double tokens = 0.0;
-        std::chrono::steady_clock::time_point last_refill;
+    static constexpr size_t NUM_SHARDS = 16;
+    static constexpr int64_t BURST_NS = 1'000'000'000;  // one second of QPS
+
+    struct alignas(64) TenantState {
+        explicit TenantState(const TenantQuota& quota)
+            : max_concurrent(quota.max_concurrent),
+              interval_ns(quota.max_qps > 0.0
+                  ? static_cast<int64_t>(std::llround(1e9 / quota.max_qps))
+                  : std::numeric_limits<int64_t>::max()) {}
+
+        // GCRA: `full_at` is when the bucket would hold max_qps tokens again.
+        // A request costs one interval; it is admitted if the bucket, after
+        // paying, is no more than BURST_NS away from full. A fresh state is
+        // full (full_at = 0), like the old bucket starting at max_qps tokens.
+        bool take_token() {
+            if (interval_ns > BURST_NS) return false;  // max_qps < 1
+            int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            int64_t full_at = tat.load(std::memory_order_relaxed);
+            for (;;) {
+                int64_t next = std::max(full_at, now) + interval_ns;
+                if (next - now > BURST_NS) return false;
+                if (tat.compare_exchange_weak(full_at, next,
+                                              std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+        }
+
+        const size_t max_concurrent;
+        const int64_t interval_ns;
+        std::atomic<int64_t> tat{0};
         std::atomic<size_t> concurrent{0};
     };
 
-    void refill_tokens(TenantState& state) {
-        auto now = std::chrono::steady_clock::now();
-        double elapsed = std::chrono::duration<double>(
-            now - state.last_refill).count();
-        state.tokens = std::min(state.quota.max_qps,
-                                state.tokens + elapsed * state.quota.max_qps);
-        state.last_refill = now;
+    struct Slot {
+        size_t hash = 0;
+        std::string tenant;
+        std::shared_ptr<TenantState> state;
+    };
+
+    struct Table {
+        std::vector<Slot> slots;  // sorted by hash
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<const Table*> table{nullptr};
+        std::atomic<uint32_t> epoch{0};
+        std::array<std::atomic<uint32_t>, 2> readers{};
+        std::mutex write_mutex;  // serializes writers only
+    };
+
+    // Read-side critical section: the table (and every state in it) stays
+    // alive until the guard is destroyed
+    struct ReadGuard {
+        explicit ReadGuard(Shard& s)
+            : shard(s),
+              parity(s.epoch.load(std::memory_order_seq_cst) & 1u) {
+            shard.readers[parity].fetch_add(1, std::memory_order_seq_cst);
+            table = shard.table.load(std::memory_order_seq_cst);
+        }
+        ~ReadGuard() {
+            shard.readers[parity].fetch_sub(1, std::memory_order_release);
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        Shard& shard;
+        uint32_t parity;
+        const Table* table = nullptr;
+    };
+
+    Shard& shard_for(size_t hash) {
+        return shards_[((hash >> 32) ^ hash) % NUM_SHARDS];
+    }
+
+    template <typename Slots>
+    static auto find_slot(Slots& slots, size_t hash, const std::string& tenant)
+        -> decltype(slots.begin()) {
+        auto it = std::lower_bound(
+            slots.begin(), slots.end(), hash,
+            [](const Slot& slot, size_t h) { return slot.hash < h; });
+        for (; it != slots.end() && it->hash == hash; ++it) {
+            if (it->tenant == tenant) return it;
+        }
+        return slots.end();
     }
 
-    std::unordered_map<std::string, TenantState> tenants_;
-    std::mutex mutex_;
+    static TenantState* find(const Table& table, size_t hash,
+                             const std::string& tenant) {
+        auto it = find_slot(table.slots, hash, tenant);
+        return it == table.slots.end() ? nullptr : it->state.get();
+    }
+
+    // Copy the shard's table, edit the copy, publish it, then wait until no
+    // reader can still hold the old table before freeing it
+    template <typename Edit>
+    void update(size_t hash, Edit edit) {
+        Shard& shard = shard_for(hash);
+        std::lock_guard<std::mutex> lock(shard.write_mutex);
+        const Table* old = shard.table.load(std::memory_order_relaxed);
+        auto next = std::make_unique<Table>(*old);
+        edit(next->slots);
+        shard.table.store(next.release(), std::memory_order_seq_cst);
+
+        // Flip the epoch twice, draining the readers of each parity: a
+        // reader that picked either counter before the swap has left
+        for (int flip = 0; flip < 2; ++flip) {
+            uint32_t parity = shard.epoch.fetch_add(
+                1, std::memory_order_seq_cst) & 1u;
+            while (shard.readers[parity].load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+        delete old;
+    }
+
+    std::array<Shard, NUM_SHARDS> shards_;
 };
 
 // ---------------------------------------------------------------------------
-// TrafficSplitter — weighted random version selection
+// TrafficSplitter — weighted version selection
+//
+// The rules of every model live in one immutable snapshot that readers load
+// with a single atomic shared_ptr read; updates copy the snapshot and publish
+// the copy. Each model's split is precomputed into an alias table (Vose), so
+// picking a version is one uniform draw and one comparison regardless of the
+// number of rules. Sticky models derive the draw from a hash of the tenant or
+// request ID instead of the RNG.
 // ---------------------------------------------------------------------------
 class TrafficSplitter {
 public:
     void set_rules(const std::string& model_name,
-                   const std::vector<TrafficRule>& rules) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        rules_[model_name] = rules;
+                   const std::vector<TrafficRule>& rules,
+                   StickyRouting sticky) {
+        auto split = std::make_shared<const Split>(rules, sticky);
+        update([&](Rules& all) { all[model_name] = std::move(split); });
     }
 
     void remove_rules(const std::string& model_name) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        rules_.erase(model_name);
+        update([&](Rules& all) { all.erase(model_name); });
     }
 
     // Returns 0 if no rules set (caller should use default routing)
-    uint32_t select_version(const std::string& model_name) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = rules_.find(model_name);
-        if (it == rules_.end() || it->second.empty()) return 0;
+    uint32_t select_version(const std::string& model_name,
+                            const std::string& tenant_id,
+                            const std::string& request_id) const {
+        auto snapshot = rules_.load(std::memory_order_acquire);
+        auto it = snapshot->find(model_name);
+        if (it == snapshot->end() || it->second->versions.empty()) return 0;
+        const Split& split = *it->second;
+
+        const std::string* key = nullptr;
+        if (split.sticky == StickyRouting::TENANT) key = &tenant_id;
+        if (split.sticky == StickyRouting::REQUEST_ID) key = &request_id;
+
+        uint64_t draw;
+        if (key && !key->empty()) {
+            draw = mix(std::hash<std::string>{}(*key));
+        } else {
+            thread_local std::mt19937_64 rng(std::random_device{}());
+            draw = rng();
+        }
+        return split.pick(draw);
+    }
 
-        thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        double r = dist(rng);
+private:
+    // Alias table over the rules of one model
+    struct Split {
+        Split(const std::vector<TrafficRule>& rules, StickyRouting mode)
+            : sticky(mode)
+        {
+            double total = 0.0;
+            for (const auto& rule : rules) {
+                if (rule.weight > 0.0) total += rule.weight;
+            }
+            if (total <= 0.0) return;  // nothing routable: default routing
+
+            const size_t n = rules.size();
+            versions.reserve(n);
+            std::vector<double> scaled(n);
+            for (size_t i = 0; i < n; ++i) {
+                versions.push_back(rules[i].version);
+                scaled[i] = std::max(rules[i].weight, 0.0) *
+                            static_cast<double>(n) / total;
+            }
+
+            accept.assign(n, 1.0);
+            alias.resize(n);
+            std::vector<size_t> small, large;
+            for (size_t i = 0; i < n; ++i) {
+                alias[i] = i;
+                (scaled[i] < 1.0 ? small : large).push_back(i);
+            }
+            while (!small.empty() && !large.empty()) {
+                size_t s = small.back();
+                small.pop_back();
+                size_t l = large.back();
+                accept[s] = scaled[s];
+                alias[s] = l;
+                scaled[l] -= 1.0 - scaled[s];
+                if (scaled[l] < 1.0) {
+                    large.pop_back();
+                    small.push_back(l);
+                }
+            }
+            // Leftovers are 1.0 up to rounding; keep them whole
+        }
+
+        // High bits choose the column, low bits the coin
+        uint32_t pick(uint64_t draw) const {
+            size_t column = static_cast<size_t>(
+                ((draw >> 32) * versions.size()) >> 32);
+            double coin = static_cast<double>(draw & 0xffffffffu) * 0x1p-32;
+            return versions[coin < accept[column] ? column : alias[column]];
+        }
+
+        StickyRouting sticky;
+        std::vector<uint32_t> versions;
+        std::vector<double> accept;
+        std::vector<size_t> alias;
+    };
+
+    using Rules = std::unordered_map<std::string, std::shared_ptr<const Split>>;
+
+    // splitmix64 finalizer: spreads std::hash output over all 64 bits
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    template <typename Edit>
+    void update(Edit edit) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        auto next = std::make_shared<Rules>(*rules_.load(std::memory_order_relaxed));
+        edit(*next);
+        rules_.store(std::move(next), std::memory_order_release);
+    }
+
+    std::atomic<std::shared_ptr<const Rules>> rules_{std::make_shared<const Rules>()};
+    std::mutex write_mutex_;  // serializes writers only
+};
+
+// ---------------------------------------------------------------------------
+// AdmissionController — CoDel shedding of the async path
+//
+// Each model has one ModelQueue running the CoDel control law on the
+// sojourn times workers report at dequeue. Once sojourns have stayed above
+// the target for a whole interval (a standing queue), the queue enters the
+// dropping state: it drops one request, then the next at
+// interval / sqrt(drops) after the previous one, serving the requests in
+// between, and leaves the state as soon as a sojourn falls below the
+// target. A scheduled drop may be taken by an arrival instead, which spares
+// queueing a request only to drop it. A request dequeued with nothing
+// behind it never counts as a standing queue, and an empty queue always
+// admits, so an idle model cannot stay shut.
+// ---------------------------------------------------------------------------
+class AdmissionController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class ModelQueue {
+    public:
+        ModelQueue(int64_t target_ns, int64_t interval_ns)
+            : target_ns_(target_ns), interval_ns_(interval_ns) {}
+
+        // Arrival: false rejects the request; true must be paired with
+        // on_dequeue() or abandon()
+        bool try_admit() {
+            if (queued_.load(std::memory_order_relaxed) > 0 &&
+                dropping_.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (take_scheduled_drop(Clock::now().time_since_epoch().count())) {
+                    shed_on_arrival_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            queued_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Admitted request that never made it into the executor queue
+        void abandon() { queued_.fetch_sub(1, std::memory_order_relaxed); }
+
+        // A worker picked the request up: false drops it
+        bool on_dequeue(Clock::time_point enqueued) {
+            auto now = Clock::now();
+            int64_t sojourn = (now - enqueued).count();
+            int64_t now_ns = now.time_since_epoch().count();
+            bool standing = queued_.fetch_sub(1, std::memory_order_relaxed) > 1;
+            last_sojourn_.store(sojourn, std::memory_order_relaxed);
+
+            bool drop = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                bool above = false;
+                if (sojourn < target_ns_ || !standing) {
+                    first_above_ns_ = 0;
+                } else if (first_above_ns_ == 0) {
+                    first_above_ns_ = now_ns + interval_ns_;
+                } else {
+                    above = now_ns >= first_above_ns_;
+                }
+
+                if (dropping_.load(std::memory_order_relaxed)) {
+                    if (!above) {
+                        dropping_.store(false, std::memory_order_relaxed);
+                    } else {
+                        drop = take_scheduled_drop(now_ns);
+                    }
+                } else if (above) {
+                    // Re-entering soon after the last episode resumes near
+                    // its drop rate rather than starting over
+                    uint32_t delta = drop_count_ - last_count_;
+                    drop_count_ = delta > 1 &&
+                                  now_ns - drop_next_ns_ < 16 * interval_ns_
+                        ? delta : 1;
+                    last_count_ = drop_count_;
+                    drop_next_ns_ = now_ns + control_law(drop_count_);
+                    dropping_.store(true, std::memory_order_relaxed);
+                    drop = true;
+                }
+            }
+
+            if (drop) {
+                shed_in_queue_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            admitted_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        AdmissionStats stats() const {
+            AdmissionStats out;
+            out.admitted = admitted_.load(std::memory_order_relaxed);
+            out.shed_on_arrival = shed_on_arrival_.load(std::memory_order_relaxed);
+            out.shed_in_queue = shed_in_queue_.load(std::memory_order_relaxed);
+            out.queued = static_cast<size_t>(std::max<int64_t>(
+                0, queued_.load(std::memory_order_relaxed)));
+            out.overloaded = dropping_.load(std::memory_order_relaxed);
+            out.last_sojourn_ms = static_cast<double>(
+                last_sojourn_.load(std::memory_order_relaxed)) / 1e6;
+            return out;
+        }
+
+    private:
+        int64_t control_law(uint32_t count) const {
+            return static_cast<int64_t>(static_cast<double>(interval_ns_) /
+                                        std::sqrt(static_cast<double>(count)));
+        }
 
-        double cumulative = 0.0;
-        for (const auto& rule : it->second) {
-            cumulative += rule.weight;
-            if (r <= cumulative) return rule.version;
+        // In the dropping state: whether the next scheduled drop is due,
+        // scheduling the one after it if so. Caller holds mutex_.
+        bool take_scheduled_drop(int64_t now_ns) {
+            if (!dropping_.load(std::memory_order_relaxed) ||
+                now_ns < drop_next_ns_) {
+                return false;
+            }
+            ++drop_count_;
+            drop_next_ns_ += control_law(drop_count_);
+            return true;
         }
-        return it->second.back().version;
+
+        const int64_t target_ns_;
+        const int64_t interval_ns_;
+        std::mutex mutex_;                // guards the control-law state
+        int64_t first_above_ns_ = 0;      // when above-target becomes a standing queue
+        int64_t drop_next_ns_ = 0;
+        uint32_t drop_count_ = 0;
+        uint32_t last_count_ = 0;
+        std::atomic<bool> dropping_{false};
+        std::atomic<int64_t> last_sojourn_{0};
+        std::atomic<int64_t> queued_{0};
+        std::atomic<uint64_t> admitted_{0};
+        std::atomic<uint64_t> shed_on_arrival_{0};
+        std::atomic<uint64_t> shed_in_queue_{0};
+    };
+
+    explicit AdmissionController(const AdmissionConfig& config)
+        : config_(config) {}
+
+    // nullptr when admission control is disabled
+    ModelQueue* queue(const std::string& model_name) {
+        if (!config_.enabled) return nullptr;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = queues_.find(model_name);
+            if (it != queues_.end()) return it->second.get();
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto& slot = queues_[model_name];
+        if (!slot) {
+            slot = std::make_unique<ModelQueue>(
+                to_ns(config_.target_delay_ms),
+                to_ns(std::max<size_t>(config_.interval_ms, 1)));
+        }
+        return slot.get();
+    }
+
+    AdmissionStats stats(const std::string& model_name) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = queues_.find(model_name);
+        return it == queues_.end() ? AdmissionStats{} : it->second->stats();
     }
 
+    size_t retry_after_s() const { return config_.retry_after_s; }
+
 private:
-    std::unordered_map<std::string, std::vector<TrafficRule>> rules_;
-    std::mutex mutex_;
+    static int64_t to_ns(size_t ms) {
+        return static_cast<int64_t>(ms) * 1'000'000;
+    }
+
+    AdmissionConfig config_;
+    // Queues are never removed, so handed-out pointers stay valid
+    std::unordered_map<std::string, std::unique_ptr<ModelQueue>> queues_;
+    mutable std::shared_mutex mutex_;
+};
+
+// ---------------------------------------------------------------------------
+// SingleFlight — coalescing of identical in-flight predictions
+//
+// The first request for an input on a model version leads a flight and
+// runs inference; identical requests arriving before it lands follow it
+// and wait for its output instead of leasing an engine of their own. A
+// flight leaves the table before it lands, so its follower count is final
+// by then: the output is shared (as one immutable copy) only if somebody
+// is waiting. Followers wait within their own limits, and re-run by
+// themselves if the leader was stopped by its limits.
+// ---------------------------------------------------------------------------
+class SingleFlight {
+public:
+    static constexpr size_t NUM_SHARDS = 16;
+    static constexpr std::chrono::milliseconds CANCEL_POLL{2};
+
+    struct Key {
+        uint32_t version;
+        uint64_t pool_id;
+        uint64_t hash;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    template <typename Infer>
+    Tensor run(const Key& key, const Tensor& input,
+               const ExecutionLimits& limits, TensorPool& tensors,
+               Infer infer, bool& coalesced) {
+        Shard& shard = shards_[(key.hash >> 40) % NUM_SHARDS];
+        std::shared_ptr<Flight> flight;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.flights.find(key);
+            if (it == shard.flights.end()) {
+                flight = std::make_shared<Flight>(&input);
+                shard.flights.emplace(key, flight);
+                leader = true;
+            } else if (same_input(*it->second->input, input)) {
+                flight = it->second;
+                ++flight->followers;
+            }
+        }
+        if (!flight) {
+            return infer();  // hash collision with a different input
+        }
+
+        if (leader) {
+            leaders_.fetch_add(1, std::memory_order_relaxed);
+            Tensor output = [&] {
+                try {
+                    return infer();
+                } catch (...) {
+                    land(shard, key, *flight, nullptr,
+                         std::current_exception());
+                    throw;
+                }
+            }();
+            land(shard, key, *flight, &output, nullptr);
+            return output;
+        }
+
+        coalesced = true;
+        coalesced_.fetch_add(1, std::memory_order_relaxed);
+        wait(flight->result, limits);
+        try {
+            return tensors.copy_of(*flight->result.get());
+        } catch (const TitanInferException& e) {
+            if (e.error_code() != ErrorCode::DEADLINE_EXCEEDED &&
+                e.error_code() != ErrorCode::CANCELLED) {
+                throw;
+            }
+        }
+        // The leader's deadline or cancellation is not ours
+        reruns_.fetch_add(1, std::memory_order_relaxed);
+        coalesced = false;
+        return infer();
+    }
+
+    CoalescingStats stats() const {
+        CoalescingStats out;
+        out.leaders = leaders_.load(std::memory_order_relaxed);
+        out.coalesced = coalesced_.load(std::memory_order_relaxed);
+        out.reruns = reruns_.load(std::memory_order_relaxed);
+        return out;
+    }
+
+private:
+    struct Flight {
+        explicit Flight(const Tensor* leader_input)
+            : input(leader_input), result(promise.get_future().share()) {}
+
+        const Tensor* input;  // the leader's; valid while in the table
+        size_t followers = 0;
+        std::promise<std::shared_ptr<const Tensor>> promise;
+        std::shared_future<std::shared_ptr<const Tensor>> result;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            return static_cast<size_t>(
+                key.hash ^ (key.pool_id * 0x9E3779B97F4A7C15ull) ^ key.version);
+        }
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<Key, std::shared_ptr<Flight>, KeyHash> flights;
+    };
+
+    static bool same_input(const Tensor& a, const Tensor& b) {
+        return a.shape() == b.shape() &&
+               std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+    }
+
+    static void wait(const std::shared_future<std::shared_ptr<const Tensor>>& result,
+                     const ExecutionLimits& limits) {
+        if (!limits.active()) {
+            result.wait();
+            return;
+        }
+        for (;;) {
+            limits.check("SingleFlight: waiting for an identical request");
+            auto until = limits.cancellation.cancellable()
+                ? std::min(limits.deadline,
+                           std::chrono::steady_clock::now() + CANCEL_POLL)
+                : limits.deadline;
+            if (result.wait_until(until) == std::future_status::ready) {
+                return;
+            }
+        }
+    }
+
+    // Retire the flight, then hand followers the output or the error
+    static void land(Shard& shard, const Key& key, Flight& flight,
+                     const Tensor* output, std::exception_ptr error) {
+        size_t followers = 0;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.flights.erase(key);
+            followers = flight.followers;
+        }
+        if (error) {
+            flight.promise.set_exception(error);
+        } else {
+            flight.promise.set_value(
+                followers > 0 ? std::make_shared<const Tensor>(*output)
+                              : nullptr);
+        }
+    }
+
+    std::array<Shard, NUM_SHARDS> shards_;
+    std::atomic<uint64_t> leaders_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> reruns_{0};
 };
 
 // ---------------------------------------------------------------------------
@@ -420,42 +1718,598 @@ ParsedRoute parse_path(const std::string& path) {
         result.valid = true;
     }
 
-    return result;
-}
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Degrader — load-triggered fallback of one model to a faster version
+//
+// Every default-routed request of the model feeds two smoothed signals:
+// its queueing delay (submission to start; 0 for synchronous calls) and
+// the predictions running per worker thread. The first request to see a
+// signal above its enter threshold switches the model to its fallback.
+// Once both are under their exit thresholds and the dwell time since the
+// switch has passed, the next request switches it back. The gap between
+// the thresholds and the dwell time keep the model from flapping.
+// ---------------------------------------------------------------------------
+class Degrader {
+public:
+    explicit Degrader(const DegradationPolicy& policy)
+        : policy_(policy),
+          dwell_ns_(static_cast<int64_t>(policy.min_dwell_ms) * 1000000) {}
+
+    uint32_t fallback_version() const noexcept {
+        return policy_.fallback_version;
+    }
+
+    // Record one request's load; true routes it to the fallback. Pinned
+    // requests count towards the load but keep their version.
+    bool observe(std::chrono::steady_clock::time_point now, double delay_ms,
+                 double saturation, bool pinned) {
+        const double delay = smooth(delay_ms_, delay_ms);
+        const double busy = smooth(saturation_, saturation);
+        const int64_t now_ns = now.time_since_epoch().count();
+
+        bool degraded = degraded_.load(std::memory_order_relaxed);
+        if (!degraded) {
+            if (above(delay, policy_.enter_delay_ms) ||
+                above(busy, policy_.enter_saturation)) {
+                if (degraded_.compare_exchange_strong(degraded, true)) {
+                    switched_ns_.store(now_ns, std::memory_order_relaxed);
+                    degradations_.fetch_add(1, std::memory_order_relaxed);
+                    TITANINFER_LOG_WARNING(
+                        "Model '" + policy_.model_name +
+                        "' overloaded (queue delay " + std::to_string(delay) +
+                        " ms, saturation " + std::to_string(busy) +
+                        "); routing to v" +
+                        std::to_string(policy_.fallback_version));
+                }
+                degraded = true;
+            }
+        } else if (below(delay, policy_.exit_delay_ms) &&
+                   below(busy, policy_.exit_saturation) &&
+                   now_ns - switched_ns_.load(std::memory_order_relaxed) >=
+                       dwell_ns_) {
+            if (degraded_.compare_exchange_strong(degraded, false)) {
+                switched_ns_.store(now_ns, std::memory_order_relaxed);
+                recoveries_.fetch_add(1, std::memory_order_relaxed);
+                TITANINFER_LOG_INFO("Model '" + policy_.model_name +
+                                    "' recovered; default routing restored");
+            }
+            degraded = false;
+        }
+
+        if (!degraded || pinned) {
+            return false;
+        }
+        fallback_requests_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    DegradationStats stats() const {
+        DegradationStats out;
+        out.degraded = degraded_.load(std::memory_order_relaxed);
+        out.degradations = degradations_.load(std::memory_order_relaxed);
+        out.recoveries = recoveries_.load(std::memory_order_relaxed);
+        out.fallback_requests =
+            fallback_requests_.load(std::memory_order_relaxed);
+        out.queue_delay_ms = delay_ms_.load(std::memory_order_relaxed);
+        out.saturation = saturation_.load(std::memory_order_relaxed);
+        return out;
+    }
+
+private:
+    static constexpr double SMOOTHING = 0.125;  // weight of a new sample
+
+    // Exponential moving average; a racing update is lost, not torn
+    static double smooth(std::atomic<double>& average, double sample) {
+        double next = average.load(std::memory_order_relaxed);
+        next += SMOOTHING * (sample - next);
+        average.store(next, std::memory_order_relaxed);
+        return next;
+    }
+
+    static bool above(double value, double threshold) {
+        return threshold > 0.0 && value > threshold;
+    }
+
+    static bool below(double value, double threshold) {
+        return threshold <= 0.0 || value < threshold;
+    }
+
+    const DegradationPolicy policy_;
+    const int64_t dwell_ns_;
+    std::atomic<double> delay_ms_{0.0};
+    std::atomic<double> saturation_{0.0};
+    std::atomic<bool> degraded_{false};
+    std::atomic<int64_t> switched_ns_{0};
+    std::atomic<uint64_t> degradations_{0};
+    std::atomic<uint64_t> recoveries_{0};
+    std::atomic<uint64_t> fallback_requests_{0};
+};
+
+// ---------------------------------------------------------------------------
+// FairQueue — weighted deficit round robin across tenants
+//
+// Async requests wait in one FIFO per tenant instead of the thread pool's
+// shared queue, and only one request per worker is handed to the pool at
+// a time, so the choice of what runs next is made here. Whenever a worker
+// frees up, the tenant at the head of the ring of backlogged tenants earns
+// `weight` credits if it has less than one, sends one request per whole
+// credit, then goes to the back. Backlogged tenants get worker time in
+// proportion to their weights however many requests each one queued; a
+// tenant that drains its queue leaves the ring and keeps no credit.
+//
+// Tenant ids come from clients, so only tenants given a weight (a quota)
+// keep their entry and counters for good; any other tenant's entry is
+// dropped as soon as its queue drains.
+// ---------------------------------------------------------------------------
+class FairQueue {
+public:
+    using Task = std::function<void(bool dropped)>;  // dropped: never runs
+
+    FairQueue(ThreadPool& pool, size_t max_in_flight, size_t capacity)
+        : pool_(pool), max_in_flight_(std::max<size_t>(max_in_flight, 1)),
+          capacity_(capacity) {}
+
+    void set_weight(const std::string& tenant, double weight) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Tenant& t = entry_locked(tenant);
+        t.weight = std::max(weight, MIN_WEIGHT);
+        t.configured = true;
+    }
+
+    // Back to weight 1; the entry goes once nothing is queued for it
+    void clear_weight(const std::string& tenant) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tenants_.find(tenant);
+        if (it == tenants_.end()) return;
+        it->second.weight = 1.0;
+        it->second.configured = false;
+        if (it->second.pending.empty()) tenants_.erase(it);
+    }
+
+    // False if the queue is full (or stopped); `task` is then not kept
+    bool enqueue(const std::string& tenant, TaskPriority priority, Task task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ || queued_ >= capacity_) {
+                auto it = tenants_.find(tenant);
+                if (it != tenants_.end()) ++it->second.rejected;
+                return false;
+            }
+            Tenant& t = entry_locked(tenant);
+            t.pending.push_back(Pending{std::move(task), priority, Clock::now()});
+            ++queued_;
+            if (!t.active) {
+                t.active = true;
+                ring_.push_back(&t);
+            }
+        }
+        pump();
+        return true;
+    }
+
+    // Drop everything still queued (run with dropped = true); later
+    // enqueues are refused
+    void stop() {
+        std::vector<Task> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            for (Tenant* t : ring_) {
+                for (auto& pending : t->pending) {
+                    dropped.push_back(std::move(pending.task));
+                }
+                t->pending.clear();
+                t->active = false;
+                t->deficit = 0.0;
+                if (!t->configured) forget_locked(*t);
+            }
+            ring_.clear();
+            queued_ = 0;
+        }
+        for (auto& task : dropped) task(true);
+    }
+
+    TenantQueueStats stats(const std::string& tenant) const {
+        TenantQueueStats out;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tenants_.find(tenant);
+        if (it == tenants_.end()) return out;
+        const Tenant& t = it->second;
+        out.weight = t.weight;
+        out.queued = t.pending.size();
+        out.dispatched = t.dispatched;
+        out.rejected = t.rejected;
+        out.total_wait_ms = static_cast<double>(t.wait_ns_total) / 1e6;
+        out.max_wait_ms = static_cast<double>(t.wait_ns_max) / 1e6;
+        return out;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr double MIN_WEIGHT = 1e-3;
+
+    struct Pending {
+        Task task;
+        TaskPriority priority;  // executor lane once dispatched
+        Clock::time_point enqueued;
+    };
+
+    struct Tenant {
+        const std::string* name = nullptr;  // key in tenants_
+        double weight = 1.0;
+        double deficit = 0.0;
+        bool configured = false;  // weight set; kept while idle
+        bool active = false;      // in ring_
+        std::deque<Pending> pending;
+        uint64_t dispatched = 0;
+        uint64_t rejected = 0;
+        int64_t wait_ns_total = 0;
+        int64_t wait_ns_max = 0;
+    };
+
+    Tenant& entry_locked(const std::string& tenant) {
+        auto [it, inserted] = tenants_.try_emplace(tenant);
+        if (inserted) it->second.name = &it->first;
+        return it->second;
+    }
+
+    // Drop an idle tenant's entry; `t` is dangling afterwards
+    void forget_locked(const Tenant& t) {
+        tenants_.erase(tenants_.find(*t.name));
+    }
+
+    // Hand queued requests to the pool while workers are free
+    void pump() {
+        std::vector<std::pair<TaskPriority, std::shared_ptr<Task>>> ready;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (!stopping_ && in_flight_ < max_in_flight_ &&
+                   !ring_.empty()) {
+                Pending next = next_locked();
+                ready.emplace_back(next.priority,
+                                   std::make_shared<Task>(std::move(next.task)));
+                ++in_flight_;
+            }
+        }
+        for (auto& [priority, task] : ready) {
+            bool submitted = false;
+            try {
+                submitted = pool_.try_submit(TaskOptions{priority}, [this, task]() {
+                    try {
+                        (*task)(false);
+                    } catch (...) {
+                        finish();
+                        throw;
+                    }
+                    finish();
+                }).has_value();
+            } catch (const std::exception&) {
+                // The pool is shutting down
+            }
+            if (!submitted) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    --in_flight_;
+                }
+                (*task)(true);
+            }
+        }
+    }
+
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --in_flight_;
+        }
+        pump();
+    }
+
+    // Deficit round robin, one request per call; ring_ is not empty
+    Pending next_locked() {
+        Tenant* t = ring_.front();
+        while (t->deficit < 1.0) {
+            t->deficit += t->weight;
+            if (t->deficit < 1.0) {
+                ring_.pop_front();
+                ring_.push_back(t);
+                t = ring_.front();
+            }
+        }
+
+        Pending next = std::move(t->pending.front());
+        t->pending.pop_front();
+        --queued_;
+        t->deficit -= 1.0;
+        const int64_t waited = (Clock::now() - next.enqueued).count();
+        ++t->dispatched;
+        t->wait_ns_total += waited;
+        t->wait_ns_max = std::max(t->wait_ns_max, waited);
+
+        if (t->pending.empty()) {
+            t->active = false;
+            t->deficit = 0.0;
+            ring_.pop_front();
+            if (!t->configured) forget_locked(*t);
+        } else if (t->deficit < 1.0) {
+            ring_.pop_front();
+            ring_.push_back(t);
+        }
+        return next;
+    }
+
+    ThreadPool& pool_;
+    const size_t max_in_flight_;
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Tenant> tenants_;  // nodes never move
+    std::deque<Tenant*> ring_;  // backlogged tenants, head is served next
+    size_t queued_ = 0;
+    size_t in_flight_ = 0;
+    bool stopping_ = false;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// ModelServer::Impl
+// ===========================================================================
+
+struct ModelServer::Impl {
+    using Clock = std::chrono::steady_clock;
+
+    ModelServerConfig config;
+    // Outlives the thread pool, whose tasks report back to it
+    std::unique_ptr<FairQueue> fair_queue;
+    std::unique_ptr<ThreadPool> thread_pool;
+
+    // Registry: name -> (version -> info)
+    std::unordered_map<std::string,
+        std::map<uint32_t, ModelVersionInfo>> registry;
+    mutable std::shared_mutex registry_mutex;
+
+    // Request and response tensors are recycled through it
+    std::shared_ptr<TensorPool> tensors = TensorPool::create(config.tensor_pool);
+    std::unique_ptr<ModelCache> cache;
+    RateLimiter rate_limiter;
+    TrafficSplitter traffic_splitter;
+    AdmissionController admission;
+    // Fixed at construction: looked up without a lock
+    std::unordered_map<std::string, std::unique_ptr<ResultCache>> result_caches;
+    std::unordered_map<std::string, std::unique_ptr<SingleFlight>> flights;
+    std::unordered_map<std::string, std::unique_ptr<Degrader>> degraders;
+    std::atomic<int64_t> running_predictions{0};  // only with degraders
+    std::atomic<uint64_t> request_counter{0};
+
+    // Requests stopped by their ExecutionLimits (AbortStats)
+    std::atomic<uint64_t> deadline_aborts{0};
+    std::atomic<uint64_t> cancelled_aborts{0};
+    std::atomic<int64_t> abort_ns_total{0};
+    std::atomic<int64_t> abort_ns_max{0};
+
+    // Prefetcher: per-model request counts of the open bucket, drained into
+    // the predictor at every bucket boundary
+    std::unordered_map<CacheKey, std::unique_ptr<std::atomic<uint64_t>>,
+                       CacheKeyHash> access_counts;
+    std::shared_mutex access_mutex;
+    std::unique_ptr<DemandPredictor> predictor;
+    std::mutex prefetch_mutex;           // serializes prefetch rounds
+    // Timer for prefetch rounds and idle engine pool shrinking
+    std::mutex maintenance_mutex;
+    std::condition_variable maintenance_cv;
+    bool maintenance_stopping = false;
+    std::thread maintenance_thread;
+
+    explicit Impl(const ModelServerConfig& cfg)
+        : config(cfg), admission(cfg.admission)
+    {
+        size_t threads = cfg.worker_threads > 0
+            ? cfg.worker_threads
+            : std::max(size_t{1}, static_cast<size_t>(
+                std::thread::hardware_concurrency()));
+        size_t per_model = cfg.engines_per_model > 0
+            ? cfg.engines_per_model : threads;
+
+        thread_pool = std::make_unique<ThreadPool>(threads,
+                                                   cfg.queue_capacity);
+        if (cfg.fair_queuing) {
+            fair_queue = std::make_unique<FairQueue>(*thread_pool, threads,
+                                                     cfg.queue_capacity);
+        }
+        cache = std::make_unique<ModelCache>(cfg, per_model, tensors);
+        for (const auto& entry : cfg.result_caches) {
+            result_caches[entry.model_name] =
+                std::make_unique<ResultCache>(entry.cache);
+        }
+        for (const auto& model_name : cfg.coalesced_models) {
+            flights[model_name] = std::make_unique<SingleFlight>();
+        }
+        for (const auto& policy : cfg.degradation) {
+            degraders[policy.model_name] = std::make_unique<Degrader>(policy);
+        }
+
+        if (cfg.prefetch.enabled) {
+            predictor = std::make_unique<DemandPredictor>(cfg.prefetch);
+        }
+        if (prefetch_interval().count() > 0 || shrink_interval().count() > 0) {
+            maintenance_thread = std::thread([this] { maintenance_loop(); });
+        }
+    }
+
+    ~Impl() {
+        if (fair_queue) {
+            fair_queue->stop();
+        }
+        if (maintenance_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(maintenance_mutex);
+                maintenance_stopping = true;
+            }
+            maintenance_cv.notify_all();
+            maintenance_thread.join();
+        }
+    }
+
+    ResultCache* result_cache(const std::string& model_name) const {
+        auto it = result_caches.find(model_name);
+        return it == result_caches.end() ? nullptr : it->second.get();
+    }
+
+    SingleFlight* single_flight(const std::string& model_name) const {
+        auto it = flights.find(model_name);
+        return it == flights.end() ? nullptr : it->second.get();
+    }
+
+    Degrader* degrader(const std::string& model_name) const {
+        auto it = degraders.find(model_name);
+        return it == degraders.end() ? nullptr : it->second.get();
+    }
+
+    // Drop memoized results of a model version whose file changed
+    void invalidate_results(const std::string& model_name, uint32_t version) {
+        if (auto* results = result_cache(model_name)) {
+            results->invalidate(version);
+        }
+    }
+
+    void record_access(const CacheKey& key) {
+        {
+            std::shared_lock<std::shared_mutex> lock(access_mutex);
+            auto it = access_counts.find(key);
+            if (it != access_counts.end()) {
+                it->second->fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(access_mutex);
+        auto& count = access_counts[key];
+        if (!count) {
+            count = std::make_unique<std::atomic<uint64_t>>(0);
+        }
+        count->fetch_add(1, std::memory_order_relaxed);
+    }
 
-} // anonymous namespace
+    // Zero when the timer has no prefetch rounds to run
+    std::chrono::milliseconds prefetch_interval() const {
+        return config.prefetch.enabled ? config.prefetch.bucket_interval
+                                       : std::chrono::milliseconds{0};
+    }
 
-// ===========================================================================
-// ModelServer::Impl
-// ===========================================================================
+    // Zero when no pool is elastic; otherwise the idle window, so a pool
+    // without traffic shrinks within two windows
+    std::chrono::milliseconds shrink_interval() const {
+        return config.elastic_pools.enabled
+            ? std::chrono::milliseconds(
+                  std::max<size_t>(config.elastic_pools.idle_ms, 1))
+            : std::chrono::milliseconds{0};
+    }
 
-struct ModelServer::Impl {
-    ModelServerConfig config;
-    std::unique_ptr<ThreadPool> thread_pool;
+    void maintenance_loop() {
+        using Clock = std::chrono::steady_clock;
+        const auto start = Clock::now();
+        const auto prefetch_every = prefetch_interval();
+        const auto shrink_every = shrink_interval();
+        auto next_prefetch = prefetch_every.count() > 0
+            ? start + prefetch_every : Clock::time_point::max();
+        auto next_shrink = shrink_every.count() > 0
+            ? start + shrink_every : Clock::time_point::max();
+
+        std::unique_lock<std::mutex> lock(maintenance_mutex);
+        while (!maintenance_cv.wait_until(
+                   lock, std::min(next_prefetch, next_shrink),
+                   [this] { return maintenance_stopping; })) {
+            lock.unlock();
+            const auto now = Clock::now();
+            if (now >= next_prefetch) {
+                try {
+                    run_prefetch();
+                } catch (const std::exception& e) {
+                    TITANINFER_LOG_ERROR(std::string("Prefetch failed: ") +
+                                         e.what());
+                }
+                next_prefetch += prefetch_every;
+            }
+            if (now >= next_shrink) {
+                for (const auto& pool : cache->loaded_pools()) {
+                    pool->shrink_if_idle();
+                }
+                next_shrink = now + shrink_every;
+            }
+            lock.lock();
+        }
+    }
 
-    // Registry: name -> (version -> info)
-    std::unordered_map<std::string,
-        std::map<uint32_t, ModelVersionInfo>> registry;
-    mutable std::shared_mutex registry_mutex;
+    // Close the open access bucket, then load the models forecast to be
+    // used in the next one, evicting loaded models with a lower forecast to
+    // make room; waits until the started loads finish.
+    size_t run_prefetch() {
+        std::lock_guard<std::mutex> round(prefetch_mutex);
+        {
+            std::shared_lock<std::shared_mutex> lock(access_mutex);
+            for (auto& [key, count] : access_counts) {
+                uint64_t n = count->exchange(0, std::memory_order_relaxed);
+                if (n > 0) predictor->record(key, n);
+            }
+        }
+        predictor->advance();
+
+        const double min_rate = config.prefetch.min_rate;
+        auto loaded_keys = cache->loaded_keys();
+        std::unordered_set<CacheKey, CacheKeyHash> loaded(
+            loaded_keys.begin(), loaded_keys.end());
+        auto pinned = [this](const CacheKey& k) { return is_pinned(k); };
+
+        std::vector<std::shared_ptr<ModelCache::Loading>> started;
+        for (const auto& [key, rate] : predictor->ranked()) {
+            if (rate < min_rate) break;
+            if (loaded.count(key)) continue;
+
+            ModelVersionInfo info;
+            try {
+                info = find_version(key.first, key.second);
+            } catch (const ServerException&) {
+                continue;  // unregistered since it was last used
+            }
 
-    std::unique_ptr<ModelCache> cache;
-    RateLimiter rate_limiter;
-    TrafficSplitter traffic_splitter;
-    std::atomic<uint64_t> request_counter{0};
+            const size_t bytes = cache->known_bytes(key);
+            while (!cache->has_room(bytes)) {
+                // Loaded model with the lowest forecast, if below this one
+                const CacheKey* victim = nullptr;
+                double lowest = rate;
+                for (const auto& candidate : loaded) {
+                    double forecast = predictor->forecast(candidate);
+                    if (forecast < lowest && !is_pinned(candidate)) {
+                        lowest = forecast;
+                        victim = &candidate;
+                    }
+                }
+                if (!victim) break;
+                CacheKey evicted = *victim;
+                cache->evict(evicted);
+                loaded.erase(evicted);
+            }
+            if (!cache->has_room(bytes)) break;
 
-    explicit Impl(const ModelServerConfig& cfg)
-        : config(cfg)
-    {
-        size_t threads = cfg.worker_threads > 0
-            ? cfg.worker_threads
-            : std::max(size_t{1}, static_cast<size_t>(
-                std::thread::hardware_concurrency()));
-        size_t per_model = cfg.engines_per_model > 0
-            ? cfg.engines_per_model : threads;
+            TITANINFER_LOG_DEBUG("Prefetching '" + key.first + "' v" +
+                                 std::to_string(key.second) +
+                                 " (forecast " + std::to_string(rate) + ")");
+            started.push_back(cache->load_async(info, pinned, true));
+            loaded.insert(key);
+        }
 
-        thread_pool = std::make_unique<ThreadPool>(threads);
-        cache = std::make_unique<ModelCache>(
-            cfg.max_loaded_models, per_model, cfg.enable_profiling);
+        size_t loaded_now = 0;
+        for (auto& loading : started) {
+            try {
+                loading->done.get();
+                ++loaded_now;
+            } catch (const std::exception& e) {
+                TITANINFER_LOG_WARNING(std::string("Prefetch load failed: ") +
+                                       e.what());
+            }
+        }
+        return loaded_now;
     }
 
     // Check if a cache key corresponds to a pinned model
@@ -495,10 +2349,203 @@ struct ModelServer::Impl {
         return ver_it->second;
     }
 
+    // Load and warm up a new pool for a model version while the current one
+    // keeps serving, then hand traffic over (see ModelCache::replace)
+    void reload(const std::string& name, uint32_t version,
+                const std::string& path) {
+        CacheKey key{name, version};
+        auto start = std::chrono::steady_clock::now();
+        auto pool = cache->make_pool(path, key, config.reload.warmup_runs);
+        double load_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        if (auto current = cache->peek(key)) {
+            pool->warm_up(current->recent_inputs());
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> lock(registry_mutex);
+            auto name_it = registry.find(name);
+            if (name_it == registry.end() ||
+                !name_it->second.count(version)) {
+                throw ServerException("Model '" + name + "' v" +
+                                      std::to_string(version) +
+                                      " was unregistered during reload",
+                                      ErrorCode::VERSION_NOT_FOUND);
+            }
+            name_it->second[version].file_path = path;
+        }
+        cache->replace(key, std::move(pool), load_ms,
+                       std::chrono::milliseconds(config.reload.ramp_ms));
+        invalidate_results(name, version);
+
+        TITANINFER_LOG_INFO("Hot-reload of '" + name + "' v" +
+                            std::to_string(version) + " ready; " +
+                            (config.reload.ramp_ms > 0
+                                ? "ramping over " +
+                                  std::to_string(config.reload.ramp_ms) + " ms"
+                                : std::string("cut over")));
+    }
+
+    // Fetch (or load) the engine pool of a resolved model version
+    std::shared_ptr<EnginePool> load_pool(const ModelVersionInfo& info) {
+        if (predictor) {
+            record_access(CacheKey{info.name, info.version});
+        }
+        return cache->get_or_load(
+            info, [this](const CacheKey& k) { return is_pinned(k); },
+            std::chrono::milliseconds(config.load_timeout_ms));
+    }
+
+    // 503 with Retry-After for a request refused because of load
+    Response overloaded_response(const std::string& req_id,
+                                 const std::string& reason) const {
+        Response response;
+        response.status_code = 503;
+        response.error_message = "Server overloaded: " + reason;
+        response.headers["X-Request-Id"] =
+            req_id.empty() ? generate_request_id() : req_id;
+        response.headers["Retry-After"] =
+            std::to_string(admission.retry_after_s());
+        TITANINFER_LOG_WARNING("[" + response.headers["X-Request-Id"] +
+                               "] " + response.error_message);
+        return response;
+    }
+
+    static bool is_abort(ErrorCode code) {
+        return code == ErrorCode::DEADLINE_EXCEEDED ||
+               code == ErrorCode::CANCELLED;
+    }
+
+    // 504 for an expired deadline, 499 for a cancelled request; counted in
+    // AbortStats with the time since `arrived`
+    Response aborted_response(const std::string& req_id, ErrorCode code,
+                              const std::string& what, Clock::time_point arrived) {
+        int64_t elapsed_ns = (Clock::now() - arrived).count();
+        (code == ErrorCode::CANCELLED ? cancelled_aborts : deadline_aborts)
+            .fetch_add(1, std::memory_order_relaxed);
+        abort_ns_total.fetch_add(elapsed_ns, std::memory_order_relaxed);
+        int64_t max = abort_ns_max.load(std::memory_order_relaxed);
+        while (elapsed_ns > max &&
+               !abort_ns_max.compare_exchange_weak(
+                   max, elapsed_ns, std::memory_order_relaxed)) {}
+
+        Response response;
+        response.status_code = code == ErrorCode::CANCELLED ? 499 : 504;
+        response.error_message = what;
+        response.latency_ms = static_cast<double>(elapsed_ns) / 1e6;
+        response.headers["X-Request-Id"] =
+            req_id.empty() ? generate_request_id() : req_id;
+        TITANINFER_LOG_WARNING("[" + response.headers["X-Request-Id"] +
+                               "] " + response.error_message);
+        return response;
+    }
+
+    // Run `run(enqueued)` on the thread pool behind admission control of
+    // `model_name` (and behind the tenant's fair queue, if enabled). A
+    // refused or stopped request gets a 503/504/499 through `reject`
+    // instead: inline for a full queue, a rejected arrival or limits
+    // already expired, on the worker when it is dropped at dequeue.
+    // Deadlines are checked here rather than by the ThreadPool, whose
+    // expired tasks would never reach `reject`.
+    template <typename Run, typename Reject>
+    void submit_admitted(const std::string& model_name,
+                         const std::string& tenant_id,
+                         const std::string& req_id,
+                         const ExecutionLimits& limits,
+                         Run run, Reject reject) {
+        const auto arrived = Clock::now();
+        if (limits.stop_requested()) {
+            reject(stopped_response(req_id, limits, arrived));
+            return;
+        }
+        auto* queue = admission.queue(model_name);
+        if (queue && !queue->try_admit()) {
+            reject(overloaded_response(req_id, "queueing delay above target"));
+            return;
+        }
+
+        auto work = [this, queue, req_id, limits, arrived, reject,
+                     run = std::move(run)]() mutable {
+            if (queue && !queue->on_dequeue(arrived)) {
+                reject(overloaded_response(
+                    req_id, "request waited past the queueing target"));
+                return;
+            }
+            if (limits.stop_requested()) {
+                reject(stopped_response(req_id, limits, arrived));
+                return;
+            }
+            run(arrived);
+        };
+
+        if (fair_queue) {
+            bool queued = fair_queue->enqueue(
+                tenant_id, limits.priority,
+                [this, queue, req_id, reject,
+                 work = std::move(work)](bool dropped) mutable {
+                    if (dropped) {
+                        if (queue) queue->abandon();
+                        reject(overloaded_response(req_id,
+                                                   "server shutting down"));
+                        return;
+                    }
+                    work();
+                });
+            if (!queued) {
+                if (queue) queue->abandon();
+                reject(overloaded_response(req_id, "request queue full"));
+            }
+            return;
+        }
+
+        auto queued = thread_pool->try_submit(TaskOptions{limits.priority},
+                                              std::move(work));
+        if (!queued) {
+            if (queue) queue->abandon();
+            reject(overloaded_response(req_id, "request queue full"));
+        }
+    }
+
+    Response stopped_response(const std::string& req_id,
+                              const ExecutionLimits& limits,
+                              Clock::time_point arrived) {
+        return limits.cancellation.cancelled()
+            ? aborted_response(req_id, ErrorCode::CANCELLED,
+                               "Request cancelled before execution", arrived)
+            : aborted_response(req_id, ErrorCode::DEADLINE_EXCEEDED,
+                               "Request deadline exceeded before execution",
+                               arrived);
+    }
+
+    std::future<Response> submit_async(
+        const std::string& model_name, const std::string& tenant_id,
+        const std::string& req_id, const ExecutionLimits& limits,
+        std::function<Response(Clock::time_point)> work) {
+        auto promise = std::make_shared<std::promise<Response>>();
+        auto future = promise->get_future();
+        submit_admitted(
+            model_name, tenant_id, req_id, limits,
+            [promise, work = std::move(work)](Clock::time_point arrived) {
+                try {
+                    promise->set_value(work(arrived));
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            },
+            [promise](Response rejected) {
+                promise->set_value(std::move(rejected));
+            });
+        return future;
+    }
+
     Response do_predict(const std::string& model_name,
                         const Tensor& input,
                         const std::string& tenant_id,
-                        const std::string& req_id)
+                        const std::string& req_id,
+                        const ExecutionLimits& limits,
+                        Clock::time_point arrived,
+                        uint32_t pinned_version = 0)
     {
         auto start = std::chrono::steady_clock::now();
         std::string request_id = req_id.empty() ? generate_request_id() : req_id;
@@ -523,38 +2570,103 @@ struct ModelServer::Impl {
             ~QuotaGuard() { rl.release(tid); }
         } guard{rate_limiter, tenant_id};
 
+        // Predictions running now, the saturation signal of degradation
+        struct RunningGuard {
+            std::atomic<int64_t>* running;
+            ~RunningGuard() {
+                if (running) running->fetch_sub(1, std::memory_order_relaxed);
+            }
+        } running_guard{degraders.empty() ? nullptr : &running_predictions};
+        const int64_t running_now = running_guard.running
+            ? running_predictions.fetch_add(1, std::memory_order_relaxed) + 1
+            : 0;
+
         try {
-            // Route: traffic splitting or default
-            uint32_t version = traffic_splitter.select_version(model_name);
+            // Route: pinned version, traffic splitting or default
+            uint32_t version = pinned_version != 0
+                ? pinned_version
+                : traffic_splitter.select_version(model_name, tenant_id,
+                                                  req_id);
+
+            // Overloaded: the model's faster variant instead, unless the
+            // caller named a version (its load still counts)
+            bool degraded = false;
+            if (Degrader* fallback = degrader(model_name)) {
+                degraded = fallback->observe(
+                    start,
+                    std::chrono::duration<double, std::milli>(
+                        start - arrived).count(),
+                    static_cast<double>(running_now) /
+                        static_cast<double>(thread_pool->thread_count()),
+                    pinned_version != 0);
+                if (degraded) version = fallback->fallback_version();
+            }
 
             ModelVersionInfo info = find_version(model_name, version);
 
             // Load or fetch from cache
-            auto pool = cache->get_or_load(
-                info, [this](const CacheKey& k) { return is_pinned(k); });
-
-            // Acquire engine from pool
-            auto lease = pool->acquire();
+            auto pool = load_pool(info);
 
             TITANINFER_LOG_DEBUG("[" + request_id + "] Predicting on '" +
                                 model_name + "' v" +
                                 std::to_string(info.version));
 
-            // Run inference
-            Tensor output = lease.engine().predict(input);
+            // Memoized result of this exact input on this pool
+            ResultCache* results = result_cache(model_name);
+            SingleFlight* flight = single_flight(model_name);
+            uint64_t input_hash =
+                results || flight ? hash_tensor(input) : 0;
+            std::shared_ptr<const Tensor> cached;
+            if (results) {
+                cached = results->lookup(info.version, pool->id(),
+                                         input_hash, input);
+            }
+
+            auto infer = [&] {
+                // Run inference (leased engine or shared batch)
+                pool->sample_input(input);
+                Tensor output = pool->predict(input, limits);
+                if (results) {
+                    results->insert(info.version, pool->id(), input_hash,
+                                    input, output);
+                }
+                return output;
+            };
+
+            if (cached) {
+                response.body = tensors->copy_of(*cached);
+                response.headers["X-Result-Cache"] = "hit";
+            } else if (flight) {
+                // Identical requests in flight run once
+                bool coalesced = false;
+                response.body = flight->run(
+                    SingleFlight::Key{info.version, pool->id(), input_hash},
+                    input, limits, *tensors, infer, coalesced);
+                if (coalesced) {
+                    response.headers["X-Coalesced"] = "true";
+                }
+            } else {
+                response.body = infer();
+            }
 
             auto end = std::chrono::steady_clock::now();
             response.status_code = 200;
-            response.body = std::move(output);
             response.latency_ms = std::chrono::duration<double, std::milli>(
                 end - start).count();
             response.headers["X-Model-Version"] =
                 std::to_string(info.version);
+            if (degraded) {
+                response.headers["X-Degraded"] = "true";
+            }
 
         } catch (const ServerException& e) {
             response.status_code =
                 (e.error_code() == ErrorCode::MODEL_NOT_FOUND ||
                  e.error_code() == ErrorCode::VERSION_NOT_FOUND) ? 404 : 500;
+            if (e.error_code() == ErrorCode::MODEL_LOADING) {
+                response.status_code = 503;
+                response.headers["Retry-After"] = "1";
+            }
             response.error_message = e.what();
             TITANINFER_LOG_ERROR("[" + request_id + "] " +
                                 response.error_message);
@@ -569,7 +2681,13 @@ struct ModelServer::Impl {
             TITANINFER_LOG_WARNING("[" + request_id + "] " +
                                   response.error_message);
         } catch (const TitanInferException& e) {
-            response.status_code = 500;
+            if (is_abort(e.error_code())) {
+                return aborted_response(request_id, e.error_code(), e.what(),
+                                        arrived);
+            }
+            // A full batcher queue is backpressure, not a server fault
+            response.status_code =
+                e.error_code() == ErrorCode::QUEUE_FULL ? 503 : 500;
             response.error_message = e.what();
             TITANINFER_LOG_ERROR("[" + request_id + "] " +
                                 response.error_message);
@@ -582,6 +2700,35 @@ struct ModelServer::Impl {
 
         return response;
     }
+
+    // `arrived` is the submission time of an async request
+    Response handle_request(const Request& request, Clock::time_point arrived) {
+        if (request.method != HttpMethod::POST) {
+            Response response;
+            response.status_code = 405;
+            response.error_message = "Method not allowed";
+            response.headers["X-Request-Id"] =
+                request.request_id.empty() ? generate_request_id()
+                                           : request.request_id;
+            return response;
+        }
+
+        auto route = parse_path(request.path);
+        if (!route.valid) {
+            Response response;
+            response.status_code = 404;
+            response.error_message = "Invalid path: " + request.path;
+            response.headers["X-Request-Id"] =
+                request.request_id.empty() ? generate_request_id()
+                                           : request.request_id;
+            return response;
+        }
+
+        // A version in the URL bypasses traffic splitting and degradation
+        return do_predict(route.model_name, request.body,
+                          request.tenant_id, request.request_id,
+                          request.limits, arrived, route.version);
+    }
 };
 
 // ===========================================================================
@@ -603,11 +2750,95 @@ ModelServer::Builder& ModelServer::Builder::setEnginesPerModel(size_t count) {
     return *this;
 }
 
+ModelServer::Builder& ModelServer::Builder::enableElasticPools(
+    const ElasticPoolConfig& config) {
+    config_.elastic_pools = config;
+    config_.elastic_pools.enabled = true;
+    return *this;
+}
+
 ModelServer::Builder& ModelServer::Builder::enableProfiling(bool enable) {
     config_.enable_profiling = enable;
     return *this;
 }
 
+ModelServer::Builder& ModelServer::Builder::setQueueCapacity(size_t capacity) {
+    config_.queue_capacity = capacity;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enableFairQueuing(bool enable) {
+    config_.fair_queuing = enable;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::setMaxLoadedBytes(size_t bytes) {
+    config_.max_loaded_bytes = bytes;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::setEvictionPolicy(
+    EvictionPolicy policy) {
+    config_.eviction_policy = policy;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::setLoadTimeout(size_t ms) {
+    config_.load_timeout_ms = ms;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enablePrefetch(
+    const PrefetchConfig& config) {
+    config_.prefetch = config;
+    config_.prefetch.enabled = true;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::setReloadConfig(
+    const ReloadConfig& config) {
+    config_.reload = config;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::setTensorPoolConfig(
+    const TensorPoolConfig& config) {
+    config_.tensor_pool = config;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enableAdmissionControl(
+    const AdmissionConfig& config) {
+    config_.admission = config;
+    config_.admission.enabled = true;
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enableBatching(
+    const std::string& model_name, uint32_t version,
+    const BatcherConfig& config) {
+    config_.batching.push_back(ModelBatchingConfig{model_name, version, config});
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enableResultCache(
+    const std::string& model_name, const ResultCacheConfig& config) {
+    config_.result_caches.push_back(ModelResultCacheConfig{model_name, config});
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enableCoalescing(
+    const std::string& model_name) {
+    config_.coalesced_models.push_back(model_name);
+    return *this;
+}
+
+ModelServer::Builder& ModelServer::Builder::enableDegradation(
+    const DegradationPolicy& policy) {
+    config_.degradation.push_back(policy);
+    return *this;
+}
+
 ModelServer ModelServer::Builder::build() {
     return ModelServer(config_);
 }
@@ -640,6 +2871,7 @@ void ModelServer::register_model(const std::string& name,
     info.pinned = false;
 
     impl_->registry[name][version] = info;
+    impl_->invalidate_results(name, version);
 
     TITANINFER_LOG_INFO("Registered model '" + name + "' v" +
                         std::to_string(version) + " at " + file_path);
@@ -658,6 +2890,7 @@ void ModelServer::unregister_model(const std::string& name,
         }
     }
     impl_->cache->evict(CacheKey{name, version});
+    impl_->invalidate_results(name, version);
     impl_->traffic_splitter.remove_rules(name);
 
     TITANINFER_LOG_INFO("Unregistered model '" + name + "' v" +
@@ -732,21 +2965,29 @@ std::vector<ModelVersionInfo> ModelServer::list_versions(
 void ModelServer::set_tenant_quota(const std::string& tenant_id,
                                     const TenantQuota& quota) {
     impl_->rate_limiter.set_quota(tenant_id, quota);
+    if (impl_->fair_queue) {
+        impl_->fair_queue->set_weight(tenant_id, quota.weight);
+    }
     TITANINFER_LOG_INFO("Set quota for tenant '" + tenant_id +
                         "': max_qps=" + std::to_string(quota.max_qps) +
                         ", max_concurrent=" +
-                        std::to_string(quota.max_concurrent));
+                        std::to_string(quota.max_concurrent) +
+                        ", weight=" + std::to_string(quota.weight));
 }
 
 void ModelServer::remove_tenant_quota(const std::string& tenant_id) {
     impl_->rate_limiter.remove_quota(tenant_id);
+    if (impl_->fair_queue) {
+        impl_->fair_queue->clear_weight(tenant_id);
+    }
 }
 
 // ---- Traffic Splitting ----
 
 void ModelServer::set_traffic_rules(const std::string& model_name,
-                                     const std::vector<TrafficRule>& rules) {
-    impl_->traffic_splitter.set_rules(model_name, rules);
+                                     const std::vector<TrafficRule>& rules,
+                                     StickyRouting sticky) {
+    impl_->traffic_splitter.set_rules(model_name, rules, sticky);
 }
 
 // ---- Inference ----
@@ -754,122 +2995,89 @@ void ModelServer::set_traffic_rules(const std::string& model_name,
 Response ModelServer::predict(const std::string& model_name,
                                const Tensor& input,
                                const std::string& tenant_id,
-                               const std::string& request_id) {
-    return impl_->do_predict(model_name, input, tenant_id, request_id);
+                               const std::string& request_id,
+                               const ExecutionLimits& limits) {
+    return impl_->do_predict(model_name, input, tenant_id, request_id,
+                             limits, Impl::Clock::now());
 }
 
 std::future<Response> ModelServer::predict_async(
     const std::string& model_name,
     const Tensor& input,
     const std::string& tenant_id,
-    const std::string& request_id)
+    const std::string& request_id,
+    const ExecutionLimits& limits)
+{
+    // The caller keeps `input`: one copy, into a pooled buffer
+    return predict_async(model_name, impl_->tensors->copy_of(input),
+                         tenant_id, request_id, limits);
+}
+
+std::future<Response> ModelServer::predict_async(
+    const std::string& model_name,
+    Tensor&& input,
+    const std::string& tenant_id,
+    const std::string& request_id,
+    const ExecutionLimits& limits)
 {
-    // Deep copy input for thread safety (Tensor has deep copy ctor)
-    Tensor input_copy(input);
-    std::string name_copy = model_name;
-    std::string tenant_copy = tenant_id;
-    std::string req_copy = request_id;
-
-    return impl_->thread_pool->submit(
-        [this, name_copy, input_copy, tenant_copy, req_copy]() {
-            return impl_->do_predict(name_copy, input_copy,
-                                     tenant_copy, req_copy);
+    return impl_->submit_async(
+        model_name, tenant_id, request_id, limits,
+        [this, model_name, input = std::move(input), tenant_id, request_id,
+         limits](Impl::Clock::time_point arrived) {
+            return impl_->do_predict(model_name, input, tenant_id,
+                                     request_id, limits, arrived);
         });
 }
 
 Response ModelServer::handle_request(const Request& request) {
-    if (request.method != HttpMethod::POST) {
-        Response response;
-        response.status_code = 405;
-        response.error_message = "Method not allowed";
-        response.headers["X-Request-Id"] =
-            request.request_id.empty() ? generate_request_id()
-                                       : request.request_id;
-        return response;
-    }
-
-    auto route = parse_path(request.path);
-    if (!route.valid) {
-        Response response;
-        response.status_code = 404;
-        response.error_message = "Invalid path: " + request.path;
-        response.headers["X-Request-Id"] =
-            request.request_id.empty() ? generate_request_id()
-                                       : request.request_id;
-        return response;
-    }
-
-    // If a specific version is in the URL, use it directly
-    if (route.version > 0) {
-        // Temporarily bypass traffic splitting by directly finding version
-        auto start = std::chrono::steady_clock::now();
-        std::string req_id = request.request_id.empty()
-            ? generate_request_id() : request.request_id;
-
-        Response response;
-        response.headers["X-Request-Id"] = req_id;
-
-        if (!impl_->rate_limiter.try_acquire(request.tenant_id)) {
-            response.status_code = 429;
-            response.error_message = "Quota exceeded for tenant '" +
-                                     request.tenant_id + "'";
-            return response;
-        }
-
-        struct QuotaGuard {
-            RateLimiter& rl;
-            const std::string& tid;
-            ~QuotaGuard() { rl.release(tid); }
-        } guard{impl_->rate_limiter, request.tenant_id};
-
-        try {
-            ModelVersionInfo info =
-                impl_->find_version(route.model_name, route.version);
-            auto pool = impl_->cache->get_or_load(
-                info, [this](const CacheKey& k) {
-                    return impl_->is_pinned(k);
-                });
-            auto lease = pool->acquire();
-            Tensor output = lease.engine().predict(request.body);
-
-            auto end = std::chrono::steady_clock::now();
-            response.status_code = 200;
-            response.body = std::move(output);
-            response.latency_ms =
-                std::chrono::duration<double, std::milli>(end - start).count();
-            response.headers["X-Model-Version"] =
-                std::to_string(info.version);
-        } catch (const ServerException& e) {
-            response.status_code = 404;
-            response.error_message = e.what();
-        } catch (const ValidationException& e) {
-            response.status_code = 400;
-            response.error_message = e.what();
-        } catch (const std::invalid_argument& e) {
-            response.status_code = 400;
-            response.error_message = e.what();
-        } catch (const std::exception& e) {
-            response.status_code = 500;
-            response.error_message = e.what();
-        }
-
-        return response;
-    }
-
-    return impl_->do_predict(route.model_name, request.body,
-                             request.tenant_id, request.request_id);
+    return impl_->handle_request(request, Impl::Clock::now());
 }
 
 std::future<Response> ModelServer::handle_request_async(
     const Request& request)
 {
-    Request req_copy = request;
-    // Deep-copy the tensor body
-    req_copy.body = Tensor(request.body);
+    // One copy of the body, into a pooled buffer; headers are not needed
+    // past this point
+    Request copy;
+    copy.request_id = request.request_id;
+    copy.method = request.method;
+    copy.path = request.path;
+    copy.tenant_id = request.tenant_id;
+    copy.body = impl_->tensors->copy_of(request.body);
+    copy.limits = request.limits;
+    return handle_request_async(std::move(copy));
+}
+
+std::future<Response> ModelServer::handle_request_async(Request&& request)
+{
+    std::string model_name = parse_path(request.path).model_name;
+    std::string tenant_id = request.tenant_id;
+    std::string request_id = request.request_id;
+    ExecutionLimits limits = request.limits;
+    return impl_->submit_async(
+        model_name, tenant_id, request_id, limits,
+        [this, request = std::move(request)](Impl::Clock::time_point arrived) {
+            return impl_->handle_request(request, arrived);
+        });
+}
 
-    return impl_->thread_pool->submit(
-        [this, req_copy]() mutable {
-            return handle_request(req_copy);
+void ModelServer::handle_request_async(
+    Request request, std::function<void(Response)> on_done)
+{
+    std::string request_id = request.request_id;
+    std::string tenant_id = request.tenant_id;
+    std::string model_name = parse_path(request.path).model_name;
+    ExecutionLimits limits = request.limits;
+    auto shared_done =
+        std::make_shared<std::function<void(Response)>>(std::move(on_done));
+    impl_->submit_admitted(
+        model_name, tenant_id, request_id, limits,
+        [this, request = std::move(request),
+         shared_done](Impl::Clock::time_point arrived) {
+            (*shared_done)(impl_->handle_request(request, arrived));
+        },
+        [shared_done](Response rejected) {
+            (*shared_done)(std::move(rejected));
         });
 }
 
@@ -877,40 +3085,32 @@ std::future<Response> ModelServer::handle_request_async(
 
 void ModelServer::reload_model(const std::string& name, uint32_t version,
                                 const std::string& new_file_path) {
-    // Update registry with new path
-    {
-        std::unique_lock<std::shared_mutex> lock(impl_->registry_mutex);
-        auto name_it = impl_->registry.find(name);
-        if (name_it == impl_->registry.end()) {
-            throw ServerException("Model '" + name + "' not found",
-                                  ErrorCode::MODEL_NOT_FOUND);
-        }
-        auto ver_it = name_it->second.find(version);
-        if (ver_it == name_it->second.end()) {
-            throw ServerException("Version " + std::to_string(version) +
-                                  " not found", ErrorCode::VERSION_NOT_FOUND);
-        }
-        ver_it->second.file_path = new_file_path;
-    }
+    reload_model_async(name, version, new_file_path).get();
+}
+
+std::shared_future<void> ModelServer::reload_model_async(
+    const std::string& name, uint32_t version,
+    const std::string& new_file_path)
+{
+    impl_->find_version(name, version);  // throws if not registered
 
     TITANINFER_LOG_INFO("Hot-reloading model '" + name + "' v" +
                         std::to_string(version) + " from " + new_file_path);
+    return impl_->cache->run_in_background(
+        [this, name, version, new_file_path] {
+            impl_->reload(name, version, new_file_path);
+        }).share();
+}
 
-    // Build new pool in background, then atomically swap
-    size_t pool_size = impl_->config.engines_per_model > 0
-        ? impl_->config.engines_per_model
-        : impl_->thread_pool->thread_count();
-    bool profiling = impl_->config.enable_profiling;
-    CacheKey key{name, version};
-
-    // Load synchronously for simplicity and testability.
-    // The old pool remains alive via shared_ptr until all Leases complete.
-    auto new_pool = std::make_shared<EnginePool>(
-        new_file_path, pool_size, profiling);
-    impl_->cache->replace(key, std::move(new_pool));
+// ---- Preloading ----
 
-    TITANINFER_LOG_INFO("Hot-reload complete for '" + name + "' v" +
-                        std::to_string(version));
+std::shared_future<void> ModelServer::preload(const std::string& name,
+                                              uint32_t version) {
+    ModelVersionInfo info = impl_->find_version(name, version);
+    return impl_->cache->load_async(
+        info, [this](const CacheKey& k) {
+            return impl_->is_pinned(k);
+        })->done;
 }
 
 // ---- Stats ----
@@ -919,6 +3119,82 @@ size_t ModelServer::loaded_model_count() const {
     return impl_->cache->loaded_count();
 }
 
+size_t ModelServer::loaded_bytes() const {
+    return impl_->cache->loaded_bytes();
+}
+
+CacheStats ModelServer::cache_stats() const {
+    return impl_->cache->stats();
+}
+
+AdmissionStats ModelServer::admission_stats(
+    const std::string& model_name) const {
+    return impl_->admission.stats(model_name);
+}
+
+ResultCacheStats ModelServer::result_cache_stats(
+    const std::string& model_name) const {
+    auto* results = impl_->result_cache(model_name);
+    return results ? results->stats() : ResultCacheStats{};
+}
+
+EnginePoolStats ModelServer::engine_pool_stats(const std::string& model_name,
+                                               uint32_t version) const {
+    uint32_t resolved = 0;
+    try {
+        resolved = impl_->find_version(model_name, version).version;
+    } catch (const ServerException&) {
+        return EnginePoolStats{};
+    }
+    auto pool = impl_->cache->peek(CacheKey{model_name, resolved});
+    return pool ? pool->stats() : EnginePoolStats{};
+}
+
+CoalescingStats ModelServer::coalescing_stats(
+    const std::string& model_name) const {
+    auto* flight = impl_->single_flight(model_name);
+    return flight ? flight->stats() : CoalescingStats{};
+}
+
+DegradationStats ModelServer::degradation_stats(
+    const std::string& model_name) const {
+    auto* fallback = impl_->degrader(model_name);
+    return fallback ? fallback->stats() : DegradationStats{};
+}
+
+TenantQueueStats ModelServer::tenant_queue_stats(
+    const std::string& tenant_id) const {
+    return impl_->fair_queue ? impl_->fair_queue->stats(tenant_id)
+                             : TenantQueueStats{};
+}
+
+std::shared_ptr<TensorPool> ModelServer::tensor_pool() const {
+    return impl_->tensors;
+}
+
+AbortStats ModelServer::abort_stats() const {
+    AbortStats stats;
+    stats.deadline_exceeded =
+        impl_->deadline_aborts.load(std::memory_order_relaxed);
+    stats.cancelled = impl_->cancelled_aborts.load(std::memory_order_relaxed);
+    stats.total_latency_ms = static_cast<double>(
+        impl_->abort_ns_total.load(std::memory_order_relaxed)) / 1e6;
+    stats.max_latency_ms = static_cast<double>(
+        impl_->abort_ns_max.load(std::memory_order_relaxed)) / 1e6;
+    return stats;
+}
+
+size_t ModelServer::prefetch_now() {
+    if (!impl_->predictor) {
+        return 0;
+    }
+    return impl_->run_prefetch();
+}
+
+uint64_t ModelServer::cold_load_count() const {
+    return impl_->cache->cold_load_count();
+}
+
 size_t ModelServer::registered_model_count() const {
     std::shared_lock<std::shared_mutex> lock(impl_->registry_mutex);
     size_t count = 0;
@@ -0,0 +1,235 @@
+#include "titaninfer/engine/result_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef TITANINFER_ENABLE_SIMD
+#include <immintrin.h>
+#endif
+
+namespace titaninfer {
+namespace engine {
+
+namespace {
+
+constexpr size_t STRIPE_BYTES = 32;         // four 64-bit lanes
+constexpr size_t STRIPES_PER_SCRAMBLE = 16;
+constexpr size_t ENTRY_OVERHEAD = 128;      // list node, index slot, shapes
+
+constexpr uint64_t LANE_KEYS[4] = {
+    0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full,
+    0x165667B19E3779F9ull, 0x85EBCA77C2B2AE63ull,
+};
+constexpr uint64_t SCRAMBLE_KEYS[4] = {
+    0x27D4EB2F165667C5ull, 0x94D049BB133111EBull,
+    0xBF58476D1CE4E5B9ull, 0xD6E8FEB86659FD93ull,
+};
+constexpr uint32_t SCRAMBLE_PRIME = 0x9E3779B1u;
+
+uint64_t fmix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// acc[i] += lo32(d ^ k) * hi32(d ^ k), and each lane's neighbour in its
+// 128-bit half absorbs the raw input: one _mm256_mul_epu32 round on AVX2
+void accumulate_scalar(uint64_t acc[4], const unsigned char* stripe) {
+    uint64_t in[4];
+    std::memcpy(in, stripe, STRIPE_BYTES);
+    uint64_t next[4];
+    for (size_t i = 0; i < 4; ++i) {
+        uint64_t keyed = in[i] ^ LANE_KEYS[i];
+        next[i] = acc[i] + in[i ^ 1] +
+                  (keyed & 0xFFFFFFFFull) * (keyed >> 32);
+    }
+    std::memcpy(acc, next, sizeof(next));
+}
+
+#ifdef TITANINFER_ENABLE_SIMD
+// Whole stripes [0, stripes) through the AVX2 lanes
+void accumulate_stripes(uint64_t acc_out[4], const unsigned char* data,
+                        size_t stripes) {
+    const __m256i key = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(LANE_KEYS));
+    const __m256i scramble_key = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(SCRAMBLE_KEYS));
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(SCRAMBLE_PRIME));
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc_out));
+
+    for (size_t s = 0; s < stripes; ++s) {
+        const __m256i in = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(data + s * STRIPE_BYTES));
+        const __m256i keyed = _mm256_xor_si256(in, key);
+        const __m256i product =
+            _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+        const __m256i swapped =
+            _mm256_shuffle_epi32(in, _MM_SHUFFLE(1, 0, 3, 2));
+        acc = _mm256_add_epi64(acc, _mm256_add_epi64(swapped, product));
+
+        if ((s + 1) % STRIPES_PER_SCRAMBLE == 0) {
+            __m256i a = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+            a = _mm256_xor_si256(a, scramble_key);
+            // 64 x 32-bit multiply from two 32 x 32 halves
+            const __m256i lo = _mm256_mul_epu32(a, prime);
+            const __m256i hi =
+                _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+            acc = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+        }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc_out), acc);
+}
+#else
+void scramble_scalar(uint64_t acc[4]) {
+    for (size_t i = 0; i < 4; ++i) {
+        uint64_t a = (acc[i] ^ (acc[i] >> 47)) ^ SCRAMBLE_KEYS[i];
+        acc[i] = a * SCRAMBLE_PRIME;
+    }
+}
+
+void accumulate_stripes(uint64_t acc[4], const unsigned char* data,
+                        size_t stripes) {
+    for (size_t s = 0; s < stripes; ++s) {
+        accumulate_scalar(acc, data + s * STRIPE_BYTES);
+        if ((s + 1) % STRIPES_PER_SCRAMBLE == 0) {
+            scramble_scalar(acc);
+        }
+    }
+}
+#endif
+
+} // anonymous namespace
+
+uint64_t hash_bytes(const void* data, size_t size, uint64_t seed) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t acc[4] = {
+        seed ^ LANE_KEYS[0], seed + LANE_KEYS[1],
+        seed ^ LANE_KEYS[2], seed - LANE_KEYS[3],
+    };
+
+    const size_t stripes = size / STRIPE_BYTES;
+    accumulate_stripes(acc, bytes, stripes);
+
+    const size_t tail = size % STRIPE_BYTES;
+    if (tail != 0) {
+        unsigned char last[STRIPE_BYTES] = {};
+        std::memcpy(last, bytes + stripes * STRIPE_BYTES, tail);
+        accumulate_scalar(acc, last);
+    }
+
+    uint64_t h = fmix64(static_cast<uint64_t>(size) ^ seed);
+    for (uint64_t lane : acc) {
+        h = fmix64(h ^ fmix64(lane));
+    }
+    return h;
+}
+
+uint64_t hash_tensor(const Tensor& tensor) {
+    const auto& shape = tensor.shape();
+    uint64_t seed = hash_bytes(shape.data(), shape.size() * sizeof(size_t));
+    return hash_bytes(tensor.data(), tensor.size() * sizeof(float), seed);
+}
+
+ResultCache::ResultCache(const ResultCacheConfig& config)
+    : shard_budget_(config.max_bytes / std::max<size_t>(config.shards, 1)),
+      shards_(std::max<size_t>(config.shards, 1)) {}
+
+bool ResultCache::same_input(const Tensor& a, const Tensor& b) {
+    return a.shape() == b.shape() &&
+           std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+std::shared_ptr<const Tensor> ResultCache::lookup(
+    uint32_t version, uint64_t pool_id, uint64_t hash, const Tensor& input) {
+    Shard& shard = shard_for(hash);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(Key{version, pool_id, hash});
+        if (it != shard.index.end() && same_input(it->second->input, input)) {
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return it->second->output;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void ResultCache::insert(uint32_t version, uint64_t pool_id, uint64_t hash,
+                         const Tensor& input, const Tensor& output) {
+    const size_t bytes =
+        (input.size() + output.size()) * sizeof(float) + ENTRY_OVERHEAD;
+    if (bytes > shard_budget_) {
+        return;
+    }
+
+    // Copy outside the lock; owning copies do not pin pooled buffers
+    Entry entry{Key{version, pool_id, hash}, Tensor(input),
+                std::make_shared<const Tensor>(output), bytes};
+
+    Shard& shard = shard_for(hash);
+    uint64_t evicted = 0;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto existing = shard.index.find(entry.key);
+        if (existing != shard.index.end()) {
+            // A concurrent miss got here first, or a colliding input
+            shard.bytes -= existing->second->bytes;
+            shard.lru.erase(existing->second);
+            shard.index.erase(existing);
+        }
+        while (shard.bytes + bytes > shard_budget_ && !shard.lru.empty()) {
+            const Entry& victim = shard.lru.back();
+            shard.bytes -= victim.bytes;
+            shard.index.erase(victim.key);
+            shard.lru.pop_back();
+            ++evicted;
+        }
+        shard.lru.push_front(std::move(entry));
+        shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+        shard.bytes += bytes;
+    }
+    insertions_.fetch_add(1, std::memory_order_relaxed);
+    if (evicted != 0) {
+        evictions_.fetch_add(evicted, std::memory_order_relaxed);
+    }
+}
+
+void ResultCache::invalidate(uint32_t version) {
+    uint64_t dropped = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.lru.begin(); it != shard.lru.end();) {
+            if (version != 0 && it->key.version != version) {
+                ++it;
+                continue;
+            }
+            shard.bytes -= it->bytes;
+            shard.index.erase(it->key);
+            it = shard.lru.erase(it);
+            ++dropped;
+        }
+    }
+    invalidations_.fetch_add(dropped, std::memory_order_relaxed);
+}
+
+ResultCacheStats ResultCache::stats() const {
+    ResultCacheStats out;
+    out.hits = hits_.load(std::memory_order_relaxed);
+    out.misses = misses_.load(std::memory_order_relaxed);
+    out.insertions = insertions_.load(std::memory_order_relaxed);
+    out.evictions = evictions_.load(std::memory_order_relaxed);
+    out.invalidations = invalidations_.load(std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        out.entries += shard.lru.size();
+        out.bytes += shard.bytes;
+    }
+    return out;
+}
+
+} // namespace engine
+} // namespace titaninfer
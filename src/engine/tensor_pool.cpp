@@ -0,0 +1,104 @@
+#include "titaninfer/engine/tensor_pool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace titaninfer {
+namespace engine {
+
+namespace {
+
+size_t class_bytes(size_t size_class) {
+    return (size_t{1} << size_class) * sizeof(float);
+}
+
+} // anonymous namespace
+
+std::shared_ptr<TensorPool> TensorPool::create(const TensorPoolConfig& config) {
+    return std::shared_ptr<TensorPool>(new TensorPool(config));
+}
+
+TensorPool::TensorPool(const TensorPoolConfig& config)
+    : config_(config) {}
+
+TensorPool::~TensorPool() {
+    for (auto& list : free_) {
+        for (float* buffer : list) std::free(buffer);
+    }
+}
+
+std::shared_ptr<float> TensorPool::acquire_buffer(size_t count) {
+    size_t size_class = std::max<size_t>(
+        MIN_CLASS, std::bit_width(std::max<size_t>(count, 1) - 1));
+    float* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& list = free_[size_class];
+        if (!list.empty()) {
+            buffer = list.back();
+            list.pop_back();
+            retained_bytes_ -= class_bytes(size_class);
+        }
+    }
+    if (buffer) {
+        reused_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        buffer = static_cast<float*>(std::aligned_alloc(
+            ALIGNMENT, class_bytes(size_class)));
+        if (!buffer) throw std::bad_alloc();
+        allocated_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::weak_ptr<TensorPool> pool = weak_from_this();
+    return std::shared_ptr<float>(buffer, [pool, size_class](float* p) {
+        if (auto self = pool.lock()) {
+            self->recycle(p, size_class);
+        } else {
+            std::free(p);
+        }
+    });
+}
+
+Tensor TensorPool::acquire(const std::vector<size_t>& shape) {
+    size_t count = 1;
+    for (size_t dim : shape) count *= dim;
+    auto buffer = acquire_buffer(count);
+    float* data = buffer.get();
+    return Tensor::view(data, shape, std::move(buffer));
+}
+
+Tensor TensorPool::copy_of(const Tensor& source) {
+    Tensor copy = acquire(source.shape());
+    std::memcpy(copy.data(), source.data(), source.size() * sizeof(float));
+    return copy;
+}
+
+TensorPoolStats TensorPool::stats() const {
+    TensorPoolStats out;
+    out.reused = reused_.load(std::memory_order_relaxed);
+    out.allocated = allocated_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    out.cached_bytes = retained_bytes_;
+    return out;
+}
+
+void TensorPool::recycle(float* buffer, size_t size_class) {
+    const size_t bytes = class_bytes(size_class);
+    if (bytes <= config_.max_buffer_bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& list = free_[size_class];
+        if (list.size() < config_.max_free_per_class &&
+            bytes <= config_.max_retained_bytes - retained_bytes_) {
+            list.push_back(buffer);
+            retained_bytes_ += bytes;
+            return;
+        }
+    }
+    std::free(buffer);
+}
+
+} // namespace engine
+} // namespace titaninfer
@@ -1,13 +1,9 @@
 #include "titaninfer/engine/thread_pool.hpp"
 
-#include <algorithm>
-
 namespace titaninfer {
 namespace engine {
 
-ThreadPool::ThreadPool(size_t num_threads)
-    : stop_(false)
-{
+ThreadPool::ThreadPool(size_t num_threads, size_t queue_capacity) {
     if (num_threads == 0) {
         num_threads = std::thread::hardware_concurrency();
         if (num_threads == 0) {
@@ -15,38 +11,88 @@ ThreadPool::ThreadPool(size_t num_threads)
         }
     }
 
+    for (auto& lane : lanes_) {
+        lane = std::make_unique<MpmcQueue<Task>>(queue_capacity);
+    }
+
     workers_.reserve(num_threads);
     for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back([this] {
-            for (;;) {
-                std::function<void()> task;
-                {
-                    std::unique_lock<std::mutex> lock(mutex_);
-                    condition_.wait(lock, [this] {
-                        return stop_ || !tasks_.empty();
-                    });
-                    if (stop_ && tasks_.empty()) {
-                        return;
-                    }
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
-                }
-                task();
-            }
-        });
+        workers_.emplace_back([this] { worker_loop(); });
     }
 }
 
 ThreadPool::~ThreadPool() {
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        stop_ = true;
-    }
-    condition_.notify_all();
+    stop_.store(true, std::memory_order_seq_cst);
+    idle_.notify_all();
     for (auto& worker : workers_) {
         worker.join();
     }
 }
 
+bool ThreadPool::enqueue(Task task, TaskPriority priority) {
+    if (stop_.load(std::memory_order_relaxed)) {
+        throw std::runtime_error("ThreadPool: submit on stopped pool");
+    }
+
+    // Count first so a worker that pops the task never sees pending_ < 0
+    pending_.fetch_add(1, std::memory_order_seq_cst);
+    if (!lanes_[static_cast<size_t>(priority)]->try_push(std::move(task))) {
+        pending_.fetch_sub(1, std::memory_order_seq_cst);
+        return false;
+    }
+    idle_.notify_one();
+    return true;
+}
+
+std::optional<ThreadPool::Task> ThreadPool::try_dequeue() {
+    // Starvation protection: a lower lane bypassed too often goes next
+    for (size_t lane = 1; lane < NUM_LANES; ++lane) {
+        if (bypassed_[lane].load(std::memory_order_relaxed) >= STARVATION_LIMIT) {
+            bypassed_[lane].store(0, std::memory_order_relaxed);
+            if (auto task = lanes_[lane]->try_pop()) {
+                return task;
+            }
+        }
+    }
+
+    for (size_t lane = 0; lane < NUM_LANES; ++lane) {
+        if (auto task = lanes_[lane]->try_pop()) {
+            bypassed_[lane].store(0, std::memory_order_relaxed);
+            for (size_t lower = lane + 1; lower < NUM_LANES; ++lower) {
+                if (!lanes_[lower]->empty_approx()) {
+                    bypassed_[lower].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+void ThreadPool::worker_loop() {
+    for (;;) {
+        std::optional<Task> task = try_dequeue();
+        if (!task) {
+            idle_.wait([this] {
+                return stop_.load(std::memory_order_seq_cst) ||
+                       pending_.load(std::memory_order_seq_cst) > 0;
+            });
+            if (stop_.load(std::memory_order_seq_cst) &&
+                pending_.load(std::memory_order_seq_cst) <= 0) {
+                return;
+            }
+            continue;
+        }
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+
+        bool expired = task->deadline != std::chrono::steady_clock::time_point::max() &&
+                       std::chrono::steady_clock::now() >= task->deadline;
+        if (expired) {
+            cancelled_.fetch_add(1, std::memory_order_relaxed);
+        }
+        task->run(expired);
+    }
+}
+
 } // namespace engine
 } // namespace titaninfer
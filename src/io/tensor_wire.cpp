@@ -0,0 +1,163 @@
+#include "titaninfer/io/tensor_wire.hpp"
+#include "titaninfer/exceptions.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace titaninfer {
+namespace io {
+
+namespace {
+
+constexpr bool HOST_LITTLE_ENDIAN = std::endian::native == std::endian::little;
+
+template <typename T>
+void put_le(char* out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xff);
+    }
+}
+
+template <typename T>
+T get_le(const char* in) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+[[noreturn]] void malformed(const std::string& what) {
+    throw ValidationException("TensorWire: " + what, ErrorCode::INVALID_FORMAT);
+}
+
+void check_prefix(const char* data) {
+    if (std::memcmp(data, TENSOR_WIRE_MAGIC, 4) != 0) {
+        malformed("bad magic");
+    }
+    if (static_cast<uint8_t>(data[4]) != TENSOR_WIRE_VERSION) {
+        malformed("unsupported version " +
+                  std::to_string(static_cast<unsigned>(
+                      static_cast<uint8_t>(data[4]))));
+    }
+}
+
+} // anonymous namespace
+
+size_t TensorWire::header_size(size_t ndim) {
+    size_t raw = FIXED_HEADER_BYTES + 8 * ndim;
+    return (raw + TENSOR_WIRE_ALIGNMENT - 1) / TENSOR_WIRE_ALIGNMENT *
+           TENSOR_WIRE_ALIGNMENT;
+}
+
+std::string TensorWire::encode_header(const Tensor& tensor) {
+    const auto& shape = tensor.shape();
+    if (shape.empty() || shape.size() > TENSOR_WIRE_MAX_DIMS) {
+        throw ValidationException(
+            "TensorWire: cannot encode a tensor with " +
+            std::to_string(shape.size()) + " dimensions",
+            ErrorCode::SHAPE_MISMATCH);
+    }
+
+    std::string header(header_size(shape.size()), '\0');
+    char* out = header.data();
+    std::memcpy(out, TENSOR_WIRE_MAGIC, 4);
+    out[4] = static_cast<char>(TENSOR_WIRE_VERSION);
+    out[5] = static_cast<char>(WireDType::FLOAT32);
+    out[6] = static_cast<char>(shape.size());
+    put_le<uint32_t>(out + 8, static_cast<uint32_t>(header.size()));
+    put_le<uint64_t>(out + 16, tensor.size() * sizeof(float));
+    for (size_t i = 0; i < shape.size(); ++i) {
+        put_le<uint64_t>(out + FIXED_HEADER_BYTES + 8 * i, shape[i]);
+    }
+    return header;
+}
+
+std::string TensorWire::encode(const Tensor& tensor) {
+    std::string frame = encode_header(tensor);
+    size_t offset = frame.size();
+    frame.resize(offset + tensor.size() * sizeof(float));
+    char* payload = frame.data() + offset;
+    if constexpr (HOST_LITTLE_ENDIAN) {
+        std::memcpy(payload, tensor.data(), tensor.size() * sizeof(float));
+    } else {
+        for (size_t i = 0; i < tensor.size(); ++i) {
+            put_le<uint32_t>(payload + 4 * i,
+                             std::bit_cast<uint32_t>(tensor.data()[i]));
+        }
+    }
+    return frame;
+}
+
+size_t TensorWire::frame_size(const char* data, size_t size) {
+    if (size < FIXED_HEADER_BYTES) return 0;
+    check_prefix(data);
+    return get_le<uint32_t>(data + 8) + get_le<uint64_t>(data + 16);
+}
+
+Tensor TensorWire::decode(const char* data, size_t size,
+                          std::shared_ptr<void> keepalive) {
+    if (size < FIXED_HEADER_BYTES) {
+        malformed("truncated header");
+    }
+    check_prefix(data);
+    if (static_cast<uint8_t>(data[5]) !=
+        static_cast<uint8_t>(WireDType::FLOAT32)) {
+        malformed("unsupported dtype");
+    }
+
+    size_t ndim = static_cast<uint8_t>(data[6]);
+    size_t header_bytes = get_le<uint32_t>(data + 8);
+    uint64_t payload_bytes = get_le<uint64_t>(data + 16);
+    if (ndim == 0 || ndim > TENSOR_WIRE_MAX_DIMS) {
+        malformed("bad rank " + std::to_string(ndim));
+    }
+    if (header_bytes < FIXED_HEADER_BYTES + 8 * ndim ||
+        header_bytes % TENSOR_WIRE_ALIGNMENT != 0 || header_bytes > size) {
+        malformed("bad header length");
+    }
+    if (payload_bytes != size - header_bytes) {
+        malformed("payload length does not match frame size");
+    }
+
+    std::vector<size_t> shape(ndim);
+    uint64_t count = 1;
+    for (size_t i = 0; i < ndim; ++i) {
+        uint64_t dim = get_le<uint64_t>(data + FIXED_HEADER_BYTES + 8 * i);
+        if (dim == 0 || count > std::numeric_limits<uint64_t>::max() / dim) {
+            malformed("bad dimension");
+        }
+        count *= dim;
+        shape[i] = static_cast<size_t>(dim);
+    }
+    // Division, not count * 4: a huge shape must not wrap onto the payload
+    if (count != payload_bytes / sizeof(float) ||
+        payload_bytes % sizeof(float) != 0) {
+        malformed("payload length does not match shape");
+    }
+
+    const char* payload = data + header_bytes;
+    if (HOST_LITTLE_ENDIAN &&
+        reinterpret_cast<uintptr_t>(payload) % alignof(float) == 0) {
+        // The view never writes through the pointer handed to it
+        return Tensor::view(reinterpret_cast<float*>(const_cast<char*>(payload)),
+                            shape, std::move(keepalive));
+    }
+
+    Tensor tensor(shape);
+    if constexpr (HOST_LITTLE_ENDIAN) {
+        std::memcpy(tensor.data(), payload, payload_bytes);
+    } else {
+        for (size_t i = 0; i < tensor.size(); ++i) {
+            tensor.data()[i] = std::bit_cast<float>(
+                get_le<uint32_t>(payload + 4 * i));
+        }
+    }
+    return tensor;
+}
+
+} // namespace io
+} // namespace titaninfer
@@ -55,6 +55,29 @@ Conv2DLayer::Conv2DLayer(size_t in_channels, size_t out_channels,
 {
 }
 
+Conv2DLayer::Conv2DLayer(const Conv2DLayer& source,
+                         const std::shared_ptr<void>& owner)
+    : in_channels_(source.in_channels_)
+    , out_channels_(source.out_channels_)
+    , kernel_h_(source.kernel_h_)
+    , kernel_w_(source.kernel_w_)
+    , stride_h_(source.stride_h_)
+    , stride_w_(source.stride_w_)
+    , padding_(source.padding_)
+    , use_bias_(source.use_bias_)
+    , weights_(alias(source.weights_, owner))
+    , bias_(alias(source.bias_, owner))
+    , col_buf_({1})
+    , weights_2d_(alias(source.weights_2d_, owner))
+    , gemm_buf_({1})
+{
+}
+
+std::unique_ptr<Layer> Conv2DLayer::clone_shared(
+        const std::shared_ptr<void>& owner) const {
+    return std::unique_ptr<Layer>(new Conv2DLayer(*this, owner));
+}
+
 std::unique_ptr<Layer> Conv2DLayer::clone() const {
     auto copy = std::make_unique<Conv2DLayer>(
         in_channels_, out_channels_, kernel_h_, kernel_w_,
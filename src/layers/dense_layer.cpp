@@ -10,6 +10,7 @@ DenseLayer::DenseLayer(size_t in_features, size_t out_features, bool use_bias)
     , use_bias_(use_bias)
     , weights_({out_features, in_features})
     , bias_({out_features})
+    , weights_t_({1})
 {
     if (in_features == 0 || out_features == 0) {
         throw std::invalid_argument(
@@ -17,6 +18,24 @@ DenseLayer::DenseLayer(size_t in_features, size_t out_features, bool use_bias)
     }
 }
 
+DenseLayer::DenseLayer(const DenseLayer& source,
+                       const std::shared_ptr<void>& owner)
+    : in_features_(source.in_features_)
+    , out_features_(source.out_features_)
+    , use_bias_(source.use_bias_)
+    , weights_(alias(source.weights_, owner))
+    , bias_(alias(source.bias_, owner))
+    , weights_t_(source.weights_t_stale_ ? Tensor({1})
+                                         : alias(source.weights_t_, owner))
+    , weights_t_stale_(source.weights_t_stale_)
+{
+}
+
+std::unique_ptr<Layer> DenseLayer::clone_shared(
+        const std::shared_ptr<void>& owner) const {
+    return std::unique_ptr<Layer>(new DenseLayer(*this, owner));
+}
+
 std::unique_ptr<Layer> DenseLayer::clone() const {
     auto copy = std::make_unique<DenseLayer>(in_features_, out_features_, use_bias_);
     copy->set_weights(weights_);
@@ -53,9 +72,12 @@ void DenseLayer::forward(const Tensor& input, Tensor& output) {
                 std::to_string(input.shape()[1]));
         }
 
-        Tensor wt({in_features_, out_features_});
-        ops::transpose(weights_, wt);
-        ops::matmul(input, wt, output);
+        if (weights_t_stale_) {
+            weights_t_ = Tensor({in_features_, out_features_});
+            ops::transpose(weights_, weights_t_);
+            weights_t_stale_ = false;
+        }
+        ops::matmul(input, weights_t_, output);
 
         if (use_bias_) {
             const size_t batch = input.shape()[0];
@@ -114,6 +136,7 @@ void DenseLayer::set_weights(const Tensor& weights) {
             std::to_string(weights.shape()[1]) + ")");
     }
     weights_ = weights;
+    weights_t_stale_ = true;
 }
 
 void DenseLayer::set_bias(const Tensor& bias) {
@@ -8,6 +8,20 @@
 namespace titaninfer {
 namespace layers {
 
+namespace {
+
+// W^T for batched input; the weights of a fused layer never change, so
+// it is built once, on the layer's first batch
+const Tensor& transposed(const Tensor& weights, Tensor& cache) {
+    if (cache.ndim() != 2) {
+        cache = Tensor({weights.shape()[1], weights.shape()[0]});
+        ops::transpose(weights, cache);
+    }
+    return cache;
+}
+
+} // anonymous namespace
+
 // ========================================
 // FusedDenseReluLayer
 // ========================================
@@ -53,9 +67,7 @@ void FusedDenseReluLayer::forward(const Tensor& input, Tensor& output) {
             throw std::invalid_argument("FusedDenseReluLayer: input features mismatch");
         }
 
-        Tensor wt({in_features_, out_features_});
-        ops::transpose(weights_, wt);
-        ops::matmul(input, wt, output);
+        ops::matmul(input, transposed(weights_, weights_t_), output);
 
         // Fused bias + ReLU
         const size_t batch = input.shape()[0];
@@ -135,9 +147,7 @@ void FusedDenseSigmoidLayer::forward(const Tensor& input, Tensor& output) {
             throw std::invalid_argument("FusedDenseSigmoidLayer: input features mismatch");
         }
 
-        Tensor wt({in_features_, out_features_});
-        ops::transpose(weights_, wt);
-        ops::matmul(input, wt, output);
+        ops::matmul(input, transposed(weights_, weights_t_), output);
 
         const size_t batch = input.shape()[0];
         for (size_t r = 0; r < batch; ++r) {
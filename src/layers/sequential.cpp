@@ -96,6 +96,15 @@ const Layer& Sequential::layer(size_t index) const {
     return *layers_[index];
 }
 
+std::unique_ptr<Sequential> Sequential::clone_shared(
+        const std::shared_ptr<void>& owner) const {
+    auto copy = std::make_unique<Sequential>();
+    for (const auto& l : layers_) {
+        copy->add(l->clone_shared(owner));
+    }
+    return copy;
+}
+
 size_t Sequential::total_parameters() const {
     size_t total = 0;
     for (const auto& l : layers_) {
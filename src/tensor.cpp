@@ -35,6 +35,20 @@ Tensor::Tensor(const std::vector<size_t>& shape)
 Tensor::Tensor(std::initializer_list<size_t> shape)
     : Tensor(std::vector<size_t>(shape)) {}
 
+Tensor Tensor::view(float* data, const std::vector<size_t>& shape,
+                    std::shared_ptr<void> keepalive) {
+    validate_shape(shape);
+
+    Tensor result;
+    result.data_ = data;
+    result.shape_ = shape;
+    result.size_ = std::accumulate(shape.begin(), shape.end(),
+                                   size_t(1), std::multiplies<size_t>());
+    result.owns_data_ = false;
+    result.keepalive_ = std::move(keepalive);
+    return result;
+}
+
 Tensor::Tensor(const Tensor& other)
     : data_(nullptr), shape_(other.shape_), size_(other.size_) {
     
@@ -43,14 +57,16 @@ Tensor::Tensor(const Tensor& other)
 }
 
 Tensor::Tensor(Tensor&& other) noexcept
-    : data_(other.data_), shape_(std::move(other.shape_)), size_(other.size_) {
+    : data_(other.data_), shape_(std::move(other.shape_)), size_(other.size_)
+    , owns_data_(other.owns_data_), keepalive_(std::move(other.keepalive_)) {
     
     other.data_ = nullptr;
     other.size_ = 0;
+    other.owns_data_ = true;
 }
 
 Tensor::~Tensor() {
-    deallocate_aligned(data_);
+    release();
 }
 
 // ========================================
@@ -59,8 +75,8 @@ Tensor::~Tensor() {
 
 Tensor& Tensor::operator=(const Tensor& other) {
     if (this != &other) {
-        // Deallocate old memory
-        deallocate_aligned(data_);
+        // Deallocate old memory (copies are always owning)
+        release();
         
         // Copy metadata
         shape_ = other.shape_;
@@ -76,16 +92,19 @@ Tensor& Tensor::operator=(const Tensor& other) {
 Tensor& Tensor::operator=(Tensor&& other) noexcept {
     if (this != &other) {
         // Deallocate old memory
-        deallocate_aligned(data_);
+        release();
         
         // Move ownership
         data_ = other.data_;
         shape_ = std::move(other.shape_);
         size_ = other.size_;
+        owns_data_ = other.owns_data_;
+        keepalive_ = std::move(other.keepalive_);
         
         // Nullify source
         other.data_ = nullptr;
         other.size_ = 0;
+        other.owns_data_ = true;
     }
     return *this;
 }
@@ -178,6 +197,15 @@ void Tensor::deallocate_aligned(float* ptr) {
 #endif
 }
 
+void Tensor::release() noexcept {
+    if (owns_data_) {
+        deallocate_aligned(data_);
+    }
+    data_ = nullptr;
+    owns_data_ = true;
+    keepalive_.reset();
+}
+
 void Tensor::validate_shape(const std::vector<size_t>& shape) {
     if (shape.empty()) {
         throw std::invalid_argument("Tensor shape cannot be empty");
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "titaninfer/engine/demand_predictor.hpp"
+
+using namespace titaninfer::engine;
+
+namespace {
+
+PrefetchConfig make_config(size_t season_buckets, double alpha = 0.5) {
+    PrefetchConfig config;
+    config.enabled = true;
+    config.season_buckets = season_buckets;
+    config.alpha = alpha;
+    config.seasonal_alpha = 0.5;
+    return config;
+}
+
+} // namespace
+
+TEST(DemandPredictorTest, UnknownModelForecastsZero) {
+    DemandPredictor predictor(make_config(0));
+    EXPECT_DOUBLE_EQ(predictor.forecast({"m", 1}), 0.0);
+    EXPECT_TRUE(predictor.ranked().empty());
+}
+
+TEST(DemandPredictorTest, LevelTracksAndDecays) {
+    DemandPredictor predictor(make_config(0, 0.5));
+    const ModelKey key{"m", 1};
+
+    predictor.record(key, 8);
+    predictor.advance();
+    EXPECT_DOUBLE_EQ(predictor.forecast(key), 4.0);
+
+    predictor.record(key, 8);
+    predictor.advance();
+    EXPECT_DOUBLE_EQ(predictor.forecast(key), 6.0);
+
+    // Idle buckets decay the level
+    predictor.advance();
+    predictor.advance();
+    EXPECT_DOUBLE_EQ(predictor.forecast(key), 1.5);
+    EXPECT_EQ(predictor.bucket(), 4u);
+}
+
+TEST(DemandPredictorTest, SeasonalPhaseForecastsPeriodicJob) {
+    // Season of 4 buckets; the job only runs in phase 2
+    DemandPredictor predictor(make_config(4, 0.1));
+    const ModelKey job{"job", 1};
+
+    for (int bucket = 0; bucket < 4; ++bucket) {
+        if (bucket == 2) predictor.record(job, 10);
+        predictor.advance();
+    }
+
+    // Next season: quiet in phases 0-1, forecast high for phase 2
+    EXPECT_LT(predictor.forecast(job), 1.0);   // phase 0
+    predictor.advance();
+    predictor.advance();
+    EXPECT_EQ(predictor.bucket() % 4, 2u);
+    EXPECT_DOUBLE_EQ(predictor.forecast(job), 10.0);
+}
+
+TEST(DemandPredictorTest, RankedHighestFirst) {
+    DemandPredictor predictor(make_config(0, 1.0));
+    predictor.record({"a", 1}, 1);
+    predictor.record({"b", 1}, 5);
+    predictor.record({"c", 2}, 3);
+    predictor.advance();
+
+    auto ranked = predictor.ranked();
+    ASSERT_EQ(ranked.size(), 3u);
+    EXPECT_EQ(ranked[0].first, (ModelKey{"b", 1}));
+    EXPECT_EQ(ranked[1].first, (ModelKey{"c", 2}));
+    EXPECT_EQ(ranked[2].first, (ModelKey{"a", 1}));
+    EXPECT_DOUBLE_EQ(ranked[0].second, 5.0);
+}
@@ -2,8 +2,13 @@
 #include "titaninfer/engine/dynamic_batcher.hpp"
 #include "titaninfer/layers/dense_layer.hpp"
 #include "titaninfer/layers/activation_layer.hpp"
+#include "titaninfer/exceptions.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -31,6 +36,85 @@ std::unique_ptr<Sequential> make_simple_model() {
     return model;
 }
 
+/// Identity layer that logs each batch's first value and blocks until opened
+struct Gate {
+    void wait_for_batches(size_t n) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return log.size() >= n; });
+    }
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_open = true;
+        cv.notify_all();
+    }
+    std::vector<float> seen() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return log;
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool is_open = false;
+    std::vector<float> log;
+};
+
+class GateLayer : public Layer {
+public:
+    explicit GateLayer(std::shared_ptr<Gate> gate) : gate_(std::move(gate)) {}
+
+    std::unique_ptr<Layer> clone() const override {
+        return std::make_unique<GateLayer>(gate_);
+    }
+
+    void forward(const Tensor& input, Tensor& output) override {
+        {
+            std::unique_lock<std::mutex> lock(gate_->mutex);
+            gate_->log.push_back(input.data()[0]);
+            gate_->cv.notify_all();
+            gate_->cv.wait(lock, [this] { return gate_->is_open; });
+        }
+        if (output.shape() != input.shape()) {
+            output = Tensor(input.shape());
+        }
+        std::copy(input.data(), input.data() + input.size(), output.data());
+    }
+
+    std::string name() const override { return "Gate"; }
+
+private:
+    std::shared_ptr<Gate> gate_;
+};
+
+/// Identity layer that counts batches mixing rows with different values
+class UniformBatchLayer : public Layer {
+public:
+    explicit UniformBatchLayer(std::shared_ptr<std::atomic<int>> mixed)
+        : mixed_(std::move(mixed)) {}
+
+    std::unique_ptr<Layer> clone() const override {
+        return std::make_unique<UniformBatchLayer>(mixed_);
+    }
+
+    void forward(const Tensor& input, Tensor& output) override {
+        const size_t width = input.shape().back();
+        for (size_t i = width; i < input.size(); i += width) {
+            if (input.data()[i] != input.data()[0]) {
+                mixed_->fetch_add(1);
+                break;
+            }
+        }
+        if (output.shape() != input.shape()) {
+            output = Tensor(input.shape());
+        }
+        std::copy(input.data(), input.data() + input.size(), output.data());
+    }
+
+    std::string name() const override { return "UniformBatch"; }
+
+private:
+    std::shared_ptr<std::atomic<int>> mixed_;
+};
+
 } // anonymous namespace
 
 TEST(DynamicBatcherTest, SingleRequest) {
@@ -156,3 +240,478 @@ TEST(DynamicBatcherTest, OutputMatchesDirect) {
         EXPECT_NEAR(batched.data()[i], direct.data()[i], 1e-5f);
     }
 }
+
+TEST(DynamicBatcherTest, FullQueueRejects) {
+    auto model = make_simple_model();
+    BatcherConfig config;
+    config.max_batch_size = 1;
+    config.max_wait_ms = 1;
+    config.queue_capacity = 2;
+    DynamicBatcher batcher(*model, {4}, config);
+
+    // Flood faster than the batcher drains; every future must resolve,
+    // either with a result or with a QUEUE_FULL rejection.
+    std::vector<std::future<Tensor>> futures;
+    for (int i = 0; i < 200; ++i) {
+        Tensor input({4});
+        input.fill(1.0f);
+        futures.push_back(batcher.submit(std::move(input)));
+    }
+
+    size_t ok = 0;
+    for (auto& f : futures) {
+        try {
+            EXPECT_EQ(f.get().shape()[0], 2u);
+            ++ok;
+        } catch (const TitanInferException& e) {
+            EXPECT_EQ(e.error_code(), ErrorCode::QUEUE_FULL);
+        }
+    }
+    EXPECT_GE(ok, 1u);
+    EXPECT_EQ(batcher.metrics().rejected_full, futures.size() - ok);
+}
+
+// ============================================================
+// Adaptive batching policy
+// ============================================================
+
+TEST(AdaptiveBatchPolicyTest, ColdStartTakesQueuedWithoutWaiting) {
+    BatcherConfig config;
+    config.max_batch_size = 16;
+    config.max_wait_ms = 7;
+    AdaptiveBatchPolicy policy(config);
+
+    auto d = policy.decide(std::chrono::steady_clock::now());
+    EXPECT_EQ(d.batch_size, 16u);
+    EXPECT_EQ(d.max_wait.count(), 0);
+}
+
+TEST(AdaptiveBatchPolicyTest, LowLoadDoesNotWait) {
+    BatcherConfig config;
+    config.max_batch_size = 16;
+    config.max_wait_ms = 10;
+    config.target_p99_ms = 20.0;
+    AdaptiveBatchPolicy policy(config);
+    policy.record_batch(1, 1.0);
+    policy.record_batch(8, 2.0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    policy.decide(t0);
+    // One arrival per 100 ms: waiting for a second request is never worth it
+    policy.record_arrival();
+    auto d = policy.decide(t0 + std::chrono::milliseconds(100));
+
+    EXPECT_EQ(d.batch_size, 1u);
+    EXPECT_EQ(d.max_wait.count(), 0);
+}
+
+TEST(AdaptiveBatchPolicyTest, HighLoadGrowsBatchWithinBudget) {
+    BatcherConfig config;
+    config.max_batch_size = 32;
+    config.max_wait_ms = 10;
+    config.target_p99_ms = 8.0;
+    AdaptiveBatchPolicy policy(config);
+    // Strong batching gains: exec(b) = 1 + 0.1 b
+    policy.record_batch(1, 1.1);
+    policy.record_batch(16, 2.6);
+
+    auto t = std::chrono::steady_clock::now();
+    policy.decide(t);
+    AdaptiveBatchPolicy::Decision d{};
+    for (int step = 0; step < 500; ++step) {
+        for (int i = 0; i < 20; ++i) {
+            policy.record_arrival();  // 20 requests per ms
+        }
+        t += std::chrono::milliseconds(1);
+        d = policy.decide(t);
+    }
+
+    EXPECT_GT(d.batch_size, 16u);
+    double fill_ms = static_cast<double>(d.max_wait.count()) / 1000.0;
+    EXPECT_LE(fill_ms + 1.0 + 0.1 * static_cast<double>(d.batch_size),
+              config.target_p99_ms + 1e-6);
+
+    auto state = policy.state();
+    EXPECT_NEAR(state.arrival_rate_per_ms, 20.0, 2.0);
+    EXPECT_EQ(state.batch_size, d.batch_size);
+    EXPECT_EQ(state.batches_observed, 2u);
+    ASSERT_EQ(state.exec_ms_by_size.size(), 32u);
+    EXPECT_DOUBLE_EQ(state.exec_ms_by_size[0], 1.1);
+}
+
+TEST(AdaptiveBatchPolicyTest, SloViolationShrinksBudget) {
+    BatcherConfig config;
+    config.target_p99_ms = 10.0;
+    AdaptiveBatchPolicy policy(config);
+    policy.record_batch(1, 1.0);
+    for (int i = 0; i < 100; ++i) {
+        policy.record_latency(50.0);
+    }
+
+    auto t = std::chrono::steady_clock::now();
+    policy.decide(t);
+    policy.decide(t + std::chrono::milliseconds(1));
+
+    auto state = policy.state();
+    EXPECT_DOUBLE_EQ(state.observed_p99_ms, 50.0);
+    EXPECT_LT(state.latency_budget_ms, config.target_p99_ms);
+}
+
+TEST(DynamicBatcherTest, AdaptiveModeServesRequests) {
+    auto model = make_simple_model();
+    BatcherConfig config;
+    config.max_batch_size = 8;
+    config.max_wait_ms = 200;
+    config.adaptive = true;
+    config.target_p99_ms = 100.0;
+    DynamicBatcher batcher(*model, {4}, config);
+
+    for (int i = 0; i < 20; ++i) {
+        Tensor input({4});
+        input.fill(1.0f);
+        EXPECT_EQ(batcher.submit(std::move(input)).get().shape()[0], 2u);
+    }
+
+    auto state = batcher.policy_state();
+    EXPECT_GE(state.batches_observed, 1u);
+    // Sequential low-rate traffic must not keep paying the 200 ms timeout
+    EXPECT_EQ(state.batch_size, 1u);
+    EXPECT_LT(state.observed_p99_ms, 200.0);
+}
+
+TEST(DynamicBatcherTest, MultipleWorkersMatchDirect) {
+    auto model = make_simple_model();
+    BatcherConfig config;
+    config.max_batch_size = 4;
+    config.max_wait_ms = 2;
+    config.num_workers = 3;
+    DynamicBatcher batcher(*model, {4}, config);
+    EXPECT_EQ(batcher.worker_count(), 3u);
+
+    constexpr int N_THREADS = 6;
+    constexpr int PER_THREAD = 20;
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < N_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                Tensor input({4});
+                input.fill(static_cast<float>(t + i) * 0.1f);
+                Tensor expected_input({4});
+                expected_input.fill(static_cast<float>(t + i) * 0.1f);
+                // Reference computed on a private model to avoid sharing
+                auto reference = make_simple_model();
+                Tensor expected = reference->forward(expected_input);
+
+                Tensor result = batcher.submit(std::move(input)).get();
+                for (size_t k = 0; k < expected.size(); ++k) {
+                    if (std::abs(result.data()[k] - expected.data()[k]) > 1e-5f) {
+                        mismatches.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+TEST(DynamicBatcherTest, MultipleWorkersDrainOnDestruction) {
+    auto model = make_simple_model();
+    std::vector<std::future<Tensor>> futures;
+    {
+        BatcherConfig config;
+        config.max_batch_size = 2;
+        config.max_wait_ms = 50;
+        config.num_workers = 2;
+        DynamicBatcher batcher(*model, {4}, config);
+        for (int i = 0; i < 9; ++i) {
+            Tensor input({4});
+            input.fill(1.0f);
+            futures.push_back(batcher.submit(std::move(input)));
+        }
+    }
+    for (auto& f : futures) {
+        EXPECT_EQ(f.get().shape()[0], 2u);
+    }
+}
+
+TEST(DynamicBatcherTest, ReservedSlotWritesInPlace) {
+    auto model = make_simple_model();
+    DynamicBatcher batcher(*model, {4}, {8, 5});
+
+    auto slot = batcher.reserve();
+    ASSERT_TRUE(slot.tensor().is_view());
+    ASSERT_EQ(slot.tensor().shape(), std::vector<size_t>{4});
+    for (size_t i = 0; i < 4; ++i) slot.tensor().data()[i] = static_cast<float>(i);
+
+    Tensor input({4});
+    for (size_t i = 0; i < 4; ++i) input.data()[i] = static_cast<float>(i);
+    Tensor direct = model->forward(input);
+
+    Tensor result = batcher.submit(std::move(slot)).get();
+    EXPECT_TRUE(result.is_view());  // view into the pooled output buffer
+    ASSERT_EQ(result.shape(), direct.shape());
+    for (size_t i = 0; i < direct.size(); ++i) {
+        EXPECT_NEAR(result.data()[i], direct.data()[i], 1e-5f);
+    }
+}
+
+TEST(DynamicBatcherTest, DroppedSlotIsSkipped) {
+    auto model = make_simple_model();
+    DynamicBatcher batcher(*model, {4}, {8, 5});
+
+    { auto abandoned = batcher.reserve(); }
+    Tensor input({4});
+    input.fill(1.0f);
+    EXPECT_EQ(batcher.submit(std::move(input)).get().shape()[0], 2u);
+}
+
+TEST(DynamicBatcherTest, SlowFillerDoesNotStallOtherBatches) {
+    auto model = make_simple_model();
+    BatcherConfig config;
+    config.max_batch_size = 1;  // reserving a row seals its arena at once
+    config.max_wait_ms = 5;
+    DynamicBatcher batcher(*model, {4}, config);
+
+    auto slow = batcher.reserve();  // sealed ahead of the next request
+    Tensor input({4});
+    input.fill(1.0f);
+    auto fast = batcher.submit(input);
+    ASSERT_EQ(fast.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    Tensor expected = model->forward(input);
+    EXPECT_NEAR(fast.get().data()[0], expected.data()[0], 1e-5f);
+
+    slow.tensor().fill(1.0f);
+    Tensor result = batcher.submit(std::move(slow)).get();
+    EXPECT_NEAR(result.data()[0], expected.data()[0], 1e-5f);
+}
+
+TEST(DynamicBatcherTest, ResultsOutliveBatcher) {
+    auto model = make_simple_model();
+    std::vector<Tensor> results;
+    {
+        DynamicBatcher batcher(*model, {4}, {4, 5});
+        for (int i = 0; i < 6; ++i) {
+            Tensor input({4});
+            input.fill(1.0f);
+            results.push_back(batcher.submit(std::move(input)).get());
+        }
+    }
+    Tensor input({4});
+    input.fill(1.0f);
+    Tensor direct = model->forward(input);
+    for (const auto& r : results) {
+        EXPECT_NEAR(r.data()[0], direct.data()[0], 1e-5f);
+        EXPECT_NEAR(r.data()[1], direct.data()[1], 1e-5f);
+    }
+}
+
+TEST(DynamicBatcherTest, WrongInputSizeRejected) {
+    auto model = make_simple_model();
+    DynamicBatcher batcher(*model, {4}, {8, 5});
+
+    Tensor input({3});
+    EXPECT_THROW(batcher.submit(std::move(input)).get(), ValidationException);
+}
+
+TEST(DynamicBatcherTest, ExpiredRequestsAreShed) {
+    auto model = make_simple_model();
+    DynamicBatcher batcher(*model, {4}, {8, 20});
+
+    TaskOptions expired;
+    expired.deadline = std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+
+    std::vector<std::future<Tensor>> live;
+    std::vector<std::future<Tensor>> shed;
+    for (int i = 0; i < 6; ++i) {
+        Tensor input({4});
+        input.fill(static_cast<float>(i));
+        if (i % 2 == 0) {
+            shed.push_back(batcher.submit(std::move(input), expired));
+        } else {
+            live.push_back(batcher.submit(std::move(input)));
+        }
+    }
+
+    for (auto& f : shed) {
+        try {
+            f.get();
+            FAIL() << "expired request was executed";
+        } catch (const InferenceException& e) {
+            EXPECT_EQ(e.error_code(), ErrorCode::DEADLINE_EXCEEDED);
+        }
+    }
+    // Survivors are compacted into a smaller batch with the right outputs
+    for (size_t i = 0; i < live.size(); ++i) {
+        Tensor input({4});
+        input.fill(static_cast<float>(2 * i + 1));
+        Tensor expected = model->forward(input);
+        Tensor result = live[i].get();
+        EXPECT_NEAR(result.data()[0], expected.data()[0], 1e-5f);
+        EXPECT_NEAR(result.data()[1], expected.data()[1], 1e-5f);
+    }
+
+    auto m = batcher.metrics();
+    EXPECT_EQ(m.submitted, 6u);
+    EXPECT_EQ(m.shed_expired, 3u);
+    EXPECT_EQ(m.completed, 3u);
+}
+
+TEST(DynamicBatcherTest, UrgentLaneServedFirst) {
+    auto gate = std::make_shared<Gate>();
+    Sequential model;
+    model.add(std::make_unique<GateLayer>(gate));
+    DynamicBatcher batcher(model, {4}, {8, 1});
+
+    auto input = [](float v) {
+        Tensor t({4});
+        t.fill(v);
+        return t;
+    };
+
+    // Occupy the only worker, then queue one batch per lane behind it
+    auto blocker = batcher.submit(input(0.0f));
+    gate->wait_for_batches(1);
+
+    TaskOptions background;
+    background.priority = TaskPriority::BACKGROUND;
+    TaskOptions urgent;
+    urgent.priority = TaskPriority::LATENCY_CRITICAL;
+    auto slow = batcher.submit(input(2.0f), background);
+    auto fast = batcher.submit(input(1.0f), urgent);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    gate->open();
+    blocker.get();
+    fast.get();
+    slow.get();
+    EXPECT_EQ(gate->seen(), (std::vector<float>{0.0f, 1.0f, 2.0f}));
+    EXPECT_EQ(batcher.metrics().batches, 3u);
+}
+
+TEST(DynamicBatcherTest, BatchesNeverMixLanes) {
+    // Small arenas recycle quickly between lanes; a row claimed from an
+    // arena just reinstalled for another lane must not join its batch
+    auto mixed = std::make_shared<std::atomic<int>>(0);
+    Sequential model;
+    model.add(std::make_unique<UniformBatchLayer>(mixed));
+    BatcherConfig config;
+    config.max_batch_size = 2;
+    config.max_wait_ms = 1;
+    config.queue_capacity = 4;
+    config.num_workers = 2;
+    DynamicBatcher batcher(model, {4}, config);
+
+    std::atomic<int> completed{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 6; ++t) {
+        threads.emplace_back([&, t] {
+            const size_t lane = t % ThreadPool::NUM_LANES;
+            TaskOptions options;
+            options.priority = static_cast<TaskPriority>(lane);
+            for (int i = 0; i < 300; ++i) {
+                Tensor input({4});
+                input.fill(static_cast<float>(lane));
+                try {
+                    Tensor result = batcher.submit(input, options).get();
+                    EXPECT_EQ(result.data()[0], static_cast<float>(lane));
+                    completed.fetch_add(1);
+                } catch (const TitanInferException& e) {
+                    EXPECT_EQ(e.error_code(), ErrorCode::QUEUE_FULL);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_GT(completed.load(), 0);
+    EXPECT_EQ(mixed->load(), 0);
+}
+
+// ============================================================
+// Shape buckets
+// ============================================================
+
+namespace {
+
+std::unique_ptr<Sequential> make_relu_model() {
+    auto model = std::make_unique<Sequential>();
+    model->add(std::make_unique<ReluLayer>());
+    return model;
+}
+
+Tensor ramp(const std::vector<size_t>& shape) {
+    Tensor t(shape);
+    for (size_t i = 0; i < t.size(); ++i) {
+        t.data()[i] = static_cast<float>(i) - 1.0f;
+    }
+    return t;
+}
+
+} // anonymous namespace
+
+TEST(DynamicBatcherBucketTest, RoutesToSmallestFittingBucket) {
+    auto model = make_relu_model();
+    BatcherConfig config;
+    config.max_wait_ms = 1;
+    config.shape_buckets = {{8}, {4}};
+    config.pad_output = PadOutput::KEEP;
+    DynamicBatcher batcher(*model, {4}, config);
+    EXPECT_EQ(batcher.bucket_count(), 2u);
+
+    EXPECT_EQ(batcher.submit(ramp({3})).get().shape(), std::vector<size_t>{4});
+    EXPECT_EQ(batcher.submit(ramp({4})).get().shape(), std::vector<size_t>{4});
+    EXPECT_EQ(batcher.submit(ramp({6})).get().shape(), std::vector<size_t>{8});
+    EXPECT_THROW(batcher.submit(ramp({9})).get(), ValidationException);
+}
+
+TEST(DynamicBatcherBucketTest, CropReturnsRealRegion) {
+    auto model = make_relu_model();
+    BatcherConfig config;
+    config.max_wait_ms = 1;
+    config.shape_buckets = {{4, 4}};
+    config.pad_output = PadOutput::CROP;
+    DynamicBatcher batcher(*model, {4, 4}, config);
+
+    Tensor input = ramp({2, 3});
+    Tensor result = batcher.submit(input).get();
+    ASSERT_EQ(result.shape(), (std::vector<size_t>{2, 3}));
+    for (size_t i = 0; i < input.size(); ++i) {
+        EXPECT_FLOAT_EQ(result.data()[i], std::max(0.0f, input.data()[i]));
+    }
+}
+
+TEST(DynamicBatcherBucketTest, MaskZeroesPadding) {
+    // sigmoid(0) = 0.5, so unmasked padding would be visible
+    Sequential model;
+    model.add(std::make_unique<SigmoidLayer>());
+    BatcherConfig config;
+    config.max_wait_ms = 1;
+    config.shape_buckets = {{2, 4}};
+    config.pad_output = PadOutput::MASK;
+    DynamicBatcher batcher(model, {2, 4}, config);
+
+    // A padded row shares the batch with a full-size one
+    auto padded = batcher.submit(ramp({1, 2}));
+    auto full = batcher.submit(ramp({2, 4}));
+
+    Tensor masked = padded.get();
+    ASSERT_EQ(masked.shape(), (std::vector<size_t>{2, 4}));
+    EXPECT_NEAR(masked(0, 0), 1.0f / (1.0f + std::exp(1.0f)), 1e-5f);
+    EXPECT_NEAR(masked(0, 1), 0.5f, 1e-5f);
+    for (size_t c = 2; c < 4; ++c) EXPECT_FLOAT_EQ(masked(0, c), 0.0f);
+    for (size_t c = 0; c < 4; ++c) EXPECT_FLOAT_EQ(masked(1, c), 0.0f);
+
+    Tensor unpadded = full.get();
+    EXPECT_NEAR(unpadded(1, 3), 1.0f / (1.0f + std::exp(-6.0f)), 1e-5f);
+}
+
+TEST(DynamicBatcherBucketTest, ExactShapeRequiredWithoutBuckets) {
+    auto model = make_relu_model();
+    DynamicBatcher batcher(*model, {4}, {8, 1});
+    EXPECT_THROW(batcher.reserve({3}), ValidationException);
+    EXPECT_EQ(batcher.reserve({4}).tensor().shape(), std::vector<size_t>{4});
+}
@@ -0,0 +1,517 @@
+#include <gtest/gtest.h>
+#include "titaninfer/engine/http_server.hpp"
+#include "titaninfer/io/model_serializer.hpp"
+#include "titaninfer/io/tensor_wire.hpp"
+#include "titaninfer/layers/sequential.hpp"
+#include "titaninfer/layers/dense_layer.hpp"
+#include "titaninfer/layers/activation_layer.hpp"
+#include "titaninfer/logger.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace titaninfer;
+using namespace titaninfer::engine;
+using namespace titaninfer::layers;
+using namespace titaninfer::io;
+
+namespace {
+
+struct TempFile {
+    std::string path;
+    explicit TempFile(const std::string& p) : path(p) {}
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+// Dense(4,8) -> ReLU -> Dense(8,3)
+void save_test_mlp(const std::string& filename) {
+    Sequential model;
+    model.add(std::make_unique<DenseLayer>(4, 8));
+    model.add(std::make_unique<ReluLayer>());
+    model.add(std::make_unique<DenseLayer>(8, 3));
+    ModelSerializer::save(model, filename);
+}
+
+// Blocking loopback client that splits responses by Content-Length
+class Client {
+public:
+    explicit Client(uint16_t port) {
+        fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        ::inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+        connected_ = ::connect(fd_, reinterpret_cast<sockaddr*>(&addr),
+                               sizeof(addr)) == 0;
+        timeval timeout{5, 0};
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+    ~Client() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    bool connected() const { return connected_; }
+
+    // Stop sending, keep reading
+    void shutdown_write() { ::shutdown(fd_, SHUT_WR); }
+
+    // Abortive close: the server sees a reset, not a FIN
+    void reset() {
+        linger abort{1, 0};
+        ::setsockopt(fd_, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    void send(const std::string& bytes) {
+        size_t sent = 0;
+        while (sent < bytes.size()) {
+            ssize_t n = ::send(fd_, bytes.data() + sent, bytes.size() - sent, 0);
+            if (n <= 0) return;
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    // Full response (head + body); empty if the connection closed first
+    std::string read_response() {
+        for (;;) {
+            size_t head_end = buffer_.find("\r\n\r\n");
+            if (head_end != std::string::npos) {
+                size_t length = 0;
+                size_t pos = buffer_.find("Content-Length: ");
+                if (pos != std::string::npos && pos < head_end) {
+                    length = std::stoul(buffer_.substr(pos + 16));
+                }
+                size_t total = head_end + 4 + length;
+                if (buffer_.size() >= total) {
+                    std::string response = buffer_.substr(0, total);
+                    buffer_.erase(0, total);
+                    return response;
+                }
+            }
+            char chunk[4096];
+            ssize_t n = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (n <= 0) return {};
+            buffer_.append(chunk, static_cast<size_t>(n));
+        }
+    }
+
+    // True once the server closed the connection
+    bool closed_by_peer() {
+        char c;
+        return buffer_.empty() && ::recv(fd_, &c, 1, 0) == 0;
+    }
+
+private:
+    int fd_ = -1;
+    bool connected_ = false;
+    std::string buffer_;
+};
+
+std::string predict_request(const std::string& body,
+                            const std::string& extra_headers = "") {
+    return "POST /v1/models/mlp/predict HTTP/1.1\r\n"
+           "Host: localhost\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n" +
+           extra_headers + "\r\n" + body;
+}
+
+int status_of(const std::string& response) {
+    return response.size() > 12 ? std::stoi(response.substr(9, 3)) : 0;
+}
+
+std::string header_of(const std::string& response, const std::string& name) {
+    size_t pos = response.find("\r\n" + name + ": ");
+    if (pos == std::string::npos) return {};
+    pos += name.size() + 4;
+    return response.substr(pos, response.find("\r\n", pos) - pos);
+}
+
+std::string body_of(const std::string& response) {
+    return response.substr(response.find("\r\n\r\n") + 4);
+}
+
+// Holds every ModelServer worker in a completion callback until released,
+// so requests sent meanwhile stay queued
+class WorkerGate {
+public:
+    WorkerGate(ModelServer& server, size_t workers) {
+        std::shared_future<void> opened = open_.get_future().share();
+        for (size_t i = 0; i < workers; ++i) {
+            Request request;
+            request.path = "/v1/models/mlp/predict";
+            request.body = Tensor({4});
+            request.body.zero();
+            server.handle_request_async(std::move(request),
+                                        [opened](Response) { opened.wait(); });
+        }
+    }
+    ~WorkerGate() { release(); }
+
+    void release() {
+        if (!released_) {
+            released_ = true;
+            open_.set_value();
+        }
+    }
+
+private:
+    std::promise<void> open_;
+    bool released_ = false;
+};
+
+// Poll `done` for up to five seconds
+template <typename F>
+bool eventually(F done) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > until) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+class HttpServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Logger::instance().set_level(LogLevel::SILENT);
+        // ctest runs each test in its own process: one file per test
+        model_ = std::make_unique<TempFile>(
+            std::string("test_http_") +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+            ".titan");
+        save_test_mlp(model_->path);
+        server_ = std::make_unique<ModelServer>(
+            ModelServer::Builder().setWorkerThreads(2)
+                .setEnginesPerModel(2).build());
+        server_->register_model("mlp", 1, model_->path);
+    }
+    void TearDown() override {
+        server_.reset();
+        Logger::instance().set_level(LogLevel::INFO);
+    }
+
+    std::unique_ptr<TempFile> model_;
+    std::unique_ptr<ModelServer> server_;
+};
+
+TEST_F(HttpServerTest, PredictOverKeepAliveConnection) {
+    HttpServer http(*server_);
+    http.start();
+    ASSERT_TRUE(http.running());
+    ASSERT_NE(http.port(), 0);
+
+    Client client(http.port());
+    ASSERT_TRUE(client.connected());
+    for (int i = 0; i < 3; ++i) {
+        client.send(predict_request("[1.0, 2.0, 3.0, 4.0]"));
+        std::string response = client.read_response();
+        ASSERT_EQ(status_of(response), 200) << response;
+        EXPECT_EQ(header_of(response, "X-Shape"), "3");
+        EXPECT_EQ(header_of(response, "X-Model-Version"), "1");
+        EXPECT_EQ(header_of(response, "Connection"), "keep-alive");
+        EXPECT_EQ(body_of(response).front(), '[');
+    }
+
+    auto stats = http.stats();
+    EXPECT_EQ(stats.accepted_connections, 1u);
+    EXPECT_EQ(stats.requests, 3u);
+}
+
+TEST_F(HttpServerTest, PipelinedResponsesKeepRequestOrder) {
+    HttpServer http(*server_);
+    http.start();
+
+    Client client(http.port());
+    std::string batch;
+    for (int i = 0; i < 20; ++i) {
+        batch += predict_request("1 2 3 4",
+                                 "X-Request-Id: r" + std::to_string(i) + "\r\n");
+    }
+    client.send(batch);  // one write, many requests
+
+    for (int i = 0; i < 20; ++i) {
+        std::string response = client.read_response();
+        ASSERT_EQ(status_of(response), 200);
+        EXPECT_EQ(header_of(response, "X-Request-Id"), "r" + std::to_string(i));
+    }
+}
+
+TEST_F(HttpServerTest, ShapeHeaderAndErrorsMapToStatus) {
+    HttpServer http(*server_);
+    http.start();
+
+    Client client(http.port());
+    client.send(predict_request("[1,2,3,4]", "X-Shape: 4\r\n"));
+    std::string ok = client.read_response();
+    EXPECT_EQ(status_of(ok), 200) << ok;
+    EXPECT_EQ(header_of(ok, "X-Shape"), "3");
+
+    // ModelServer errors keep the connection open
+    client.send("POST /v1/models/missing/predict HTTP/1.1\r\n"
+                "Content-Length: 7\r\n\r\n1 2 3 4");
+    std::string missing = client.read_response();
+    EXPECT_EQ(status_of(missing), 404);
+    EXPECT_EQ(header_of(missing, "Connection"), "keep-alive");
+
+    // A body that disagrees with X-Shape is answered, then the connection
+    // is closed
+    client.send(predict_request("1 2 3 4", "X-Shape: 5\r\n"));
+    std::string bad = client.read_response();
+    EXPECT_EQ(status_of(bad), 400);
+    EXPECT_EQ(header_of(bad, "Connection"), "close");
+    EXPECT_TRUE(client.closed_by_peer());
+    EXPECT_EQ(http.stats().bad_requests, 1u);
+}
+
+TEST_F(HttpServerTest, OverflowingShapeIsRejected) {
+    HttpServer http(*server_);
+    http.start();
+
+    // 2^60 floats, and 2^63 whose byte size wraps to zero
+    for (const char* shape : {"1152921504606846976", "9223372036854775808",
+                              "4294967296,4294967296"}) {
+        Client client(http.port());
+        client.send(predict_request("1 2 3 4",
+                                    std::string("X-Shape: ") + shape + "\r\n"));
+        std::string response = client.read_response();
+        EXPECT_EQ(status_of(response), 400) << shape << ": " << response;
+        EXPECT_TRUE(client.closed_by_peer());
+    }
+
+    Client client(http.port());
+    client.send(predict_request("1 2 3 4"));
+    EXPECT_EQ(status_of(client.read_response()), 200);
+}
+
+TEST_F(HttpServerTest, ShapeLargerThanBodyIsRejectedUpFront) {
+    HttpServer http(*server_);
+    http.start();
+    const auto before = server_->tensor_pool()->stats().allocated;
+
+    // 10^8 floats cannot be written in seven bytes: nothing is allocated
+    Client client(http.port());
+    client.send(predict_request("1 2 3 4", "X-Shape: 100000000\r\n"));
+    std::string response = client.read_response();
+    EXPECT_EQ(status_of(response), 400) << response;
+    EXPECT_EQ(server_->tensor_pool()->stats().allocated, before);
+}
+
+TEST_F(HttpServerTest, DeadlineHeaderBoundsRequest) {
+    HttpServer http(*server_);
+    http.start();
+
+    Client client(http.port());
+    client.send(predict_request("1 2 3 4", "X-Deadline-Ms: 0\r\n"));
+    std::string expired = client.read_response();
+    EXPECT_EQ(status_of(expired), 504) << expired;
+    EXPECT_EQ(header_of(expired, "Connection"), "keep-alive");
+
+    client.send(predict_request("1 2 3 4", "X-Deadline-Ms: 10000\r\n"));
+    EXPECT_EQ(status_of(client.read_response()), 200);
+    EXPECT_EQ(server_->abort_stats().deadline_exceeded, 1u);
+
+    // Far-off deadlines are capped rather than overflowing into the past
+    client.send(predict_request(
+        "1 2 3 4", "X-Deadline-Ms: 18446744073709551615\r\n"));
+    EXPECT_EQ(status_of(client.read_response()), 200);
+    EXPECT_EQ(server_->abort_stats().deadline_exceeded, 1u);
+
+    client.send(predict_request("1 2 3 4", "X-Deadline-Ms: soon\r\n"));
+    EXPECT_EQ(status_of(client.read_response()), 400);
+}
+
+TEST_F(HttpServerTest, PriorityHeaderPicksLane) {
+    HttpServer http(*server_);
+    http.start();
+
+    Client client(http.port());
+    for (const char* priority : {"latency-critical", "Normal", "background"}) {
+        client.send(predict_request(
+            "1 2 3 4", std::string("X-Priority: ") + priority + "\r\n"));
+        EXPECT_EQ(status_of(client.read_response()), 200) << priority;
+    }
+    client.send(predict_request("1 2 3 4", "X-Priority: urgent\r\n"));
+    EXPECT_EQ(status_of(client.read_response()), 400);
+}
+
+TEST_F(HttpServerTest, DisconnectCancelsQueuedRequest) {
+    HttpServer http(*server_);
+    http.start();
+    WorkerGate gate(*server_, 2);
+
+    Client client(http.port());
+    client.send(predict_request("1 2 3 4"));
+    EXPECT_TRUE(eventually([&] { return http.stats().requests == 1; }));
+    client.reset();
+    EXPECT_TRUE(eventually([&] { return http.stats().open_connections == 0; }));
+
+    // The request reaches a worker already cancelled and never runs
+    gate.release();
+    EXPECT_TRUE(eventually([&] {
+        return server_->abort_stats().cancelled == 1;
+    }));
+    EXPECT_EQ(server_->abort_stats().deadline_exceeded, 0u);
+}
+
+TEST_F(HttpServerTest, HalfClosedClientStillGetsResponse) {
+    HttpServer http(*server_);
+    http.start();
+    WorkerGate gate(*server_, 2);
+
+    // Request, FIN, then wait for the reply (like `nc -N`)
+    Client client(http.port());
+    client.send(predict_request("1 2 3 4"));
+    client.shutdown_write();
+    EXPECT_TRUE(eventually([&] { return http.stats().requests == 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    gate.release();
+    EXPECT_EQ(status_of(client.read_response()), 200);
+    EXPECT_TRUE(client.closed_by_peer());
+    EXPECT_EQ(server_->abort_stats().cancelled, 0u);
+}
+
+TEST_F(HttpServerTest, HalfCloseAnswersEveryBufferedRequest) {
+    HttpServerConfig config;
+    config.max_pipelined = 2;
+    HttpServer http(*server_, config);
+    http.start();
+    WorkerGate gate(*server_, 2);
+
+    // Six requests and the FIN arrive while only two may be in flight
+    Client client(http.port());
+    std::string batch;
+    for (int i = 0; i < 6; ++i) {
+        batch += predict_request("1 2 3 4",
+                                 "X-Request-Id: r" + std::to_string(i) + "\r\n");
+    }
+    client.send(batch);
+    client.shutdown_write();
+    EXPECT_TRUE(eventually([&] { return http.stats().requests == 2; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    gate.release();
+    for (int i = 0; i < 6; ++i) {
+        std::string response = client.read_response();
+        ASSERT_EQ(status_of(response), 200) << i;
+        EXPECT_EQ(header_of(response, "X-Request-Id"), "r" + std::to_string(i));
+    }
+    EXPECT_TRUE(client.closed_by_peer());
+}
+
+TEST_F(HttpServerTest, LargeJsonBodyArrivingInPieces) {
+    HttpServer http(*server_);
+    http.start();
+
+    // ~8 MiB of padding around four numbers, sent in 64 KiB pieces
+    std::string body = "[1, 2, 3, 4]" + std::string(8u << 20, ' ');
+    std::string request = predict_request(body);
+    Client client(http.port());
+    for (size_t sent = 0; sent < request.size(); sent += 64 * 1024) {
+        client.send(request.substr(sent, 64 * 1024));
+    }
+    std::string response = client.read_response();
+    ASSERT_EQ(status_of(response), 200) << response.substr(0, 200);
+
+    // The connection stays usable for small requests
+    client.send(predict_request("1 2 3 4"));
+    EXPECT_EQ(status_of(client.read_response()), 200);
+}
+
+TEST_F(HttpServerTest, ConnectionCloseIsHonoured) {
+    HttpServer http(*server_);
+    http.start();
+
+    Client client(http.port());
+    client.send(predict_request("1 2 3 4", "Connection: close\r\n"));
+    std::string response = client.read_response();
+    EXPECT_EQ(status_of(response), 200);
+    EXPECT_EQ(header_of(response, "Connection"), "close");
+    EXPECT_TRUE(client.closed_by_peer());
+}
+
+TEST_F(HttpServerTest, ManyConnectionsAcrossIoThreads) {
+    HttpServerConfig config;
+    config.io_threads = 4;
+    HttpServer http(*server_, config);
+    http.start();
+
+    std::vector<std::thread> clients;
+    std::atomic<int> ok{0};
+    for (int c = 0; c < 16; ++c) {
+        clients.emplace_back([&] {
+            Client client(http.port());
+            for (int i = 0; i < 10; ++i) {
+                client.send(predict_request("1 2 3 4"));
+                if (status_of(client.read_response()) == 200) ok.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : clients) t.join();
+    EXPECT_EQ(ok.load(), 160);
+    EXPECT_EQ(http.stats().accepted_connections, 16u);
+
+    http.stop();
+    EXPECT_FALSE(http.running());
+    EXPECT_EQ(http.stats().open_connections, 0u);
+}
+
+TEST_F(HttpServerTest, BinaryTensorFramesRoundTrip) {
+    HttpServer http(*server_);
+    http.start();
+
+    Tensor input({4});
+    for (size_t i = 0; i < 4; ++i) input.data()[i] = static_cast<float>(i + 1);
+    std::string frame = TensorWire::encode(input);
+    const std::string binary_type =
+        std::string("Content-Type: ") + TENSOR_WIRE_CONTENT_TYPE + "\r\n";
+
+    Client client(http.port());
+    // Sent in pieces so the frame is completed inside the receive block
+    std::string request = predict_request(frame, binary_type);
+    client.send(request.substr(0, request.size() - 9));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    client.send(request.substr(request.size() - 9));
+
+    std::string response = client.read_response();
+    ASSERT_EQ(status_of(response), 200) << response;
+    EXPECT_EQ(header_of(response, "Content-Type"), TENSOR_WIRE_CONTENT_TYPE);
+    std::string body = body_of(response);
+    Tensor output = TensorWire::decode(body.data(), body.size());
+    ASSERT_EQ(output.shape(), std::vector<size_t>{3});
+
+    // Same result as the JSON path
+    client.send(predict_request("[1, 2, 3, 4]"));
+    std::string json = client.read_response();
+    ASSERT_EQ(status_of(json), 200);
+    Tensor expected = server_->predict("mlp", input).body;
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_FLOAT_EQ(output.data()[i], expected.data()[i]);
+    }
+
+    // Accept overrides the body encoding
+    client.send(predict_request(frame, binary_type +
+                                "Accept: application/json\r\n"));
+    std::string as_json = client.read_response();
+    ASSERT_EQ(status_of(as_json), 200);
+    EXPECT_EQ(body_of(as_json).front(), '[');
+
+    // A corrupt frame is a bad request
+    std::string corrupt = frame;
+    corrupt[0] = 'X';
+    client.send(predict_request(corrupt, binary_type));
+    EXPECT_EQ(status_of(client.read_response()), 400);
+}
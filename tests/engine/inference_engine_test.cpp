@@ -5,6 +5,7 @@
 #include "titaninfer/layers/dense_layer.hpp"
 #include "titaninfer/layers/activation_layer.hpp"
 #include <memory>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <limits>
@@ -290,6 +291,74 @@ TEST(InferenceEngineTest, WrongDimensionality) {
     EXPECT_THROW(engine.predict(input_2d), std::invalid_argument);
 }
 
+TEST(InferenceEngineTest, ExecutionLimitsStopPredict) {
+    TempFile tmp("test_ie_limits.titan");
+    save_test_mlp(tmp.path);
+
+    auto engine = InferenceEngine::Builder()
+        .setModelPath(tmp.path)
+        .build();
+    Tensor input({4});
+    input.fill(1.0f);
+
+    // Limits that never fire leave the result unchanged
+    ExecutionLimits loose = ExecutionLimits::within(std::chrono::hours(1));
+    loose.cancellation = CancellationToken::create();
+    Tensor expected = engine.predict(input);
+    Tensor limited = engine.predict(input, loose);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_FLOAT_EQ(limited.data()[i], expected.data()[i]);
+    }
+
+    ExecutionLimits expired;
+    expired.deadline = std::chrono::steady_clock::now();
+    try {
+        engine.predict(input, expired);
+        FAIL() << "expected DEADLINE_EXCEEDED";
+    } catch (const InferenceException& e) {
+        EXPECT_EQ(e.error_code(), ErrorCode::DEADLINE_EXCEEDED);
+    }
+
+    loose.cancellation.cancel();
+    try {
+        engine.predict(input, loose);
+        FAIL() << "expected CANCELLED";
+    } catch (const InferenceException& e) {
+        EXPECT_EQ(e.error_code(), ErrorCode::CANCELLED);
+    }
+
+    // An inert token cannot be cancelled
+    CancellationToken inert;
+    inert.cancel();
+    EXPECT_FALSE(inert.cancelled());
+}
+
+TEST(InferenceEngineTest, PredictIntoWritesInPlace) {
+    TempFile tmp("test_ie_predict_into.titan");
+    save_test_mlp(tmp.path);
+
+    auto engine = InferenceEngine::Builder()
+        .setModelPath(tmp.path)
+        .build();
+    Tensor input({4});
+    input.fill(0.5f);
+    Tensor expected = engine.predict(input);
+    EXPECT_EQ(engine.output_shape(), expected.shape());
+
+    Tensor output(engine.output_shape());
+    const float* data = output.data();
+    engine.predict_into(input, output);
+    EXPECT_EQ(output.data(), data);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_FLOAT_EQ(output.data()[i], expected.data()[i]);
+    }
+
+    // A mis-shaped output is replaced rather than overrun
+    Tensor wrong({1});
+    engine.predict_into(input, wrong);
+    EXPECT_EQ(wrong.shape(), expected.shape());
+}
+
 // ============================================================
 // Profiling tests
 // ============================================================
@@ -476,3 +545,35 @@ TEST(InferenceEngineTest, SummaryDelegation) {
     EXPECT_NE(s.find("Dense(8, 3)"), std::string::npos);
     EXPECT_NE(s.find("Softmax"), std::string::npos);
 }
+
+TEST(InferenceEngineTest, SharedModelEnginesShareWeights) {
+    TempFile tmp("test_ie_shared.titan");
+    save_test_mlp(tmp.path);
+    auto file_engine = InferenceEngine::Builder()
+        .setModelPath(tmp.path)
+        .build();
+
+    auto model = std::make_shared<Sequential>(make_reference_mlp());
+    auto a = InferenceEngine::Builder().setSharedModel(model).build();
+    auto b = InferenceEngine::Builder().setSharedModel(model).build();
+    EXPECT_EQ(a.expected_input_shape(), std::vector<size_t>{4});
+
+    const auto& wa = dynamic_cast<const DenseLayer&>(a.model().layer(0));
+    const auto& wb = dynamic_cast<const DenseLayer&>(b.model().layer(0));
+    EXPECT_EQ(wa.weights().data(), wb.weights().data());
+
+    Tensor input = make_test_input();
+    Tensor expected = file_engine.predict(input);
+    Tensor out_a = a.predict(input);
+    Tensor out_b = b.predict(input);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_FLOAT_EQ(out_a.data()[i], expected.data()[i]);
+        EXPECT_FLOAT_EQ(out_b.data()[i], expected.data()[i]);
+    }
+
+    // The engines keep the model alive
+    model.reset();
+    Tensor again = b.predict(input);
+    EXPECT_FLOAT_EQ(again.data()[0], expected.data()[0]);
+}
+
@@ -8,12 +8,30 @@
 #include "titaninfer/layers/pooling_layers.hpp"
 #include "titaninfer/layers/flatten_layer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
 
 using namespace titaninfer;
 using namespace titaninfer::layers;
 using namespace titaninfer::engine;
 
+#if defined(__linux__) && defined(__GLIBC__)
+// Tensor buffers come from std::aligned_alloc on Linux; counting its calls
+// checks that a warm batched plan allocates none
+#define TITANINFER_COUNT_TENSOR_ALLOCS 1
+namespace {
+std::atomic<size_t> tensor_allocs{0};
+} // anonymous namespace
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    tensor_allocs.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+}
+#endif
+
 namespace {
 
 std::unique_ptr<Sequential> make_mlp() {
@@ -126,6 +144,70 @@ TEST(ModelCompilerTest, PredictMatchesOriginal) {
     }
 }
 
+TEST(ModelCompilerTest, BatchedPlanMatchesSingle) {
+    auto model = make_mlp();
+
+    CompileOptions opts;
+    opts.max_batch_size = 4;
+    auto compiled = ModelCompiler::compile(*model, {4}, opts);
+    EXPECT_EQ(compiled.max_batch_size(), 4u);
+
+    for (size_t n : {3u, 1u, 4u}) {
+        Tensor batch({n, 4});
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch.data()[i] = 0.1f * static_cast<float>(i % 9);
+        }
+
+        Tensor out_buffer({4, 3});
+        Tensor out = Tensor::view(out_buffer.data(), compiled.batch_output_shape(n));
+        compiled.predict_batch(batch, out);
+        EXPECT_EQ(out.data(), out_buffer.data());  // written in place
+
+        for (size_t r = 0; r < n; ++r) {
+            Tensor sample({4});
+            std::copy(batch.data() + r * 4, batch.data() + (r + 1) * 4, sample.data());
+            Tensor expected = model->forward(sample);
+            for (size_t c = 0; c < 3; ++c) {
+                EXPECT_NEAR(out.data()[r * 3 + c], expected.data()[c], 1e-5f);
+            }
+        }
+    }
+
+    Tensor too_big({5, 4});
+    Tensor out({5, 3});
+    EXPECT_THROW(compiled.predict_batch(too_big, out), std::invalid_argument);
+}
+
+TEST(ModelCompilerTest, WarmBatchedPlanAllocatesNoTensors) {
+#ifndef TITANINFER_COUNT_TENSOR_ALLOCS
+    GTEST_SKIP() << "allocation counting needs glibc";
+#else
+    auto model = make_mlp();
+    CompileOptions opts;
+    opts.max_batch_size = 4;
+    for (bool fusion : {true, false}) {
+        opts.enable_fusion = fusion;
+        auto compiled = ModelCompiler::compile(*model, {4}, opts);
+
+        Tensor batch({4, 4});
+        batch.fill(0.5f);
+        Tensor out_buffer({4, 3});
+        Tensor out = Tensor::view(out_buffer.data(), compiled.batch_output_shape(4));
+        compiled.predict_batch(batch, out);  // builds the transposed weights
+        Tensor first = out;
+
+        const size_t before = tensor_allocs.load();
+        for (int i = 0; i < 10; ++i) {
+            compiled.predict_batch(batch, out);
+        }
+        EXPECT_EQ(tensor_allocs.load(), before) << "fusion=" << fusion;
+        for (size_t j = 0; j < first.size(); ++j) {
+            EXPECT_FLOAT_EQ(out.data()[j], first.data()[j]);
+        }
+    }
+#endif
+}
+
 TEST(ModelCompilerTest, EmptyModelThrows) {
     Sequential empty;
     EXPECT_THROW(ModelCompiler::compile(empty, {4}), std::invalid_argument);
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "titaninfer/engine/mpmc_queue.hpp"
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace titaninfer::engine;
+
+TEST(MpmcQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(MpmcQueue<int>(0).capacity(), 2u);
+    EXPECT_EQ(MpmcQueue<int>(5).capacity(), 8u);
+    EXPECT_EQ(MpmcQueue<int>(64).capacity(), 64u);
+}
+
+TEST(MpmcQueueTest, FifoOrder) {
+    MpmcQueue<int> queue(8);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.try_push(int{i}));
+    }
+    EXPECT_EQ(queue.size_approx(), 5u);
+    for (int i = 0; i < 5; ++i) {
+        auto value = queue.try_pop();
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(*value, i);
+    }
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty_approx());
+}
+
+TEST(MpmcQueueTest, FullQueueRejectsAndKeepsValue) {
+    MpmcQueue<std::string> queue(2);
+    EXPECT_TRUE(queue.try_push(std::string("a")));
+    EXPECT_TRUE(queue.try_push(std::string("b")));
+
+    std::string rejected = "c";
+    EXPECT_FALSE(queue.try_push(std::move(rejected)));
+    EXPECT_EQ(rejected, "c");
+
+    EXPECT_EQ(*queue.try_pop(), "a");
+    EXPECT_TRUE(queue.try_push(std::move(rejected)));
+}
+
+TEST(MpmcQueueTest, WrapsAroundManyLaps) {
+    MpmcQueue<int> queue(4);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(queue.try_push(int{i}));
+        ASSERT_EQ(*queue.try_pop(), i);
+    }
+}
+
+TEST(MpmcQueueTest, DestroysRemainingElements) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        MpmcQueue<std::shared_ptr<int>> queue(8);
+        queue.try_push(std::shared_ptr<int>(tracker));
+        queue.try_push(std::shared_ptr<int>(tracker));
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(MpmcQueueTest, ConcurrentProducersConsumers) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+    MpmcQueue<int> queue(128);
+
+    std::atomic<int64_t> sum{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                int value = p * kPerProducer + i;
+                while (!queue.try_push(int{value})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 4; ++c) {
+        threads.emplace_back([&]() {
+            while (consumed.load() < kProducers * kPerProducer) {
+                if (auto value = queue.try_pop()) {
+                    sum.fetch_add(*value);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    constexpr int64_t n = kProducers * kPerProducer;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+}
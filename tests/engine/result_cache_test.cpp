@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "titaninfer/engine/result_cache.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace titaninfer;
+using namespace titaninfer::engine;
+
+static Tensor make_tensor(size_t n, float start) {
+    Tensor t({n});
+    for (size_t i = 0; i < n; ++i) t.data()[i] = start + static_cast<float>(i);
+    return t;
+}
+
+TEST(ResultCacheTest, HashCoversContentShapeAndTail) {
+    Tensor a = make_tensor(37, 1.0f);  // 148 bytes: stripes plus a tail
+    Tensor b = make_tensor(37, 1.0f);
+    EXPECT_EQ(hash_tensor(a), hash_tensor(b));
+
+    b.data()[36] = -1.0f;  // last byte of the tail
+    EXPECT_NE(hash_tensor(a), hash_tensor(b));
+
+    Tensor flat = make_tensor(12, 0.0f);
+    Tensor square({3, 4});
+    for (size_t i = 0; i < 12; ++i) square.data()[i] = flat.data()[i];
+    EXPECT_NE(hash_tensor(flat), hash_tensor(square));
+
+    // Lengths across the scramble boundary all hash apart
+    std::vector<unsigned char> bytes(2048, 0xAB);
+    std::set<uint64_t> seen;
+    for (size_t n : {0, 1, 31, 32, 33, 511, 512, 513, 2048}) {
+        seen.insert(hash_bytes(bytes.data(), n));
+    }
+    EXPECT_EQ(seen.size(), 9u);
+}
+
+TEST(ResultCacheTest, HitOnlyForSameInputVersionAndPool) {
+    ResultCache cache(ResultCacheConfig{});
+    Tensor input = make_tensor(4, 1.0f);
+    Tensor output = make_tensor(3, 10.0f);
+    uint64_t hash = hash_tensor(input);
+
+    EXPECT_EQ(cache.lookup(1, 7, hash, input), nullptr);
+    cache.insert(1, 7, hash, input, output);
+
+    auto hit = cache.lookup(1, 7, hash, input);
+    ASSERT_NE(hit, nullptr);
+    EXPECT_FLOAT_EQ(hit->data()[2], 12.0f);
+
+    EXPECT_EQ(cache.lookup(2, 7, hash, input), nullptr);  // other version
+    EXPECT_EQ(cache.lookup(1, 8, hash, input), nullptr);  // reloaded pool
+
+    // A colliding hash with different content is a miss
+    Tensor other = make_tensor(4, 2.0f);
+    EXPECT_EQ(cache.lookup(1, 7, hash, other), nullptr);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.2);
+}
+
+TEST(ResultCacheTest, ByteBudgetEvictsLeastRecentlyUsed) {
+    // One shard fits two entries of 64 + 64 floats
+    ResultCacheConfig config;
+    config.shards = 1;
+    config.max_bytes = 2 * (128 * sizeof(float) + 128) + 16;
+    ResultCache cache(config);
+
+    std::vector<Tensor> inputs;
+    for (int i = 0; i < 3; ++i) inputs.push_back(make_tensor(64, 100.0f * i));
+    Tensor output = make_tensor(64, 0.0f);
+
+    cache.insert(1, 1, hash_tensor(inputs[0]), inputs[0], output);
+    cache.insert(1, 1, hash_tensor(inputs[1]), inputs[1], output);
+    ASSERT_NE(cache.lookup(1, 1, hash_tensor(inputs[0]), inputs[0]), nullptr);
+    cache.insert(1, 1, hash_tensor(inputs[2]), inputs[2], output);
+
+    EXPECT_NE(cache.lookup(1, 1, hash_tensor(inputs[0]), inputs[0]), nullptr);
+    EXPECT_EQ(cache.lookup(1, 1, hash_tensor(inputs[1]), inputs[1]), nullptr);
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_LE(stats.bytes, config.max_bytes);
+
+    // Too large for a shard: not cached at all
+    Tensor huge = make_tensor(4096, 0.0f);
+    cache.insert(1, 1, hash_tensor(huge), huge, huge);
+    EXPECT_EQ(cache.stats().insertions, 3u);
+}
+
+TEST(ResultCacheTest, InvalidateByVersion) {
+    ResultCache cache(ResultCacheConfig{});
+    Tensor output = make_tensor(2, 0.0f);
+    for (uint32_t version = 1; version <= 2; ++version) {
+        for (int i = 0; i < 5; ++i) {
+            Tensor input = make_tensor(4, static_cast<float>(i));
+            cache.insert(version, 1, hash_tensor(input), input, output);
+        }
+    }
+    ASSERT_EQ(cache.stats().entries, 10u);
+
+    cache.invalidate(1);
+    Tensor probe = make_tensor(4, 0.0f);
+    EXPECT_EQ(cache.lookup(1, 1, hash_tensor(probe), probe), nullptr);
+    EXPECT_NE(cache.lookup(2, 1, hash_tensor(probe), probe), nullptr);
+    EXPECT_EQ(cache.stats().invalidations, 5u);
+
+    cache.invalidate();
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST(ResultCacheTest, ConcurrentLookupsAndInserts) {
+    ResultCacheConfig config;
+    config.max_bytes = 64 * 1024;
+    ResultCache cache(config);
+    Tensor output = make_tensor(8, 0.0f);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &output, t]() {
+            for (int i = 0; i < 500; ++i) {
+                Tensor input = make_tensor(8, static_cast<float>((i * 7 + t) % 64));
+                uint64_t hash = hash_tensor(input);
+                auto hit = cache.lookup(1, 1, hash, input);
+                if (hit) {
+                    EXPECT_FLOAT_EQ(hit->data()[0], 0.0f);
+                } else {
+                    cache.insert(1, 1, hash, input, output);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 2000u);
+    EXPECT_GT(stats.hits, 0u);
+    EXPECT_LE(stats.bytes, config.max_bytes);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "titaninfer/engine/tensor_pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace titaninfer;
+using namespace titaninfer::engine;
+
+TEST(TensorPoolTest, AcquireReturnsAlignedView) {
+    auto pool = TensorPool::create();
+    Tensor t = pool->acquire({3, 5});
+    EXPECT_TRUE(t.is_view());
+    EXPECT_EQ(t.shape(), (std::vector<size_t>{3, 5}));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(t.data()) % TensorPool::ALIGNMENT,
+              0u);
+}
+
+TEST(TensorPoolTest, ReleasedBuffersAreReused) {
+    auto pool = TensorPool::create();
+    const float* first = nullptr;
+    {
+        Tensor t = pool->acquire({100});
+        first = t.data();
+    }
+    // Same size class (128 floats), so the buffer comes back
+    Tensor again = pool->acquire({120});
+    EXPECT_EQ(again.data(), first);
+
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.allocated, 1u);
+    EXPECT_EQ(stats.reused, 1u);
+    EXPECT_EQ(stats.cached_bytes, 0u);
+}
+
+TEST(TensorPoolTest, CopyOfIsIndependent) {
+    auto pool = TensorPool::create();
+    Tensor source({4});
+    for (size_t i = 0; i < 4; ++i) source.data()[i] = static_cast<float>(i);
+
+    Tensor copy = pool->copy_of(source);
+    source.data()[0] = 42.0f;
+    EXPECT_FLOAT_EQ(copy.data()[0], 0.0f);
+    EXPECT_FLOAT_EQ(copy.data()[3], 3.0f);
+
+    // Moving keeps the pooled buffer; copying a view makes an owning tensor
+    const float* data = copy.data();
+    Tensor moved = std::move(copy);
+    EXPECT_EQ(moved.data(), data);
+    Tensor owned(moved);
+    EXPECT_FALSE(owned.is_view());
+}
+
+TEST(TensorPoolTest, FreeListsAreBounded) {
+    TensorPoolConfig config;
+    config.max_free_per_class = 2;
+    auto pool = TensorPool::create(config);
+    {
+        std::vector<Tensor> held;
+        for (int i = 0; i < 5; ++i) held.push_back(pool->acquire({16}));
+    }
+    EXPECT_EQ(pool->stats().cached_bytes, 2 * 16 * sizeof(float));
+}
+
+TEST(TensorPoolTest, RetainedBytesAreBounded) {
+    TensorPoolConfig config;
+    config.max_retained_bytes = 3 * 64 * sizeof(float);
+    auto pool = TensorPool::create(config);
+    {
+        std::vector<Tensor> held;
+        for (int i = 0; i < 5; ++i) held.push_back(pool->acquire({64}));
+        held.push_back(pool->acquire({16}));
+    }
+    // Three 64-float buffers fill the budget; the rest were freed
+    EXPECT_EQ(pool->stats().cached_bytes, 3 * 64 * sizeof(float));
+
+    // Taking one out makes room for a smaller class; then the budget
+    // no longer fits it on its way back
+    {
+        Tensor big = pool->acquire({64});
+        { Tensor small = pool->acquire({16}); }
+    }
+    EXPECT_EQ(pool->stats().cached_bytes, (2 * 64 + 16) * sizeof(float));
+}
+
+TEST(TensorPoolTest, LargeBuffersAreNotKept) {
+    TensorPoolConfig config;
+    config.max_buffer_bytes = 1024;
+    auto pool = TensorPool::create(config);
+    { Tensor big = pool->acquire({1024}); }
+    { Tensor fits = pool->acquire({256}); }
+    EXPECT_EQ(pool->stats().cached_bytes, 256 * sizeof(float));
+
+    { Tensor big = pool->acquire({1024}); }
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.allocated, 3u);
+    EXPECT_EQ(stats.reused, 0u);
+}
+
+TEST(TensorPoolTest, TensorsOutliveThePool) {
+    auto pool = TensorPool::create();
+    Tensor t = pool->acquire({8});
+    pool.reset();
+    t.data()[7] = 1.0f;  // still valid; released to the allocator later
+    EXPECT_FLOAT_EQ(t.data()[7], 1.0f);
+}
+
+TEST(TensorPoolTest, ReleaseFromOtherThreads) {
+    auto pool = TensorPool::create();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool]() {
+            for (int i = 0; i < 200; ++i) {
+                Tensor held = pool->acquire({64});
+                std::thread([moved = std::move(held)]() {}).join();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto stats = pool->stats();
+    EXPECT_EQ(stats.reused + stats.allocated, 800u);
+    EXPECT_LE(stats.allocated, 8u);
+}
@@ -13,6 +13,7 @@
 #include <cstdio>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
@@ -110,6 +111,15 @@ static Tensor make_test_input() {
     return input;
 }
 
+// ~1 MB of weights: Dense(4,512) -> Dense(512,512) -> Dense(512,3)
+static void save_large_mlp(const std::string& filename) {
+    Sequential model;
+    model.add(std::make_unique<DenseLayer>(4, 512));
+    model.add(std::make_unique<DenseLayer>(512, 512));
+    model.add(std::make_unique<DenseLayer>(512, 3));
+    ModelSerializer::save(model, filename);
+}
+
 // ============================================================
 // Fixtures
 // ============================================================
@@ -464,7 +474,7 @@ TEST_F(ModelServerTest, HandleRequestIdPropagation) {
 }
 
 // ============================================================
-// Group 5: LRU Cache (5 tests)
+// Group 5: Model Cache (13 tests)
 // ============================================================
 
 TEST_F(ModelServerTest, CacheLoadsOnFirstRequest) {
@@ -593,8 +603,204 @@ TEST_F(ModelServerTest, CacheExplicitEviction) {
     EXPECT_EQ(server.loaded_model_count(), 0u);
 }
 
+TEST_F(ModelServerTest, ColdBurstLoadsOnce) {
+    TempFile f("test_ms_singleflight.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(4).build();
+    server.register_model("mlp", 1, f.path);
+
+    auto input = make_test_input();
+    std::atomic<int> ok{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 16; ++t) {
+        threads.emplace_back([&]() {
+            if (server.predict("mlp", input).status_code == 200) {
+                ok.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    EXPECT_EQ(ok.load(), 16);
+    EXPECT_EQ(server.cold_load_count(), 1u);
+    EXPECT_EQ(server.loaded_model_count(), 1u);
+}
+
+TEST_F(ModelServerTest, PreloadWarmsCache) {
+    TempFile f("test_ms_preload.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("mlp", 1, f.path);
+    server.register_model("mlp", 2, f.path);
+
+    server.preload("mlp").wait();   // default: highest version
+    EXPECT_EQ(server.loaded_model_count(), 1u);
+
+    Response resp = server.predict("mlp", make_test_input());
+    EXPECT_EQ(resp.status_code, 200);
+    EXPECT_EQ(resp.headers.at("X-Model-Version"), "2");
+    EXPECT_EQ(server.cold_load_count(), 1u);
+
+    EXPECT_THROW(server.preload("unknown"), ServerException);
+}
+
+TEST_F(ModelServerTest, LoadTimeoutReturns503) {
+    TempFile f("test_ms_loadtimeout.titan");
+    {
+        // ~16 MB of weights cannot be parsed within 1 ms
+        Sequential model;
+        model.add(std::make_unique<DenseLayer>(4, 2048));
+        model.add(std::make_unique<DenseLayer>(2048, 2048));
+        model.add(std::make_unique<DenseLayer>(2048, 3));
+        ModelSerializer::save(model, f.path);
+    }
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(16)
+        .setLoadTimeout(1)
+        .build();
+    server.register_model("mlp", 1, f.path);
+
+    Response cold = server.predict("mlp", make_test_input());
+    EXPECT_EQ(cold.status_code, 503);
+    EXPECT_EQ(cold.headers.count("Retry-After"), 1u);
+
+    // The load keeps running in the background; preload joins it
+    server.preload("mlp").wait();
+    Response warm = server.predict("mlp", make_test_input());
+    EXPECT_EQ(warm.status_code, 200);
+    EXPECT_EQ(server.cold_load_count(), 1u);
+}
+
+TEST_F(ModelServerTest, CacheByteBudgetEvicts) {
+    TempFile f("test_ms_bytes.titan");
+    save_test_mlp(f.path);
+
+    size_t model_bytes = 0;
+    {
+        auto probe = ModelServer::Builder()
+            .setWorkerThreads(2).setEnginesPerModel(1).build();
+        probe.register_model("m", 1, f.path);
+        probe.predict("m", make_test_input());
+        model_bytes = probe.loaded_bytes();
+    }
+    ASSERT_GT(model_bytes, 0u);
+
+    // Room for two copies by bytes, plenty by count
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(16)
+        .setMaxLoadedBytes(model_bytes * 2 + model_bytes / 2)
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    for (uint32_t v = 1; v <= 3; ++v) {
+        server.register_model("m", v, f.path);
+    }
+
+    Request req;
+    req.body = make_test_input();
+    for (uint32_t v = 1; v <= 3; ++v) {
+        req.path = "/v1/models/m/versions/" + std::to_string(v) + "/predict";
+        EXPECT_EQ(server.handle_request(req).status_code, 200);
+    }
+    EXPECT_EQ(server.loaded_model_count(), 2u);
+    EXPECT_EQ(server.loaded_bytes(), model_bytes * 2);
+}
+
+TEST_F(ModelServerTest, CacheGDSFKeepsFrequentModel) {
+    TempFile f("test_ms_gdsf_freq.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(2)
+        .setEvictionPolicy(EvictionPolicy::GDSF)
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("hot", 1, f.path);
+    server.register_model("cold", 1, f.path);
+    server.register_model("new", 1, f.path);
+
+    auto input = make_test_input();
+    for (int i = 0; i < 50; ++i) server.predict("hot", input);
+    server.predict("cold", input);   // most recent, but used once
+
+    server.predict("new", input);    // LRU would evict "hot"
+    EXPECT_EQ(server.cold_load_count(), 3u);
+    server.predict("hot", input);
+    EXPECT_EQ(server.cold_load_count(), 3u);
+    server.predict("cold", input);
+    EXPECT_EQ(server.cold_load_count(), 4u);
+}
+
+TEST_F(ModelServerTest, CacheGDSFEvictsLargeModelFirst) {
+    TempFile small1("test_ms_gdsf_s1.titan");
+    TempFile large("test_ms_gdsf_l.titan");
+    TempFile small2("test_ms_gdsf_s2.titan");
+    save_test_mlp(small1.path);
+    save_large_mlp(large.path);
+    save_test_mlp(small2.path);
+
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(2)
+        .setEvictionPolicy(EvictionPolicy::GDSF)
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("small1", 1, small1.path);
+    server.register_model("large", 1, large.path);
+    server.register_model("small2", 1, small2.path);
+
+    auto input = make_test_input();
+    server.predict("small1", input);
+    server.predict("large", input);
+    server.predict("small2", input);  // LRU would evict "small1"
+    EXPECT_EQ(server.cold_load_count(), 3u);
+
+    server.predict("small1", input);
+    EXPECT_EQ(server.cold_load_count(), 3u);
+}
+
+TEST_F(ModelServerTest, PrefetchLoadsSeasonalModel) {
+    TempFile f("test_ms_prefetch.titan");
+    save_test_mlp(f.path);
+
+    PrefetchConfig prefetch;
+    prefetch.bucket_interval = std::chrono::milliseconds(0);  // manual
+    prefetch.season_buckets = 2;
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(1)
+        .setWorkerThreads(2).setEnginesPerModel(1)
+        .enablePrefetch(prefetch)
+        .build();
+    server.register_model("even", 1, f.path);
+    server.register_model("odd", 1, f.path);
+
+    auto input = make_test_input();
+    auto run_bucket = [&](const std::string& model) {
+        for (int i = 0; i < 3; ++i) server.predict(model, input);
+    };
+
+    run_bucket("even");
+    EXPECT_EQ(server.prefetch_now(), 0u);
+    run_bucket("odd");                     // evicts "even"
+    EXPECT_EQ(server.prefetch_now(), 1u);  // phase 0 again: "even" is due
+
+    CacheStats before = server.cache_stats();
+    run_bucket("even");
+    CacheStats after = server.cache_stats();
+    EXPECT_EQ(after.hits - before.hits, 3u);
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_EQ(after.prefetches, 1u);
+}
+
+TEST_F(ModelServerTest, PrefetchDisabledIsNoOp) {
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    EXPECT_EQ(server.prefetch_now(), 0u);
+    EXPECT_EQ(server.cache_stats().prefetches, 0u);
+}
+
 // ============================================================
-// Group 6: Rate Limiting (5 tests)
+// Group 6: Rate Limiting (7 tests)
 // ============================================================
 
 TEST_F(ModelServerTest, NoQuotaAllowsAll) {
@@ -725,8 +931,87 @@ TEST_F(ModelServerTest, RemoveQuotaAllowsAll) {
     }
 }
 
+TEST_F(ModelServerTest, QuotaHoldsUnderContention) {
+    TempFile f("test_ms_quotarace.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(4).build();
+    server.register_model("mlp", 1, f.path);
+
+    TenantQuota quota;
+    quota.max_qps = 50.0;
+    quota.max_concurrent = 1000;
+    server.set_tenant_quota("t1", quota);
+
+    auto input = make_test_input();
+    std::atomic<int> ok{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 40; ++i) {
+                if (server.predict("mlp", input, "t1").status_code == 200) {
+                    ok.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    // Burst of max_qps plus whatever refilled while the threads ran
+    EXPECT_GE(ok.load(), 50);
+    EXPECT_LE(ok.load(), 50 + static_cast<int>(elapsed * 50.0) + 1);
+}
+
+TEST_F(ModelServerTest, QuotaUpdatesWhileServing) {
+    TempFile f("test_ms_quotaupd.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(2).build();
+    server.register_model("mlp", 1, f.path);
+
+    auto input = make_test_input();
+    std::atomic<bool> stop{false};
+    std::atomic<int> bad_status{0};
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 4; ++t) {
+        clients.emplace_back([&, t] {
+            std::string tenant = "tenant_" + std::to_string(t % 2);
+            while (!stop.load()) {
+                int code = server.predict("mlp", input, tenant).status_code;
+                if (code != 200 && code != 429) bad_status.fetch_add(1);
+            }
+        });
+    }
+
+    TenantQuota quota;
+    quota.max_qps = 1000.0;
+    quota.max_concurrent = 2;
+    for (int i = 0; i < 200; ++i) {
+        std::string tenant = "tenant_" + std::to_string(i % 3);
+        if (i % 4 == 3) {
+            server.remove_tenant_quota(tenant);
+        } else {
+            server.set_tenant_quota(tenant, quota);
+        }
+    }
+    stop.store(true);
+    for (auto& t : clients) t.join();
+
+    EXPECT_EQ(bad_status.load(), 0);
+
+    // Concurrency slots were all returned: a fresh quota of 1 still admits
+    quota.max_concurrent = 1;
+    server.set_tenant_quota("tenant_0", quota);
+    EXPECT_EQ(server.predict("mlp", input, "tenant_0").status_code, 200);
+}
+
 // ============================================================
-// Group 7: Traffic Splitting & Hot Reload (5 tests)
+// Group 7: Traffic Splitting & Hot Reload (10 tests)
 // ============================================================
 
 TEST_F(ModelServerTest, DefaultRouteToLatestVersion) {
@@ -779,6 +1064,86 @@ TEST_F(ModelServerTest, TrafficSplitDistribution) {
     EXPECT_EQ(v1_count + v2_count, 200);
 }
 
+TEST_F(ModelServerTest, TrafficSplitZeroWeightNeverRouted) {
+    TempFile f("test_ms_splitzero.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(4)
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("mlp", 1, f.path);
+    server.register_model("mlp", 2, f.path);
+    server.register_model("mlp", 3, f.path);
+
+    // Weights are relative: 3:1 between v1 and v3, v2 disabled
+    server.set_traffic_rules("mlp", {{1, 3.0}, {2, 0.0}, {3, 1.0}});
+
+    auto input = make_test_input();
+    int counts[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 200; ++i) {
+        Response resp = server.predict("mlp", input);
+        ASSERT_EQ(resp.status_code, 200);
+        counts[std::stoul(resp.headers.at("X-Model-Version"))]++;
+    }
+    EXPECT_EQ(counts[2], 0);
+    EXPECT_GT(counts[1], 100);
+    EXPECT_GT(counts[3], 10);
+}
+
+TEST_F(ModelServerTest, StickyTenantRouting) {
+    TempFile f("test_ms_sticky.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(4)
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("mlp", 1, f.path);
+    server.register_model("mlp", 2, f.path);
+    server.set_traffic_rules("mlp", {{1, 0.5}, {2, 0.5}},
+                             StickyRouting::TENANT);
+
+    auto input = make_test_input();
+    std::set<std::string> versions_seen;
+    for (int t = 0; t < 32; ++t) {
+        std::string tenant = "tenant_" + std::to_string(t);
+        std::string first;
+        for (int i = 0; i < 10; ++i) {
+            Response resp = server.predict("mlp", input, tenant);
+            ASSERT_EQ(resp.status_code, 200);
+            const std::string& version = resp.headers.at("X-Model-Version");
+            if (i == 0) first = version;
+            EXPECT_EQ(version, first) << tenant;
+        }
+        versions_seen.insert(first);
+    }
+    // Tenants are spread over both versions
+    EXPECT_EQ(versions_seen.size(), 2u);
+}
+
+TEST_F(ModelServerTest, StickyRequestIdRouting) {
+    TempFile f("test_ms_stickyreq.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setMaxLoadedModels(4)
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("mlp", 1, f.path);
+    server.register_model("mlp", 2, f.path);
+    server.set_traffic_rules("mlp", {{1, 0.5}, {2, 0.5}},
+                             StickyRouting::REQUEST_ID);
+
+    auto input = make_test_input();
+    for (int r = 0; r < 8; ++r) {
+        std::string id = "session-" + std::to_string(r);
+        std::string first = server.predict("mlp", input, "", id)
+                                .headers.at("X-Model-Version");
+        for (int i = 0; i < 5; ++i) {
+            EXPECT_EQ(server.predict("mlp", input, "", id)
+                          .headers.at("X-Model-Version"), first);
+        }
+    }
+}
+
 TEST_F(ModelServerTest, HotReloadSwitchesVersion) {
     TempFile f1("test_ms_hot1.titan");
     TempFile f2("test_ms_hot2.titan");
@@ -833,6 +1198,63 @@ TEST_F(ModelServerTest, HotReloadNonexistentThrows) {
         ServerException);
 }
 
+TEST_F(ModelServerTest, HotReloadRampsTraffic) {
+    TempFile f1("test_ms_ramp1.titan");
+    TempFile f2("test_ms_ramp2.titan");
+    save_test_mlp(f1.path);
+    save_alt_mlp(f2.path);
+
+    ReloadConfig reload;
+    reload.ramp_ms = 400;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(1)
+        .setReloadConfig(reload).build();
+    server.register_model("mlp", 1, f1.path);
+
+    auto input = make_test_input();
+    ASSERT_EQ(server.predict("mlp", input).body.shape()[0], 3u);
+    size_t bytes_before = server.loaded_bytes();
+
+    server.reload_model("mlp", 1, f2.path);
+
+    // Both pools are resident while traffic shifts; early requests still
+    // mostly reach the old version
+    EXPECT_GT(server.loaded_bytes(), bytes_before);
+    size_t old_results = 0;
+    for (int i = 0; i < 20; ++i) {
+        Response r = server.predict("mlp", input);
+        ASSERT_EQ(r.status_code, 200);
+        if (r.body.shape()[0] == 3u) ++old_results;
+    }
+    EXPECT_GT(old_results, 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(server.predict("mlp", input).body.shape()[0], 2u);
+    }
+    EXPECT_LT(server.loaded_bytes(), bytes_before);  // alt model is smaller
+    EXPECT_EQ(server.loaded_model_count(), 1u);
+}
+
+TEST_F(ModelServerTest, HotReloadAsyncFailureKeepsOldVersion) {
+    TempFile f1("test_ms_hotfail.titan");
+    save_test_mlp(f1.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(1).build();
+    server.register_model("mlp", 1, f1.path);
+    auto input = make_test_input();
+    ASSERT_EQ(server.predict("mlp", input).status_code, 200);
+
+    auto reload = server.reload_model_async("mlp", 1, "missing_model.titan");
+    EXPECT_ANY_THROW(reload.get());
+
+    EXPECT_EQ(server.list_versions("mlp")[0].file_path, f1.path);
+    Response r = server.predict("mlp", input);
+    EXPECT_EQ(r.status_code, 200);
+    EXPECT_EQ(r.body.shape()[0], 3u);
+}
+
 // ============================================================
 // Group 8: Concurrency (4 tests)
 // ============================================================
@@ -972,7 +1394,7 @@ TEST_F(ModelServerTest, AsyncPredictFuture) {
 }
 
 // ============================================================
-// Group 9: Edge Cases (3 tests)
+// Group 9: Edge Cases (4 tests)
 // ============================================================
 
 TEST_F(ModelServerTest, ServerStatsAccuracy) {
@@ -1031,6 +1453,40 @@ TEST_F(ModelServerTest, EnginePoolExhaustion) {
     EXPECT_EQ(ok.load(), 20);
 }
 
+TEST_F(ModelServerTest, EnginePoolLargerThanOneBitmapWord) {
+    TempFile f("test_ms_widepool.titan");
+    save_test_mlp(f.path);
+
+    // 66 engines span two lease-bitmap words; 72 threads also exhaust it
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2)
+        .setEnginesPerModel(66)
+        .build();
+    server.register_model("mlp", 1, f.path);
+
+    auto input = make_test_input();
+    Response expected = server.predict("mlp", input);
+    ASSERT_EQ(expected.status_code, 200);
+
+    std::atomic<int> ok{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 72; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 5; ++i) {
+                Response resp = server.predict("mlp", input);
+                if (resp.status_code == 200 &&
+                    std::abs(resp.body.data()[0] -
+                             expected.body.data()[0]) < 1e-6f) {
+                    ok.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(ok.load(), 72 * 5);
+}
+
 TEST_F(ModelServerTest, HandleRequestAsyncFuture) {
     TempFile f("test_ms_asyncreq.titan");
     save_test_mlp(f.path);
@@ -1052,6 +1508,1055 @@ TEST_F(ModelServerTest, HandleRequestAsyncFuture) {
     EXPECT_EQ(resp.body.shape()[0], 3u);
 }
 
+// ============================================================
+// Group 10: Dynamic Batching (3 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, BatchedPredictMatchesUnbatched) {
+    TempFile f("test_ms_batched.titan");
+    save_test_mlp(f.path);
+
+    BatcherConfig batching;
+    batching.max_batch_size = 8;
+    batching.max_wait_ms = 2;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(4).setEnginesPerModel(2)
+        .enableBatching("batched", 0, batching)
+        .build();
+    server.register_model("plain", 1, f.path);
+    server.register_model("batched", 1, f.path);
+
+    auto input = make_test_input();
+    Response expected = server.predict("plain", input);
+    ASSERT_EQ(expected.status_code, 200);
+
+    const int num_threads = 8;
+    std::atomic<int> matches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 10; ++i) {
+                std::string id = "req-" + std::to_string(t) + "-" +
+                                 std::to_string(i);
+                Response resp = server.predict("batched", input, "", id);
+                bool ok = resp.status_code == 200 &&
+                          resp.headers.at("X-Request-Id") == id &&
+                          resp.headers.at("X-Model-Version") == "1" &&
+                          resp.body.shape() == expected.body.shape();
+                for (size_t k = 0; ok && k < resp.body.size(); ++k) {
+                    ok = std::abs(resp.body.data()[k] -
+                                  expected.body.data()[k]) < 1e-5f;
+                }
+                if (ok) matches.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(matches.load(), num_threads * 10);
+}
+
+TEST_F(ModelServerTest, BatchingSelectedPerVersion) {
+    TempFile f1("test_ms_batchver1.titan");
+    TempFile f2("test_ms_batchver2.titan");
+    save_test_mlp(f1.path);
+    save_alt_mlp(f2.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(1)
+        .enableBatching("mlp", 2)
+        .build();
+    server.register_model("mlp", 1, f1.path);
+    server.register_model("mlp", 2, f2.path);
+
+    Request req;
+    req.path = "/v1/models/mlp/versions/1/predict";
+    req.body = make_test_input();
+    Response v1 = server.handle_request(req);
+    EXPECT_EQ(v1.status_code, 200);
+    EXPECT_EQ(v1.body.shape()[0], 3u);
+
+    req.path = "/v1/models/mlp/versions/2/predict";
+    Response v2 = server.handle_request(req);
+    EXPECT_EQ(v2.status_code, 200);
+    EXPECT_EQ(v2.headers.at("X-Model-Version"), "2");
+    EXPECT_EQ(v2.body.shape()[0], 2u);
+
+    // Validation still happens per request on the batched path
+    Response bad = server.predict("mlp", Tensor({5}));
+    EXPECT_EQ(bad.status_code, 400);
+}
+
+TEST_F(ModelServerTest, BatchedRequestsKeepTenantQuota) {
+    TempFile f("test_ms_batchquota.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(1)
+        .enableBatching("mlp")
+        .build();
+    server.register_model("mlp", 1, f.path);
+
+    TenantQuota quota;
+    quota.max_qps = 2.0;
+    quota.max_concurrent = 10;
+    server.set_tenant_quota("tenant_a", quota);
+
+    auto input = make_test_input();
+    EXPECT_EQ(server.predict("mlp", input, "tenant_a").status_code, 200);
+    EXPECT_EQ(server.predict("mlp", input, "tenant_a").status_code, 200);
+    EXPECT_EQ(server.predict("mlp", input, "tenant_a").status_code, 429);
+    EXPECT_EQ(server.predict("mlp", input, "tenant_b").status_code, 200);
+}
+
+// ============================================================
+// Group 11: Admission Control (2 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, AdmissionShedsStandingQueue) {
+    TempFile f("test_ms_admission_shed.titan");
+    save_test_mlp(f.path);
+
+    AdmissionConfig admission;
+    admission.target_delay_ms = 1;
+    admission.interval_ms = 20;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).setEnginesPerModel(1)
+        .enableAdmissionControl(admission).build();
+    server.register_model("mlp", 1, f.path);
+    ASSERT_EQ(server.predict("mlp", make_test_input()).status_code, 200);
+
+    // Each request holds the only worker for at least 2 ms (its callback
+    // sleeps there), so 100 of them form a standing queue for ~200 ms
+    // whatever else the machine is doing
+    constexpr int N = 100;
+    std::atomic<int> ok{0};
+    std::atomic<int> shed{0};
+    std::atomic<int> done{0};
+    std::promise<void> all_done;
+    for (int i = 0; i < N; ++i) {
+        Request request;
+        request.method = HttpMethod::POST;
+        request.path = "/v1/models/mlp/predict";
+        request.body = make_test_input();
+        server.handle_request_async(std::move(request), [&](Response resp) {
+            if (resp.status_code == 200) {
+                ++ok;
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            } else {
+                EXPECT_EQ(resp.status_code, 503);
+                EXPECT_EQ(resp.headers.at("Retry-After"), "1");
+                ++shed;
+            }
+            if (++done == N) all_done.set_value();
+        });
+    }
+    all_done.get_future().wait();
+
+    // CoDel serves the first interval's worth of requests and then spaces
+    // its drops out, so the queue is thinned rather than emptied
+    EXPECT_GE(ok.load(), 5);
+    EXPECT_GT(shed.load(), 0);
+
+    auto stats = server.admission_stats("mlp");
+    EXPECT_EQ(stats.admitted, static_cast<uint64_t>(ok.load()));
+    EXPECT_EQ(stats.shed_on_arrival + stats.shed_in_queue,
+              static_cast<uint64_t>(shed.load()));
+    EXPECT_EQ(stats.queued, 0u);
+
+    // A request with nothing queued behind it is never dropped
+    EXPECT_EQ(server.predict_async("mlp", make_test_input()).get().status_code, 200);
+    EXPECT_FALSE(server.admission_stats("mlp").overloaded);
+}
+
+TEST_F(ModelServerTest, AdmissionIsPerModel) {
+    TempFile f("test_ms_admission_model.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).enableAdmissionControl().build();
+    server.register_model("mlp", 1, f.path);
+
+    Request request;
+    request.method = HttpMethod::POST;
+    request.path = "/v1/models/mlp/predict";
+    request.body = make_test_input();
+    std::promise<Response> done;
+    server.handle_request_async(
+        request, [&](Response resp) { done.set_value(std::move(resp)); });
+    EXPECT_EQ(done.get_future().get().status_code, 200);
+    EXPECT_EQ(server.predict_async("mlp", make_test_input()).get()
+                  .status_code, 200);
+
+    auto stats = server.admission_stats("mlp");
+    EXPECT_EQ(stats.admitted, 2u);
+    EXPECT_EQ(stats.shed_on_arrival + stats.shed_in_queue, 0u);
+    EXPECT_FALSE(stats.overloaded);
+    EXPECT_EQ(server.admission_stats("other").admitted, 0u);
+}
+
+// ============================================================
+// Group 12: Deadlines & Cancellation (2 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, ExpiredDeadlineReturns504) {
+    TempFile f("test_ms_deadline.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder().setWorkerThreads(2).build();
+    server.register_model("mlp", 1, f.path);
+    auto input = make_test_input();
+
+    ExecutionLimits expired;
+    expired.deadline = std::chrono::steady_clock::now();
+    EXPECT_EQ(server.predict("mlp", input, "", "", expired).status_code, 504);
+    EXPECT_EQ(server.predict_async("mlp", input, "", "", expired).get()
+                  .status_code, 504);
+
+    Request request;
+    request.path = "/v1/models/mlp/versions/1/predict";
+    request.body = input;
+    request.limits = expired;
+    Response resp = server.handle_request(request);
+    EXPECT_EQ(resp.status_code, 504);
+    EXPECT_FALSE(resp.headers.at("X-Request-Id").empty());
+
+    // A generous deadline does not get in the way
+    request.limits = ExecutionLimits::within(std::chrono::seconds(10));
+    EXPECT_EQ(server.handle_request(request).status_code, 200);
+
+    auto stats = server.abort_stats();
+    EXPECT_EQ(stats.deadline_exceeded, 3u);
+    EXPECT_EQ(stats.cancelled, 0u);
+}
+
+TEST_F(ModelServerTest, CancelAbandonsQueuedRequests) {
+    TempFile f("test_ms_cancel.titan");
+    save_large_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).setEnginesPerModel(1).build();
+    server.register_model("large", 1, f.path);
+    auto input = make_test_input();
+    ASSERT_EQ(server.predict("large", input).status_code, 200);
+
+    ExecutionLimits limits;
+    limits.cancellation = CancellationToken::create();
+    std::vector<std::future<Response>> futures;
+    for (int i = 0; i < 200; ++i) {
+        futures.push_back(server.predict_async("large", input, "", "", limits));
+    }
+    limits.cancellation.cancel();
+
+    uint64_t cancelled = 0;
+    for (auto& fut : futures) {
+        Response resp = fut.get();
+        ASSERT_TRUE(resp.status_code == 200 || resp.status_code == 499)
+            << resp.status_code;
+        if (resp.status_code == 499) ++cancelled;
+    }
+    EXPECT_GT(cancelled, 0u);
+
+    auto stats = server.abort_stats();
+    EXPECT_EQ(stats.cancelled, cancelled);
+    EXPECT_GT(stats.total_latency_ms, 0.0);
+    EXPECT_GE(stats.max_latency_ms, stats.mean_latency_ms());
+
+    // Cancelled submissions are refused up front
+    EXPECT_EQ(server.predict_async("large", input, "", "", limits).get()
+                  .status_code, 499);
+}
+
+// ============================================================
+// Group 13: Zero-copy Async Path (2 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, MovedInputsAndOutputsUsePool) {
+    TempFile f("test_ms_zero_copy.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder().setWorkerThreads(2).build();
+    server.register_model("mlp", 1, f.path);
+    auto expected = server.predict("mlp", make_test_input());
+    ASSERT_EQ(expected.status_code, 200);
+
+    auto pool = server.tensor_pool();
+    for (int i = 0; i < 20; ++i) {
+        Tensor input = pool->copy_of(make_test_input());
+        const float* data = input.data();
+        Response resp = server.predict_async("mlp", std::move(input)).get();
+        ASSERT_EQ(resp.status_code, 200);
+        EXPECT_TRUE(resp.body.is_view());
+        EXPECT_NE(resp.body.data(), data);
+        ASSERT_EQ(resp.body.shape(), expected.body.shape());
+        for (size_t j = 0; j < resp.body.size(); ++j) {
+            EXPECT_FLOAT_EQ(resp.body.data()[j], expected.body.data()[j]);
+        }
+    }
+
+    // Released inputs and outputs are handed out again
+    auto stats = pool->stats();
+    EXPECT_GT(stats.reused, stats.allocated);
+}
+
+TEST_F(ModelServerTest, HandleRequestAsyncByMove) {
+    TempFile f("test_ms_zero_copy_req.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder().setWorkerThreads(2).build();
+    server.register_model("mlp", 1, f.path);
+
+    Request request;
+    request.request_id = "moved";
+    request.path = "/v1/models/mlp/versions/1/predict";
+    request.body = make_test_input();
+    Response copied = server.handle_request_async(request).get();
+    EXPECT_EQ(copied.status_code, 200);
+    EXPECT_EQ(request.body.size(), 4u);  // caller's request untouched
+
+    Response moved = server.handle_request_async(std::move(request)).get();
+    EXPECT_EQ(moved.status_code, 200);
+    EXPECT_EQ(moved.headers.at("X-Request-Id"), "moved");
+    ASSERT_EQ(moved.body.shape(), copied.body.shape());
+    for (size_t j = 0; j < moved.body.size(); ++j) {
+        EXPECT_FLOAT_EQ(moved.body.data()[j], copied.body.data()[j]);
+    }
+}
+
+// ============================================================
+// Group 14: Result Cache (3 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, ResultCacheServesPinnedVersionRequests) {
+    TempFile f("test_ms_result_cache_pinned.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2)
+        .enableResultCache("cached")
+        .build();
+    server.register_model("cached", 1, f.path);
+    auto input = make_test_input();
+
+    Request request;
+    request.path = "/v1/models/cached/versions/1/predict";
+    request.body = input;
+    Response first = server.handle_request(request);
+    ASSERT_EQ(first.status_code, 200);
+    EXPECT_EQ(first.headers.count("X-Result-Cache"), 0u);
+
+    // Same version and pool: pinned and default routes share entries
+    Response pinned = server.handle_request(request);
+    EXPECT_EQ(pinned.headers.at("X-Result-Cache"), "hit");
+    EXPECT_EQ(pinned.headers.at("X-Model-Version"), "1");
+    EXPECT_EQ(server.predict("cached", input).headers.at("X-Result-Cache"),
+              "hit");
+    EXPECT_EQ(server.result_cache_stats("cached").hits, 2u);
+
+    request.path = "/v1/models/cached/versions/9/predict";
+    Response missing = server.handle_request(request);
+    EXPECT_EQ(missing.status_code, 404);
+    EXPECT_EQ(missing.headers.count("X-Request-Id"), 1u);
+}
+
+TEST_F(ModelServerTest, ResultCacheServesRepeatedInputs) {
+    TempFile f("test_ms_result_cache.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2)
+        .enableResultCache("cached")
+        .build();
+    server.register_model("cached", 1, f.path);
+    server.register_model("plain", 1, f.path);
+    auto input = make_test_input();
+
+    Response first = server.predict("cached", input);
+    ASSERT_EQ(first.status_code, 200);
+    EXPECT_EQ(first.headers.count("X-Result-Cache"), 0u);
+    for (int i = 0; i < 9; ++i) {
+        Response again = i % 2 == 0
+            ? server.predict("cached", input)
+            : server.predict_async("cached", input).get();
+        ASSERT_EQ(again.status_code, 200);
+        EXPECT_EQ(again.headers.at("X-Result-Cache"), "hit");
+        ASSERT_EQ(again.body.shape(), first.body.shape());
+        for (size_t j = 0; j < first.body.size(); ++j) {
+            EXPECT_FLOAT_EQ(again.body.data()[j], first.body.data()[j]);
+        }
+    }
+
+    // A different input misses
+    Tensor other = make_test_input();
+    other.data()[0] = -1.0f;
+    EXPECT_EQ(server.predict("cached", other).headers.count("X-Result-Cache"),
+              0u);
+
+    auto stats = server.result_cache_stats("cached");
+    EXPECT_EQ(stats.hits, 9u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_NEAR(stats.hit_rate(), 9.0 / 11.0, 1e-9);
+
+    // Models without a cache are untouched
+    EXPECT_EQ(server.predict("plain", input).status_code, 200);
+    EXPECT_EQ(server.predict("plain", input).headers.count("X-Result-Cache"),
+              0u);
+    EXPECT_EQ(server.result_cache_stats("plain").misses, 0u);
+}
+
+TEST_F(ModelServerTest, ResultCacheInvalidatedOnReloadAndNewVersion) {
+    TempFile f1("test_ms_result_cache_v1.titan");
+    TempFile f2("test_ms_result_cache_v2.titan");
+    save_test_mlp(f1.path);
+    save_alt_mlp(f2.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2)
+        .enableResultCache("mlp")
+        .build();
+    server.register_model("mlp", 1, f1.path);
+    auto input = make_test_input();
+
+    Response before = server.predict("mlp", input);
+    ASSERT_EQ(before.status_code, 200);
+    ASSERT_EQ(server.predict("mlp", input).headers.count("X-Result-Cache"), 1u);
+
+    // The reloaded file computes something else; no stale hit survives
+    server.reload_model("mlp", 1, f2.path);
+    EXPECT_EQ(server.result_cache_stats("mlp").entries, 0u);
+    Response after = server.predict("mlp", input);
+    ASSERT_EQ(after.status_code, 200);
+    EXPECT_EQ(after.headers.count("X-Result-Cache"), 0u);
+    bool differs = after.body.shape() != before.body.shape();
+    for (size_t j = 0; !differs && j < after.body.size(); ++j) {
+        differs = after.body.data()[j] != before.body.data()[j];
+    }
+    EXPECT_TRUE(differs);
+
+    // A newer default version misses as well
+    server.register_model("mlp", 2, f1.path);
+    Response v2 = server.predict("mlp", input);
+    EXPECT_EQ(v2.headers.at("X-Model-Version"), "2");
+    EXPECT_EQ(v2.headers.count("X-Result-Cache"), 0u);
+    EXPECT_GE(server.result_cache_stats("mlp").invalidations, 1u);
+}
+
+// ============================================================
+// Group 15: Request Coalescing (3 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, CoalescingRunsIdenticalRequestsOnce) {
+    TempFile f("test_ms_coalesce.titan");
+    save_large_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(8)
+        .setEnginesPerModel(1)
+        .enableCoalescing("large")
+        .build();
+    server.register_model("large", 1, f.path);
+    auto input = make_test_input();
+    Response expected = server.predict("large", input);
+    ASSERT_EQ(expected.status_code, 200);
+
+    const int num_requests = 64;
+    std::vector<std::future<Response>> futures;
+    for (int i = 0; i < num_requests; ++i) {
+        futures.push_back(server.predict_async("large", input));
+    }
+    int coalesced = 0;
+    for (auto& fut : futures) {
+        Response resp = fut.get();
+        ASSERT_EQ(resp.status_code, 200);
+        if (resp.headers.count("X-Coalesced")) ++coalesced;
+        ASSERT_EQ(resp.body.shape(), expected.body.shape());
+        for (size_t j = 0; j < resp.body.size(); ++j) {
+            EXPECT_FLOAT_EQ(resp.body.data()[j], expected.body.data()[j]);
+        }
+    }
+
+    auto stats = server.coalescing_stats("large");
+    EXPECT_GT(stats.coalesced, 0u);
+    EXPECT_EQ(stats.coalesced, static_cast<uint64_t>(coalesced));
+    EXPECT_EQ(stats.leaders + stats.coalesced,
+              static_cast<uint64_t>(num_requests + 1));
+    EXPECT_EQ(stats.reruns, 0u);
+}
+
+TEST_F(ModelServerTest, CoalescingCoversPinnedVersionRequests) {
+    TempFile f("test_ms_coalesce_pinned.titan");
+    save_large_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(8)
+        .setEnginesPerModel(1)
+        .enableCoalescing("large")
+        .build();
+    server.register_model("large", 1, f.path);
+    server.predict("large", make_test_input());
+
+    const int num_requests = 64;
+    std::vector<std::future<Response>> futures;
+    for (int i = 0; i < num_requests; ++i) {
+        Request request;
+        request.path = "/v1/models/large/versions/1/predict";
+        request.body = make_test_input();
+        futures.push_back(server.handle_request_async(std::move(request)));
+    }
+    int coalesced = 0;
+    for (auto& fut : futures) {
+        Response resp = fut.get();
+        ASSERT_EQ(resp.status_code, 200);
+        EXPECT_EQ(resp.headers.at("X-Model-Version"), "1");
+        if (resp.headers.count("X-Coalesced")) ++coalesced;
+    }
+    EXPECT_GT(coalesced, 0);
+    EXPECT_EQ(server.coalescing_stats("large").coalesced,
+              static_cast<uint64_t>(coalesced));
+}
+
+TEST_F(ModelServerTest, CoalescingKeepsDistinctInputsApart) {
+    TempFile f("test_ms_coalesce_distinct.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(4)
+        .enableCoalescing("mlp")
+        .build();
+    server.register_model("mlp", 1, f.path);
+    server.register_model("plain", 1, f.path);
+
+    std::vector<Tensor> inputs;
+    std::vector<Response> expected;
+    for (int i = 0; i < 4; ++i) {
+        Tensor input = make_test_input();
+        input.data()[0] = static_cast<float>(i);
+        expected.push_back(server.predict("plain", input));
+        inputs.push_back(std::move(input));
+    }
+
+    std::vector<std::future<Response>> futures;
+    for (int i = 0; i < 40; ++i) {
+        futures.push_back(server.predict_async("mlp", inputs[i % 4]));
+    }
+    for (int i = 0; i < 40; ++i) {
+        Response resp = futures[static_cast<size_t>(i)].get();
+        ASSERT_EQ(resp.status_code, 200);
+        const Response& want = expected[static_cast<size_t>(i % 4)];
+        for (size_t j = 0; j < resp.body.size(); ++j) {
+            EXPECT_FLOAT_EQ(resp.body.data()[j], want.body.data()[j]);
+        }
+    }
+
+    auto stats = server.coalescing_stats("mlp");
+    EXPECT_EQ(stats.leaders + stats.coalesced, 40u);
+    EXPECT_EQ(server.coalescing_stats("plain").leaders, 0u);
+}
+
+// ============================================================
+// Group 16: Elastic Engine Pools (3 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, ElasticPoolGrowsUnderLoadAndShrinksWhenIdle) {
+    TempFile f("test_ms_elastic.titan");
+    save_large_mlp(f.path);
+
+    ElasticPoolConfig elastic;
+    elastic.min_engines = 1;
+    elastic.max_engines = 4;
+    elastic.grow_wait_us = 100;
+    elastic.idle_ms = 20;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(8)
+        .enableElasticPools(elastic)
+        .build();
+    server.register_model("large", 1, f.path);
+    auto input = make_test_input();
+    ASSERT_EQ(server.predict("large", input).status_code, 200);
+    EXPECT_EQ(server.engine_pool_stats("large").engines, 1u);
+
+    // Concurrent callers wait for the single engine and grow the pool
+    std::vector<std::thread> threads;
+    std::atomic<int> ok{0};
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 40; ++i) {
+                if (server.predict("large", input).status_code == 200) ++ok;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(ok.load(), 320);
+
+    auto grown = server.engine_pool_stats("large");
+    EXPECT_GT(grown.grown, 0u);
+    EXPECT_LE(grown.engines, 4u);
+    EXPECT_EQ(grown.min_engines, 1u);
+    EXPECT_EQ(grown.max_engines, 4u);
+
+    // One caller at a time leaves engines spare; they retire as windows end
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.engine_pool_stats("large").engines > 1 &&
+           std::chrono::steady_clock::now() < until) {
+        ASSERT_EQ(server.predict("large", input).status_code, 200);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    auto shrunk = server.engine_pool_stats("large");
+    EXPECT_EQ(shrunk.engines, 1u);
+    EXPECT_EQ(shrunk.shrunk, shrunk.grown);
+}
+
+TEST_F(ModelServerTest, ElasticPoolShrinksAfterTrafficStops) {
+    TempFile f("test_ms_elastic_idle.titan");
+    save_large_mlp(f.path);
+
+    ElasticPoolConfig elastic;
+    elastic.min_engines = 1;
+    elastic.max_engines = 4;
+    elastic.grow_wait_us = 100;
+    elastic.idle_ms = 20;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(8)
+        .enableElasticPools(elastic)
+        .build();
+    server.register_model("large", 1, f.path);
+    auto input = make_test_input();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 40; ++i) {
+                EXPECT_EQ(server.predict("large", input).status_code, 200);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    ASSERT_GT(server.engine_pool_stats("large").engines, 1u);
+
+    // No request returns a lease from here on; the timer alone shrinks it
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.engine_pool_stats("large").engines > 1 &&
+           std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto idle = server.engine_pool_stats("large");
+    EXPECT_EQ(idle.engines, 1u);
+    EXPECT_EQ(idle.shrunk, idle.grown);
+}
+
+TEST_F(ModelServerTest, EnginePoolsShareLoadedWeights) {
+    TempFile f("test_ms_shared_weights.titan");
+    save_large_mlp(f.path);
+
+    size_t one_engine = 0;
+    {
+        auto probe = ModelServer::Builder()
+            .setWorkerThreads(2).setEnginesPerModel(1).build();
+        probe.register_model("m", 1, f.path);
+        probe.predict("m", make_test_input());
+        one_engine = probe.loaded_bytes();
+    }
+
+    // Eight engines cost eight sets of activations, not eight weight copies
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(2).setEnginesPerModel(8).build();
+    server.register_model("m", 1, f.path);
+    ASSERT_EQ(server.predict("m", make_test_input()).status_code, 200);
+    EXPECT_LT(server.loaded_bytes(), 2 * one_engine);
+
+    auto stats = server.engine_pool_stats("m", 1);
+    EXPECT_EQ(stats.engines, 8u);
+    EXPECT_EQ(stats.grown, 0u);
+    EXPECT_EQ(server.engine_pool_stats("missing").engines, 0u);
+}
+
+// ============================================================
+// Group 17: Fair Queuing (3 tests)
+// ============================================================
+
+namespace {
+
+// Callback request for `tenant` whose completion is appended to `order`
+void submit_for_tenant(ModelServer& server, const std::string& tenant,
+                       std::mutex& mutex, std::vector<std::string>& order,
+                       std::atomic<int>& done) {
+    Request request;
+    request.tenant_id = tenant;
+    request.path = "/v1/models/mlp/predict";
+    request.body = make_test_input();
+    server.handle_request_async(std::move(request),
+        [&, tenant](Response response) {
+            EXPECT_EQ(response.status_code, 200);
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(tenant);
+            ++done;
+        });
+}
+
+// Occupies the server's only worker until `release` is set
+void block_worker(ModelServer& server, std::shared_future<void> release) {
+    Request request;
+    request.tenant_id = "gate";
+    request.path = "/v1/models/mlp/predict";
+    request.body = make_test_input();
+    server.handle_request_async(std::move(request),
+        [release](Response) { release.wait(); });
+}
+
+} // namespace
+
+TEST_F(ModelServerTest, FairQueuingSharesWorkersByWeight) {
+    TempFile f("test_ms_fair_weights.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).enableFairQueuing().build();
+    server.register_model("mlp", 1, f.path);
+    server.set_tenant_quota("heavy", {1e6, 1000, 3.0});
+    server.set_tenant_quota("light", {1e6, 1000, 1.0});
+
+    std::promise<void> release;
+    block_worker(server, release.get_future().share());
+
+    // The heavy tenant floods the queue before the light one arrives
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 30; ++i) {
+        submit_for_tenant(server, "heavy", mutex, order, done);
+    }
+    for (int i = 0; i < 10; ++i) {
+        submit_for_tenant(server, "light", mutex, order, done);
+    }
+    EXPECT_EQ(server.tenant_queue_stats("heavy").queued, 30u);
+    EXPECT_EQ(server.tenant_queue_stats("light").queued, 10u);
+
+    release.set_value();
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < 40 && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(done.load(), 40);
+
+    // Three heavy requests per light one while both are backlogged
+    std::lock_guard<std::mutex> lock(mutex);
+    int light_in_first_16 = 0;
+    for (int i = 0; i < 16; ++i) {
+        if (order[i] == "light") ++light_in_first_16;
+    }
+    EXPECT_EQ(light_in_first_16, 4);
+    EXPECT_EQ(order[3], "light");
+}
+
+TEST_F(ModelServerTest, TenantQueueStatsReportDepthAndWait) {
+    TempFile f("test_ms_fair_stats.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).setQueueCapacity(4).enableFairQueuing().build();
+    server.register_model("mlp", 1, f.path);
+    server.set_tenant_quota("a", {1e6, 1000, 2.0});
+    server.set_tenant_quota("b", {1e6, 1000, 1.0});
+
+    std::promise<void> release;
+    block_worker(server, release.get_future().share());
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 4; ++i) {
+        submit_for_tenant(server, "a", mutex, order, done);
+    }
+    // Capacity counts every tenant's queued requests
+    Request overflow;
+    overflow.tenant_id = "b";
+    overflow.path = "/v1/models/mlp/predict";
+    overflow.body = make_test_input();
+    Response refused = server.handle_request_async(std::move(overflow)).get();
+    EXPECT_EQ(refused.status_code, 503);
+    EXPECT_EQ(refused.headers.count("Retry-After"), 1u);
+
+    auto queued = server.tenant_queue_stats("a");
+    EXPECT_DOUBLE_EQ(queued.weight, 2.0);
+    EXPECT_EQ(queued.queued, 4u);
+    EXPECT_EQ(queued.dispatched, 0u);
+    EXPECT_EQ(server.tenant_queue_stats("b").rejected, 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release.set_value();
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < 4 && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(done.load(), 4);
+
+    auto drained = server.tenant_queue_stats("a");
+    EXPECT_EQ(drained.queued, 0u);
+    EXPECT_EQ(drained.dispatched, 4u);
+    EXPECT_GE(drained.max_wait_ms, 20.0);
+    EXPECT_GE(drained.mean_wait_ms(), 20.0);
+    EXPECT_LE(drained.mean_wait_ms(), drained.max_wait_ms);
+
+    // Without fair queuing there is nothing to report
+    auto plain = ModelServer::Builder().setWorkerThreads(1).build();
+    EXPECT_EQ(plain.tenant_queue_stats("a").dispatched, 0u);
+    EXPECT_DOUBLE_EQ(plain.tenant_queue_stats("a").weight, 1.0);
+}
+
+TEST_F(ModelServerTest, FairQueueForgetsDrainedAdHocTenants) {
+    TempFile f("test_ms_fair_forget.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).enableFairQueuing().build();
+    server.register_model("mlp", 1, f.path);
+    server.set_tenant_quota("known", {1e6, 1000, 2.0});
+
+    std::promise<void> release;
+    block_worker(server, release.get_future().share());
+
+    // Every request names a tenant the server has never seen
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 50; ++i) {
+        submit_for_tenant(server, "client-" + std::to_string(i),
+                          mutex, order, done);
+    }
+    submit_for_tenant(server, "known", mutex, order, done);
+    EXPECT_EQ(server.tenant_queue_stats("client-7").queued, 1u);
+
+    release.set_value();
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < 51 && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(done.load(), 51);
+
+    // Drained ad-hoc tenants leave nothing behind; quota holders keep
+    // their counters until the quota goes
+    for (int i = 0; i < 50; ++i) {
+        auto stats = server.tenant_queue_stats("client-" + std::to_string(i));
+        EXPECT_EQ(stats.dispatched, 0u);
+        EXPECT_EQ(stats.queued, 0u);
+    }
+    EXPECT_EQ(server.tenant_queue_stats("known").dispatched, 1u);
+    EXPECT_DOUBLE_EQ(server.tenant_queue_stats("known").weight, 2.0);
+
+    server.remove_tenant_quota("known");
+    EXPECT_EQ(server.tenant_queue_stats("known").dispatched, 0u);
+    EXPECT_DOUBLE_EQ(server.tenant_queue_stats("known").weight, 1.0);
+}
+
+// ============================================================
+// Group 18: Load-adaptive Degradation (3 tests)
+// ============================================================
+
+TEST_F(ModelServerTest, QueueDelayDegradesToFallbackAndRecovers) {
+    TempFile fast("test_ms_degrade_fast.titan");
+    TempFile slow("test_ms_degrade_slow.titan");
+    save_test_mlp(fast.path);
+    save_large_mlp(slow.path);
+
+    DegradationPolicy policy;
+    policy.model_name = "m";
+    policy.fallback_version = 1;
+    policy.enter_delay_ms = 1.0;
+    policy.exit_delay_ms = 0.2;
+    policy.min_dwell_ms = 50;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).enableDegradation(policy).build();
+    server.register_model("m", 1, fast.path);
+    server.register_model("m", 2, slow.path);  // default: highest version
+
+    auto input = make_test_input();
+    Response normal = server.predict("m", input);
+    ASSERT_EQ(normal.status_code, 200);
+    EXPECT_EQ(normal.headers.at("X-Model-Version"), "2");
+    EXPECT_EQ(normal.headers.count("X-Degraded"), 0u);
+
+    // A backlog on the single worker pushes the queueing delay up
+    std::vector<std::future<Response>> futures;
+    for (int i = 0; i < 300; ++i) {
+        futures.push_back(server.predict_async("m", input));
+    }
+    uint64_t degraded = 0;
+    for (auto& future : futures) {
+        Response response = future.get();
+        ASSERT_EQ(response.status_code, 200);
+        if (response.headers.count("X-Degraded")) {
+            EXPECT_EQ(response.headers.at("X-Model-Version"), "1");
+            ++degraded;
+        }
+    }
+    EXPECT_GT(degraded, 0u);
+    auto overloaded = server.degradation_stats("m");
+    EXPECT_GE(overloaded.degradations, 1u);
+    EXPECT_GE(overloaded.fallback_requests, degraded);
+
+    // Unqueued calls bring the delay down; the switch back waits out the dwell
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.degradation_stats("m").degraded &&
+           std::chrono::steady_clock::now() < until) {
+        ASSERT_EQ(server.predict("m", input).status_code, 200);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto recovered = server.degradation_stats("m");
+    EXPECT_FALSE(recovered.degraded);
+    EXPECT_EQ(recovered.recoveries, recovered.degradations);
+    EXPECT_LT(recovered.queue_delay_ms, 0.2);
+
+    Response after = server.predict("m", input);
+    EXPECT_EQ(after.headers.at("X-Model-Version"), "2");
+    EXPECT_EQ(after.headers.count("X-Degraded"), 0u);
+}
+
+TEST_F(ModelServerTest, SaturationDegradesWithHysteresis) {
+    TempFile fast("test_ms_saturation_fast.titan");
+    TempFile slow("test_ms_saturation_slow.titan");
+    save_test_mlp(fast.path);
+    save_large_mlp(slow.path);
+
+    DegradationPolicy policy;
+    policy.model_name = "m";
+    policy.fallback_version = 1;
+    policy.enter_delay_ms = 0.0;  // saturation only
+    policy.exit_delay_ms = 0.0;
+    policy.enter_saturation = 1.5;
+    policy.exit_saturation = 1.1;
+    policy.min_dwell_ms = 20;
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).enableDegradation(policy).build();
+    server.register_model("m", 1, fast.path);
+    server.register_model("m", 2, slow.path);
+
+    // Four callers on a one-worker server
+    auto input = make_test_input();
+    std::atomic<bool> saw_fallback{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 200; ++i) {
+                Response response = server.predict("m", input);
+                ASSERT_EQ(response.status_code, 200);
+                if (response.headers.count("X-Degraded")) saw_fallback = true;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_TRUE(saw_fallback.load());
+    EXPECT_GE(server.degradation_stats("m").degradations, 1u);
+
+    // One caller at a time is 1.0 per worker: under the exit threshold
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (server.degradation_stats("m").degraded &&
+           std::chrono::steady_clock::now() < until) {
+        ASSERT_EQ(server.predict("m", input).status_code, 200);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto recovered = server.degradation_stats("m");
+    EXPECT_FALSE(recovered.degraded);
+    EXPECT_GE(recovered.recoveries, 1u);
+    EXPECT_LT(recovered.saturation, 1.1);
+
+    // No policy, no state
+    auto none = server.degradation_stats("other");
+    EXPECT_FALSE(none.degraded);
+    EXPECT_EQ(none.degradations, 0u);
+}
+
+TEST_F(ModelServerTest, PinnedVersionRequestsAreNotDegraded) {
+    TempFile fast("test_ms_pinned_fast.titan");
+    TempFile slow("test_ms_pinned_slow.titan");
+    save_test_mlp(fast.path);
+    save_large_mlp(slow.path);
+
+    DegradationPolicy policy;
+    policy.model_name = "m";
+    policy.fallback_version = 1;
+    policy.enter_delay_ms = 0.0;
+    policy.exit_delay_ms = 0.0;
+    policy.enter_saturation = 1.5;
+    policy.exit_saturation = 1.1;
+    policy.min_dwell_ms = 60000;  // stays degraded once switched
+    auto server = ModelServer::Builder()
+        .setWorkerThreads(1).enableDegradation(policy).build();
+    server.register_model("m", 1, fast.path);
+    server.register_model("m", 2, slow.path);
+
+    // Only pinned requests: they load the model but keep their version
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            Request request;
+            request.path = "/v1/models/m/versions/2/predict";
+            request.body = make_test_input();
+            for (int i = 0; i < 100; ++i) {
+                Response response = server.handle_request(request);
+                ASSERT_EQ(response.status_code, 200);
+                EXPECT_EQ(response.headers.at("X-Model-Version"), "2");
+                EXPECT_EQ(response.headers.count("X-Degraded"), 0u);
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    auto stats = server.degradation_stats("m");
+    EXPECT_TRUE(stats.degraded);
+    EXPECT_EQ(stats.fallback_requests, 0u);
+
+    // Default-routed requests do take the fallback
+    Response routed = server.predict("m", make_test_input());
+    EXPECT_EQ(routed.headers.at("X-Model-Version"), "1");
+    EXPECT_EQ(routed.headers.at("X-Degraded"), "true");
+}
+
+// ============================================================
+// Group 19: Request Priority (1 test)
+// ============================================================
+
+TEST_F(ModelServerTest, LatencyCriticalRequestOvertakesBackgroundBurst) {
+    TempFile f("test_ms_priority.titan");
+    save_test_mlp(f.path);
+
+    auto server = ModelServer::Builder().setWorkerThreads(1).build();
+    server.register_model("mlp", 1, f.path);
+
+    std::promise<void> release;
+    block_worker(server, release.get_future().share());
+
+    // An offline burst queues up first, then one interactive request
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::atomic<int> done{0};
+    auto submit = [&](const std::string& label, TaskPriority priority) {
+        Request request;
+        request.path = "/v1/models/mlp/predict";
+        request.body = make_test_input();
+        request.limits.priority = priority;
+        server.handle_request_async(std::move(request),
+            [&, label](Response response) {
+                EXPECT_EQ(response.status_code, 200);
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(label);
+                ++done;
+            });
+    };
+    for (int i = 0; i < 20; ++i) {
+        submit("background", TaskPriority::BACKGROUND);
+    }
+    submit("interactive", TaskPriority::LATENCY_CRITICAL);
+
+    release.set_value();
+    auto until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (done.load() < 21 && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(order.size(), 21u);
+    EXPECT_EQ(order.front(), "interactive");
+}
+
 // ============================================================
 // Integration: 100+ concurrent requests across 10 models
 // ============================================================
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 #include "titaninfer/engine/thread_pool.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <mutex>
 #include <numeric>
 #include <thread>
 #include <vector>
@@ -142,3 +144,147 @@ TEST(ThreadPoolTest, SubmitFromMultipleThreads) {
 
     EXPECT_EQ(counter.load(), 400);
 }
+
+// ============================================================
+// Priority lanes & deadlines
+// ============================================================
+
+namespace {
+
+// Occupies the single worker of a pool until release() is called, so that
+// subsequently submitted tasks pile up in the queue.
+struct WorkerGate {
+    std::promise<void> started;
+    std::promise<void> open;
+    std::shared_future<void> opened{open.get_future().share()};
+    std::future<void> done;
+
+    explicit WorkerGate(ThreadPool& pool) {
+        auto started_future = started.get_future();
+        done = pool.submit([this]() {
+            started.set_value();
+            opened.wait();
+        });
+        started_future.wait();
+    }
+
+    void release() {
+        open.set_value();
+        done.get();
+    }
+};
+
+} // anonymous namespace
+
+TEST(ThreadPoolTest, HigherPriorityRunsFirst) {
+    ThreadPool pool(1);
+    WorkerGate gate(pool);
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(id);
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.push_back(pool.submit(TaskOptions{TaskPriority::BACKGROUND}, record, 2));
+    futures.push_back(pool.submit(record, 1));
+    futures.push_back(pool.submit(TaskOptions{TaskPriority::LATENCY_CRITICAL}, record, 0));
+
+    gate.release();
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(ThreadPoolTest, BackgroundLaneIsNotStarved) {
+    ThreadPool pool(1);
+    WorkerGate gate(pool);
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(id);
+    };
+
+    std::vector<std::future<void>> futures;
+    futures.push_back(pool.submit(TaskOptions{TaskPriority::BACKGROUND}, record, -1));
+    for (int i = 0; i < 32; ++i) {
+        futures.push_back(pool.submit(TaskOptions{TaskPriority::LATENCY_CRITICAL},
+                                      record, i));
+    }
+
+    gate.release();
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    auto pos = std::find(order.begin(), order.end(), -1) - order.begin();
+    EXPECT_EQ(static_cast<size_t>(pos), ThreadPool::STARVATION_LIMIT);
+}
+
+TEST(ThreadPoolTest, ExpiredDeadlineCancelsTask) {
+    ThreadPool pool(1);
+    WorkerGate gate(pool);
+
+    std::atomic<bool> executed{false};
+    TaskOptions options;
+    options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+    auto future = pool.submit(options, [&executed]() { executed.store(true); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate.release();
+
+    try {
+        future.get();
+        FAIL() << "expected deadline exception";
+    } catch (const titaninfer::InferenceException& e) {
+        EXPECT_EQ(e.error_code(), titaninfer::ErrorCode::DEADLINE_EXCEEDED);
+    }
+    EXPECT_FALSE(executed.load());
+    EXPECT_EQ(pool.cancelled_count(), 1u);
+}
+
+TEST(ThreadPoolTest, FutureDeadlineRunsNormally) {
+    ThreadPool pool(2);
+    TaskOptions options;
+    options.priority = TaskPriority::LATENCY_CRITICAL;
+    options.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    auto future = pool.submit(options, [](int x) { return x * 2; }, 21);
+    EXPECT_EQ(future.get(), 42);
+    EXPECT_EQ(pool.cancelled_count(), 0u);
+}
+
+TEST(ThreadPoolTest, FullLaneRejectsSubmission) {
+    ThreadPool pool(1, 2);
+    WorkerGate gate(pool);
+
+    auto a = pool.try_submit(TaskOptions{}, []() { return 1; });
+    auto b = pool.try_submit(TaskOptions{}, []() { return 2; });
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+
+    auto rejected = pool.try_submit(TaskOptions{}, []() { return 3; });
+    EXPECT_FALSE(rejected.has_value());
+    try {
+        pool.submit([]() { return 4; });
+        FAIL() << "expected queue-full exception";
+    } catch (const titaninfer::TitanInferException& e) {
+        EXPECT_EQ(e.error_code(), titaninfer::ErrorCode::QUEUE_FULL);
+    }
+
+    // Other lanes have their own capacity
+    auto critical = pool.try_submit(TaskOptions{TaskPriority::LATENCY_CRITICAL},
+                                    []() { return 5; });
+    EXPECT_TRUE(critical.has_value());
+
+    gate.release();
+    EXPECT_EQ(a->get(), 1);
+    EXPECT_EQ(b->get(), 2);
+    EXPECT_EQ(critical->get(), 5);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "titaninfer/io/tensor_wire.hpp"
+#include "titaninfer/exceptions.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace titaninfer;
+using namespace titaninfer::io;
+
+namespace {
+
+Tensor make_tensor(const std::vector<size_t>& shape) {
+    Tensor t(shape);
+    for (size_t i = 0; i < t.size(); ++i) {
+        t.data()[i] = 0.25f * static_cast<float>(i) - 1.0f;
+    }
+    return t;
+}
+
+// Copy `frame` into a 64-byte aligned block at byte `offset`
+std::shared_ptr<char> place(const std::string& frame, size_t offset) {
+    size_t bytes = (offset + frame.size() + 63) / 64 * 64;
+    std::shared_ptr<char> block(
+        static_cast<char*>(std::aligned_alloc(64, bytes)), std::free);
+    std::memcpy(block.get() + offset, frame.data(), frame.size());
+    return block;
+}
+
+} // namespace
+
+TEST(TensorWireTest, HeaderIsPaddedToAlignment) {
+    EXPECT_EQ(TensorWire::header_size(1), 64u);
+    EXPECT_EQ(TensorWire::header_size(5), 64u);
+    EXPECT_EQ(TensorWire::header_size(8), 128u);
+
+    Tensor t = make_tensor({2, 3});
+    std::string frame = TensorWire::encode(t);
+    EXPECT_EQ(frame.size(), 64u + 6 * sizeof(float));
+    EXPECT_EQ(TensorWire::frame_size(frame.data(), frame.size()), frame.size());
+    EXPECT_EQ(TensorWire::frame_size(frame.data(), 10), 0u);
+}
+
+TEST(TensorWireTest, RoundTripIsZeroCopyWhenAligned) {
+    Tensor t = make_tensor({3, 4, 5});
+    std::string frame = TensorWire::encode(t);
+    auto block = place(frame, 0);
+
+    Tensor decoded = TensorWire::decode(block.get(), frame.size(), block);
+    EXPECT_TRUE(decoded.is_view());
+    EXPECT_EQ(reinterpret_cast<const char*>(decoded.data()),
+              block.get() + TensorWire::header_size(3));
+    ASSERT_EQ(decoded.shape(), t.shape());
+    for (size_t i = 0; i < t.size(); ++i) {
+        EXPECT_FLOAT_EQ(decoded.data()[i], t.data()[i]);
+    }
+
+    // The view keeps the receive buffer alive on its own
+    const float* data = decoded.data();
+    block.reset();
+    EXPECT_FLOAT_EQ(data[1], t.data()[1]);
+}
+
+TEST(TensorWireTest, MisalignedPayloadIsCopied) {
+    Tensor t = make_tensor({7});
+    std::string frame = TensorWire::encode(t);
+    auto block = place(frame, 1);
+
+    Tensor decoded = TensorWire::decode(block.get() + 1, frame.size(), block);
+    EXPECT_FALSE(decoded.is_view());
+    ASSERT_EQ(decoded.shape(), t.shape());
+    for (size_t i = 0; i < t.size(); ++i) {
+        EXPECT_FLOAT_EQ(decoded.data()[i], t.data()[i]);
+    }
+}
+
+TEST(TensorWireTest, MalformedFramesThrow) {
+    std::string frame = TensorWire::encode(make_tensor({4}));
+
+    EXPECT_THROW(TensorWire::decode(frame.data(), 10), ValidationException);
+    EXPECT_THROW(TensorWire::decode(frame.data(), frame.size() - 4),
+                 ValidationException);
+
+    std::string bad_magic = frame;
+    bad_magic[0] = 'X';
+    EXPECT_THROW(TensorWire::frame_size(bad_magic.data(), bad_magic.size()),
+                 ValidationException);
+
+    std::string bad_dim = frame;
+    bad_dim[TensorWire::FIXED_HEADER_BYTES] = 5;  // 5 floats, 4 sent
+    EXPECT_THROW(TensorWire::decode(bad_dim.data(), bad_dim.size()),
+                 ValidationException);
+
+    std::string bad_rank = frame;
+    bad_rank[6] = 0;
+    EXPECT_THROW(TensorWire::decode(bad_rank.data(), bad_rank.size()),
+                 ValidationException);
+}
+
+TEST(TensorWireTest, OverflowingShapeIsRejected) {
+    // Header only, dims [2^62, 1]: 2^62 floats * 4 bytes wraps to 0
+    std::string frame = TensorWire::encode(make_tensor({1, 1}));
+    uint32_t header_bytes = 0;
+    std::memcpy(&header_bytes, frame.data() + 8, sizeof(header_bytes));
+    frame.resize(header_bytes);
+    std::memset(&frame[16], 0, 8);  // payload_bytes = 0
+    const uint64_t huge = uint64_t{1} << 62;
+    for (size_t b = 0; b < 8; ++b) {
+        frame[TensorWire::FIXED_HEADER_BYTES + b] =
+            static_cast<char>((huge >> (8 * b)) & 0xFF);
+    }
+
+    EXPECT_EQ(TensorWire::frame_size(frame.data(), frame.size()),
+              frame.size());
+    EXPECT_THROW(TensorWire::decode(frame.data(), frame.size()),
+                 ValidationException);
+}
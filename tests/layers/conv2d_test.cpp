@@ -3,6 +3,7 @@
 #include "titaninfer/ops/conv_ops.hpp"
 
 #include <cmath>
+#include <memory>
 
 using namespace titaninfer;
 using namespace titaninfer::layers;
@@ -222,3 +223,42 @@ TEST(Conv2DTest, Clone) {
     EXPECT_EQ(conv_clone->kernel_h(), 3u);
     EXPECT_EQ(conv_clone->padding(), ops::PaddingMode::SAME);
 }
+
+TEST(Conv2DTest, CloneSharedAliasesWeights) {
+    auto conv = std::make_shared<Conv2DLayer>(2, 4, 3, 1,
+                                              ops::PaddingMode::SAME, true);
+    Tensor w({4, 2, 3, 3});
+    for (size_t i = 0; i < w.size(); ++i) {
+        w.data()[i] = 0.01f * static_cast<float>(i % 17);
+    }
+    conv->set_weights(w);
+    Tensor b({4});
+    b.fill(0.5f);
+    conv->set_bias(b);
+
+    auto shared = conv->clone_shared(conv);
+    auto* shared_conv = dynamic_cast<Conv2DLayer*>(shared.get());
+    ASSERT_NE(shared_conv, nullptr);
+    EXPECT_EQ(shared_conv->weights().data(), conv->weights().data());
+    EXPECT_EQ(shared_conv->bias().data(), conv->bias().data());
+
+    Tensor input({2, 5, 5});
+    for (size_t i = 0; i < input.size(); ++i) {
+        input.data()[i] = static_cast<float>(i % 7);
+    }
+    Tensor expected({1});
+    Tensor actual({1});
+    conv->forward(input, expected);
+    shared->forward(input, actual);
+    ASSERT_EQ(actual.shape(), expected.shape());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_FLOAT_EQ(actual.data()[i], expected.data()[i]);
+    }
+
+    // The views keep the source alive
+    std::weak_ptr<Conv2DLayer> source = conv;
+    conv.reset();
+    EXPECT_FALSE(source.expired());
+    shared.reset();
+    EXPECT_TRUE(source.expired());
+}
@@ -115,6 +115,28 @@ TEST(DenseLayerTest, Forward2D) {
     EXPECT_NEAR(output.data()[3], 3.5f, 1e-6f);
 }
 
+TEST(DenseLayerTest, Forward2DAfterSetWeights) {
+    // The batched path caches W^T; new weights must replace it
+    DenseLayer layer(2, 2, false);
+    Tensor input({1, 2});
+    input.data()[0] = 1.0f; input.data()[1] = 2.0f;
+    Tensor output({1, 2});
+
+    Tensor identity({2, 2});
+    identity.data()[0] = 1.0f; identity.data()[3] = 1.0f;
+    layer.set_weights(identity);
+    layer.forward(input, output);
+    EXPECT_NEAR(output.data()[0], 1.0f, 1e-6f);
+    EXPECT_NEAR(output.data()[1], 2.0f, 1e-6f);
+
+    Tensor swap({2, 2});
+    swap.data()[1] = 1.0f; swap.data()[2] = 1.0f;
+    layer.set_weights(swap);
+    layer.forward(input, output);
+    EXPECT_NEAR(output.data()[0], 2.0f, 1e-6f);
+    EXPECT_NEAR(output.data()[1], 1.0f, 1e-6f);
+}
+
 TEST(DenseLayerTest, Forward1DNoBias) {
     DenseLayer layer(2, 2, false);
 
@@ -373,3 +395,37 @@ TEST(SequentialTest, TotalParametersEmpty) {
     Sequential model;
     EXPECT_EQ(model.total_parameters(), 0u);
 }
+
+TEST(SequentialTest, CloneSharedAliasesParameters) {
+    auto model = std::make_shared<Sequential>();
+    auto dense = std::make_unique<DenseLayer>(3, 2);
+    Tensor w({2, 3});
+    for (size_t i = 0; i < w.size(); ++i) w.data()[i] = 0.1f * static_cast<float>(i);
+    dense->set_weights(w);
+    model->add(std::move(dense));
+    model->add(std::make_unique<ReluLayer>());
+
+    auto shared = model->clone_shared(model);
+    ASSERT_EQ(shared->size(), 2u);
+    const auto& original = dynamic_cast<const DenseLayer&>(model->layer(0));
+    const auto& aliased = dynamic_cast<const DenseLayer&>(shared->layer(0));
+    EXPECT_EQ(aliased.weights().data(), original.weights().data());
+    EXPECT_EQ(aliased.bias().data(), original.bias().data());
+    EXPECT_EQ(shared->total_parameters(), model->total_parameters());
+
+    Tensor input({3});
+    input.fill(1.0f);
+    Tensor a = model->forward(input);
+    Tensor b = shared->forward(input);
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_FLOAT_EQ(b.data()[i], a.data()[i]);
+    }
+
+    // Setting weights on the copy detaches it instead of writing through
+    auto& detached = dynamic_cast<DenseLayer&>(shared->layer(0));
+    Tensor zeros({2, 3});
+    zeros.zero();
+    detached.set_weights(zeros);
+    EXPECT_NE(detached.weights().data(), original.weights().data());
+    EXPECT_FLOAT_EQ(original.weights().data()[5], 0.5f);
+}
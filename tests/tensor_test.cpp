@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "titaninfer/tensor.hpp"
 #include <cstdint>
+#include <memory>
 
 using namespace titaninfer;
 
@@ -218,6 +219,45 @@ TEST(TensorTest, ZeroOperation) {
     }
 }
 
+// ========================================
+// Views
+// ========================================
+
+TEST(TensorTest, ViewAliasesMemory) {
+    Tensor owner({2, 3});
+    Tensor row = Tensor::view(owner.data() + 3, {3});
+
+    EXPECT_TRUE(row.is_view());
+    EXPECT_FALSE(owner.is_view());
+    row.fill(5.0f);
+    EXPECT_FLOAT_EQ(owner(1, 0), 5.0f);
+    EXPECT_FLOAT_EQ(owner(0, 2), 0.0f);
+}
+
+TEST(TensorTest, ViewCopyIsOwning) {
+    Tensor owner({4});
+    Tensor view = Tensor::view(owner.data(), {4});
+    Tensor copy(view);
+
+    EXPECT_FALSE(copy.is_view());
+    EXPECT_NE(copy.data(), owner.data());
+}
+
+TEST(TensorTest, ViewKeepaliveReleasedWithLastView) {
+    auto buffer = std::make_shared<Tensor>(std::vector<size_t>{8});
+    std::weak_ptr<Tensor> weak = buffer;
+    {
+        Tensor view = Tensor::view(buffer->data(), {8}, buffer);
+        buffer.reset();
+        EXPECT_FALSE(weak.expired());
+
+        Tensor moved(std::move(view));
+        EXPECT_TRUE(moved.is_view());
+        EXPECT_FALSE(weak.expired());
+    }
+    EXPECT_TRUE(weak.expired());
+}
+
 // ========================================
 // Edge Cases
 // ========================================